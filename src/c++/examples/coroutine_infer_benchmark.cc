@@ -0,0 +1,324 @@
+// Copyright 2024, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compare the cost of the callback API and of the coroutine API of
+// infer_awaitable.h. The same number of requests is issued by each API,
+// with a fixed number of requests in flight. Each request in flight is a
+// chain of requests, the next request of a chain being sent when the
+// previous completes, from its callback or after its co_await. Each chain
+// has its own inputs since an InferInput can't be used by several requests
+// in flight at once.
+
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "grpc_client.h"
+#include "http_client.h"
+#include "infer_awaitable.h"
+
+namespace tc = triton::client;
+
+#define FAIL_IF_ERR(X, MSG)                                        \
+  {                                                                \
+    tc::Error err = (X);                                           \
+    if (!err.IsOk()) {                                             \
+      std::cerr << "error: " << (MSG) << ": " << err << std::endl; \
+      exit(1);                                                     \
+    }                                                              \
+  }
+
+namespace {
+
+// Blocks until it is counted down a given number of times.
+class Latch {
+ public:
+  explicit Latch(const size_t count) : count_(count) {}
+
+  void CountDown()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (--count_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return count_ == 0; });
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  size_t count_;
+};
+
+// A coroutine that starts running when it is called and is never awaited,
+// its completion is signaled through a Latch.
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+void
+CheckResult(tc::InferResult* result)
+{
+  FAIL_IF_ERR(result->RequestStatus(), "inference failed");
+  delete result;
+}
+
+template <typename Client>
+void
+CallbackChain(
+    Client* client, const tc::InferOptions& options,
+    const std::vector<tc::InferInput*>& inputs, const size_t request_count,
+    Latch* done)
+{
+  FAIL_IF_ERR(
+      client->AsyncInfer(
+          [client, &options, &inputs, request_count,
+           done](tc::InferResult* result) {
+            CheckResult(result);
+            if (request_count > 1) {
+              CallbackChain(client, options, inputs, request_count - 1, done);
+            } else {
+              done->CountDown();
+            }
+          },
+          options, inputs),
+      "unable to run model");
+}
+
+template <typename Client>
+DetachedTask
+CoroutineChain(
+    Client* client, const tc::InferOptions& options,
+    const std::vector<tc::InferInput*>& inputs, const size_t request_count,
+    Latch* done)
+{
+  for (size_t i = 0; i < request_count; ++i) {
+    tc::InferResult* result;
+    FAIL_IF_ERR(
+        co_await tc::InferAsync(client, &result, options, inputs),
+        "unable to run model");
+    delete result;
+  }
+  done->CountDown();
+}
+
+// Run 'concurrency' chains of 'chain_length' requests with 'start_chain'
+// and return the throughput in inferences per second.
+template <typename StartChainFn>
+double
+Measure(
+    const size_t concurrency, const size_t chain_length,
+    StartChainFn start_chain)
+{
+  Latch done(concurrency);
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < concurrency; ++i) {
+    start_chain(i, chain_length, &done);
+  }
+  done.Wait();
+  const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+  return (concurrency * chain_length) / duration.count();
+}
+
+// 'chain_inputs' holds the inputs of each chain, one chain per request in
+// flight.
+template <typename Client>
+void
+RunBenchmark(
+    Client* client, const tc::InferOptions& options,
+    const std::vector<std::vector<tc::InferInput*>>& chain_inputs,
+    const size_t request_count, const size_t rounds)
+{
+  auto callback_chain = [&](const size_t chain, const size_t chain_length,
+                            Latch* done) {
+    CallbackChain(client, options, chain_inputs[chain], chain_length, done);
+  };
+  auto coroutine_chain = [&](const size_t chain, const size_t chain_length,
+                             Latch* done) {
+    CoroutineChain(client, options, chain_inputs[chain], chain_length, done);
+  };
+
+  // Warm up the connections
+  const size_t concurrency = chain_inputs.size();
+  const size_t chain_length = std::max<size_t>(request_count / concurrency, 1);
+  Measure(concurrency, chain_length, callback_chain);
+
+  // The APIs are alternated so that both see the same server conditions
+  for (size_t round = 0; round < rounds; ++round) {
+    const double callback_throughput =
+        Measure(concurrency, chain_length, callback_chain);
+    const double coroutine_throughput =
+        Measure(concurrency, chain_length, coroutine_chain);
+    std::cout << "Round " << round << ": callback " << callback_throughput
+              << " infer/sec, coroutine " << coroutine_throughput
+              << " infer/sec" << std::endl;
+  }
+}
+
+void
+Usage(char** argv, const std::string& msg = std::string())
+{
+  if (!msg.empty()) {
+    std::cerr << "error: " << msg << std::endl;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " [options]" << std::endl;
+  std::cerr << "\t-v" << std::endl;
+  std::cerr << "\t-i <Protocol used to communicate with inference service>"
+            << std::endl;
+  std::cerr << "\t-u <URL for inference service>" << std::endl;
+  std::cerr << "\t-n <Number of requests of each measurement>" << std::endl;
+  std::cerr << "\t-c <Number of requests in flight>" << std::endl;
+  std::cerr << "\t-r <Number of measurements of each API>" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "For -i, available protocols are 'grpc' and 'http'. Default is "
+               "'http'."
+            << std::endl;
+
+  exit(1);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+  bool verbose = false;
+  std::string protocol("http");
+  std::string url;
+  size_t request_count = 10000;
+  size_t concurrency = 8;
+  size_t rounds = 3;
+
+  // Parse commandline...
+  int opt;
+  while ((opt = getopt(argc, argv, "vi:u:n:c:r:")) != -1) {
+    switch (opt) {
+      case 'v':
+        verbose = true;
+        break;
+      case 'i':
+        protocol = optarg;
+        break;
+      case 'u':
+        url = optarg;
+        break;
+      case 'n':
+        request_count = std::stoul(optarg);
+        break;
+      case 'c':
+        concurrency = std::stoul(optarg);
+        break;
+      case 'r':
+        rounds = std::stoul(optarg);
+        break;
+      case '?':
+        Usage(argv);
+        break;
+    }
+  }
+  if ((protocol != "http") && (protocol != "grpc")) {
+    Usage(argv, "unsupported protocol '" + protocol + "'");
+  }
+  if (concurrency == 0) {
+    Usage(argv, "the number of requests in flight must be at least 1");
+  }
+  if (url.empty()) {
+    url = (protocol == "http") ? "localhost:8000" : "localhost:8001";
+  }
+
+  // We use a simple model that takes 2 input tensors of 16 integers
+  // each and returns 2 output tensors of 16 integers each.
+  tc::InferOptions options("simple");
+
+  std::vector<int32_t> input0_data(16);
+  std::vector<int32_t> input1_data(16, 1);
+  for (size_t i = 0; i < 16; ++i) {
+    input0_data[i] = i;
+  }
+  std::vector<int64_t> shape{1, 16};
+
+  // The inputs of each chain refer to the same data, which is only read.
+  std::vector<std::unique_ptr<tc::InferInput>> input_ptrs;
+  std::vector<std::vector<tc::InferInput*>> chain_inputs(concurrency);
+  for (auto& inputs : chain_inputs) {
+    tc::InferInput* input0;
+    tc::InferInput* input1;
+    FAIL_IF_ERR(
+        tc::InferInput::Create(&input0, "INPUT0", shape, "INT32"),
+        "unable to get INPUT0");
+    input_ptrs.emplace_back(input0);
+    FAIL_IF_ERR(
+        tc::InferInput::Create(&input1, "INPUT1", shape, "INT32"),
+        "unable to get INPUT1");
+    input_ptrs.emplace_back(input1);
+    FAIL_IF_ERR(
+        input0->AppendRaw(
+            reinterpret_cast<uint8_t*>(&input0_data[0]),
+            input0_data.size() * sizeof(int32_t)),
+        "unable to set data for INPUT0");
+    FAIL_IF_ERR(
+        input1->AppendRaw(
+            reinterpret_cast<uint8_t*>(&input1_data[0]),
+            input1_data.size() * sizeof(int32_t)),
+        "unable to set data for INPUT1");
+    inputs = {input0, input1};
+  }
+
+  if (protocol == "http") {
+    std::unique_ptr<tc::InferenceServerHttpClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerHttpClient::Create(&client, url, verbose),
+        "unable to create http client");
+    RunBenchmark(client.get(), options, chain_inputs, request_count, rounds);
+  } else {
+    std::unique_ptr<tc::InferenceServerGrpcClient> client;
+    FAIL_IF_ERR(
+        tc::InferenceServerGrpcClient::Create(&client, url, verbose),
+        "unable to create grpc client");
+    RunBenchmark(client.get(), options, chain_inputs, request_count, rounds);
+  }
+
+  return 0;
+}
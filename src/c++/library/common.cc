@@ -26,8 +26,119 @@
 
 #include "common.h"
 
+#include <cmath>
+#include <deque>
+
 namespace triton { namespace client {
 
+namespace {
+
+// The number and the size of the samples for estimating the compressibility
+// of a request.
+constexpr size_t kCompressionSampleCount = 16;
+constexpr size_t kCompressionSampleByteSize = 256;
+// The weight of the latest observation in the throughput averages.
+constexpr double kThroughputWeight = 0.2;
+// log2 of LatencyHistogram::kSubBucketCount
+constexpr size_t kSubBucketBits = 5;
+
+// Return the index of the most significant set bit of 'value', which must
+// not be 0.
+size_t
+MostSignificantBit(uint64_t value)
+{
+  size_t msb = 0;
+  for (size_t bits = 32; bits > 0; bits /= 2) {
+    if ((value >> bits) != 0) {
+      value >>= bits;
+      msb += bits;
+    }
+  }
+  return msb;
+}
+
+// Return the duration of a phase of 'timer', or 0 if the phase wasn't
+// measured.
+uint64_t
+PhaseDuration(
+    const RequestTimers& timer, const RequestTimers::Kind start,
+    const RequestTimers::Kind end)
+{
+  const uint64_t duration_ns = timer.Duration(start, end);
+  return (duration_ns == std::numeric_limits<uint64_t>::max()) ? 0
+                                                               : duration_ns;
+}
+
+// A CallbackExecutor running the tasks on a pool of threads.
+class CallbackThreadPool : public CallbackExecutor {
+ public:
+  explicit CallbackThreadPool(const size_t thread_count);
+  ~CallbackThreadPool();
+
+  void Execute(std::function<void()> task) override;
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool exiting_;
+  std::vector<std::thread> workers_;
+};
+
+CallbackThreadPool::CallbackThreadPool(const size_t thread_count)
+    : exiting_(false)
+{
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_.emplace_back(&CallbackThreadPool::Work, this);
+  }
+}
+
+CallbackThreadPool::~CallbackThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void
+CallbackThreadPool::Execute(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void
+CallbackThreadPool::Work()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk, [this] { return exiting_ || !tasks_.empty(); });
+      // The queued tasks are drained before exiting, as each holds a result
+      // that only its callback releases.
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace
+
 //==============================================================================
 
 const Error Error::Success("");
@@ -45,10 +156,49 @@ operator<<(std::ostream& out, const Error& err)
 
 //==============================================================================
 
+Error
+CallbackExecutor::CreateThreadPool(
+    std::shared_ptr<CallbackExecutor>* executor, const size_t thread_count)
+{
+  if (thread_count == 0) {
+    return Error("The callback thread pool must have at least 1 thread");
+  }
+  executor->reset(new CallbackThreadPool(thread_count));
+  return Error::Success;
+}
+
+//==============================================================================
+
+InferenceServerClient::~InferenceServerClient()
+{
+  WaitForCallbacks();
+}
+
 Error
 InferenceServerClient::ClientInferStat(InferStat* infer_stat) const
 {
-  *infer_stat = infer_stat_;
+  {
+    std::lock_guard<std::mutex> lk(stat_mutex_);
+    *infer_stat = infer_stat_;
+    infer_stat->callback_queue_depth = queued_callback_count_;
+  }
+  total_request_time_histogram_.Snapshot(
+      &infer_stat->total_request_time_histogram);
+  send_time_histogram_.Snapshot(&infer_stat->send_time_histogram);
+  receive_time_histogram_.Snapshot(&infer_stat->receive_time_histogram);
+  return Error::Success;
+}
+
+Error
+InferenceServerClient::ResetClientInferStat()
+{
+  {
+    std::lock_guard<std::mutex> lk(stat_mutex_);
+    infer_stat_ = InferStat();
+  }
+  total_request_time_histogram_.Reset();
+  send_time_histogram_.Reset();
+  receive_time_histogram_.Reset();
   return Error::Success;
 }
 
@@ -97,14 +247,157 @@ InferenceServerClient::UpdateInferStat(const RequestTimers& timer)
              : ""));
   }
 
+  // The phases of the client overhead are optional, not every request
+  // goes through all of them.
+  const uint64_t serialize_time_ns = PhaseDuration(
+      timer, RequestTimers::Kind::SERIALIZE_START,
+      RequestTimers::Kind::SERIALIZE_END);
+  const uint64_t enqueue_time_ns = PhaseDuration(
+      timer, RequestTimers::Kind::ENQUEUE_START,
+      RequestTimers::Kind::ENQUEUE_END);
+  const uint64_t deserialize_time_ns = PhaseDuration(
+      timer, RequestTimers::Kind::DESERIALIZE_START,
+      RequestTimers::Kind::DESERIALIZE_END);
+
+  total_request_time_histogram_.Record(request_time_ns);
+  send_time_histogram_.Record(send_time_ns);
+  receive_time_histogram_.Record(recv_time_ns);
+
+  std::lock_guard<std::mutex> lk(stat_mutex_);
   infer_stat_.completed_request_count++;
   infer_stat_.cumulative_total_request_time_ns += request_time_ns;
   infer_stat_.cumulative_send_time_ns += send_time_ns;
   infer_stat_.cumulative_receive_time_ns += recv_time_ns;
+  infer_stat_.cumulative_serialize_time_ns += serialize_time_ns;
+  infer_stat_.cumulative_enqueue_time_ns += enqueue_time_ns;
+  infer_stat_.cumulative_deserialize_time_ns += deserialize_time_ns;
 
   return Error::Success;
 }
 
+void
+InferenceServerClient::UpdateCallbackStat(const RequestTimers& timer)
+{
+  const uint64_t callback_time_ns = PhaseDuration(
+      timer, RequestTimers::Kind::CALLBACK_START,
+      RequestTimers::Kind::CALLBACK_END);
+
+  std::lock_guard<std::mutex> lk(stat_mutex_);
+  infer_stat_.cumulative_callback_time_ns += callback_time_ns;
+}
+
+void
+InferenceServerClient::RunCallback(OnCompleteFn callback, InferResult* result)
+{
+  if (callback_executor_ == nullptr) {
+    InvokeCallback(callback, result);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(stat_mutex_);
+    queued_callback_count_++;
+    pending_callback_count_++;
+    infer_stat_.max_callback_queue_depth =
+        std::max(infer_stat_.max_callback_queue_depth, queued_callback_count_);
+  }
+  callback_executor_->Execute(std::bind(
+      [this](const OnCompleteFn& callback, InferResult* result) {
+        {
+          std::lock_guard<std::mutex> lk(stat_mutex_);
+          queued_callback_count_--;
+        }
+        InvokeCallback(callback, result);
+        std::lock_guard<std::mutex> lk(stat_mutex_);
+        if (--pending_callback_count_ == 0) {
+          callback_cv_.notify_all();
+        }
+      },
+      std::move(callback), result));
+}
+
+void
+InferenceServerClient::InvokeCallback(
+    const OnCompleteFn& callback, InferResult* result)
+{
+  RequestTimers timer;
+  timer.CaptureTimestamp(RequestTimers::Kind::CALLBACK_START);
+  callback(result);
+  timer.CaptureTimestamp(RequestTimers::Kind::CALLBACK_END);
+  UpdateCallbackStat(timer);
+}
+
+void
+InferenceServerClient::WaitForCallbacks()
+{
+  std::unique_lock<std::mutex> lk(stat_mutex_);
+  callback_cv_.wait(lk, [this] { return pending_callback_count_ == 0; });
+}
+
+void
+InferenceServerClient::UpdateRequestPoolStat(const bool reused)
+{
+  std::lock_guard<std::mutex> lk(stat_mutex_);
+  if (reused) {
+    infer_stat_.request_pool_reuse_count++;
+  } else {
+    infer_stat_.request_pool_miss_count++;
+  }
+}
+
+void
+InferenceServerClient::UpdateAutoCompressionStat(
+    const bool compressed, const uint64_t time_ns,
+    const size_t input_byte_size, const size_t output_byte_size)
+{
+  std::lock_guard<std::mutex> lk(stat_mutex_);
+  infer_stat_.cumulative_auto_compression_time_ns += time_ns;
+  if (compressed) {
+    infer_stat_.auto_compressed_request_count++;
+    infer_stat_.auto_compression_input_byte_size += input_byte_size;
+    infer_stat_.auto_compression_output_byte_size += output_byte_size;
+  } else {
+    infer_stat_.auto_uncompressed_request_count++;
+  }
+}
+
+Error
+InferenceServerClient::WaitInferMulti(
+    const std::function<Error(OnMultiCompleteFn)>& async_infer_multi,
+    std::vector<InferResult*>* results)
+{
+  std::mutex mu;
+  std::condition_variable cv;
+  bool completed = false;
+  std::vector<InferResult*> multi_results;
+  Error err =
+      async_infer_multi([&](std::vector<InferResult*> async_results) {
+        // Notify while holding the lock, the waiting thread may destroy 'cv'
+        // as soon as it observes the completion.
+        std::lock_guard<std::mutex> lk(mu);
+        multi_results.swap(async_results);
+        completed = true;
+        cv.notify_one();
+      });
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&completed] { return completed; });
+  }
+
+  Error request_err = Error::Success;
+  for (auto result : multi_results) {
+    results->emplace_back(result);
+    if (request_err.IsOk()) {
+      request_err = result->RequestStatus();
+    }
+  }
+  return request_err;
+}
+
 //==============================================================================
 
 Error
@@ -301,9 +594,52 @@ InferRequestedOutput::UnsetSharedMemory()
   return Error::Success;
 }
 
+Error
+InferRequestedOutput::SetBuffer(uint8_t* buf, const size_t byte_size)
+{
+  if (buf == nullptr) {
+    return Error("The buffer must not be null.");
+  }
+
+  shm_name_ = "";
+  shm_byte_size_ = 0;
+  shm_offset_ = 0;
+  buf_ = buf;
+  buf_byte_size_ = byte_size;
+  io_type_ = RAW;
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::UnsetBuffer()
+{
+  if (io_type_ == RAW) {
+    io_type_ = NONE;
+  }
+  buf_ = nullptr;
+  buf_byte_size_ = 0;
+
+  return Error::Success;
+}
+
+Error
+InferRequestedOutput::BufferInfo(uint8_t** buf, size_t* byte_size) const
+{
+  if (io_type_ != RAW) {
+    return Error("The output has not been set with a buffer.");
+  }
+
+  *buf = buf_;
+  *byte_size = buf_byte_size_;
+
+  return Error::Success;
+}
+
 InferRequestedOutput::InferRequestedOutput(
     const std::string& name, const size_t class_count)
-    : name_(name), class_count_(class_count), io_type_(NONE)
+    : name_(name), class_count_(class_count), io_type_(NONE), buf_(nullptr),
+      buf_byte_size_(0)
 {
 }
 
@@ -324,4 +660,273 @@ InferRequestedOutput::SharedMemoryInfo(
 
 //==============================================================================
 
+PreparedInferRequest::PreparedInferRequest(
+    const InferenceServerClient* client, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+    : client_(client), options_(options), inputs_(inputs), outputs_(outputs)
+{
+}
+
+Error
+PreparedInferRequest::SetRequestId(const std::string& request_id)
+{
+  options_.request_id_ = request_id;
+  return Error::Success;
+}
+
+Error
+PreparedInferRequest::SetSequenceId(const uint64_t sequence_id)
+{
+  options_.sequence_id_ = sequence_id;
+  options_.sequence_id_str_.clear();
+  return Error::Success;
+}
+
+Error
+PreparedInferRequest::SetSequenceId(const std::string& sequence_id)
+{
+  options_.sequence_id_ = 0;
+  options_.sequence_id_str_ = sequence_id;
+  return Error::Success;
+}
+
+Error
+PreparedInferRequest::SetSequenceFlags(
+    const bool sequence_start, const bool sequence_end)
+{
+  options_.sequence_start_ = sequence_start;
+  options_.sequence_end_ = sequence_end;
+  return Error::Success;
+}
+
+//==============================================================================
+
+constexpr size_t LatencyHistogram::kSubBucketCount;
+constexpr size_t LatencyHistogram::kBucketCount;
+
+void
+LatencyHistogram::Record(const uint64_t latency_ns)
+{
+  if (counts_.empty()) {
+    counts_.resize(kBucketCount, 0);
+  }
+  counts_[BucketIndex(latency_ns)]++;
+  count_++;
+}
+
+void
+LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+  if (other.count_ == 0) {
+    return;
+  }
+  if (counts_.empty()) {
+    counts_.resize(kBucketCount, 0);
+  }
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+}
+
+void
+LatencyHistogram::Reset()
+{
+  counts_.clear();
+  count_ = 0;
+}
+
+uint64_t
+LatencyHistogram::Percentile(const double percentile) const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+  // The rank of the latency at the percentile, starting from 1
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100 * count_));
+  rank = (std::max)(uint64_t(1), (std::min)(rank, count_));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return BucketUpperBound(i);
+    }
+  }
+  return BucketUpperBound(kBucketCount - 1);
+}
+
+size_t
+LatencyHistogram::BucketIndex(const uint64_t latency_ns)
+{
+  // The latencies below kSubBucketCount have a bucket each, above that the
+  // bucket width doubles with every power of two.
+  if (latency_ns < kSubBucketCount) {
+    return latency_ns;
+  }
+  const size_t shift = MostSignificantBit(latency_ns) - kSubBucketBits;
+  return kSubBucketCount * (shift + 1) +
+         ((latency_ns >> shift) - kSubBucketCount);
+}
+
+uint64_t
+LatencyHistogram::BucketLowerBound(const size_t idx)
+{
+  if (idx < kSubBucketCount) {
+    return idx;
+  }
+  const size_t shift = (idx / kSubBucketCount) - 1;
+  return (kSubBucketCount + (idx % kSubBucketCount)) << shift;
+}
+
+uint64_t
+LatencyHistogram::BucketUpperBound(const size_t idx)
+{
+  return ((idx + 1) < kBucketCount)
+             ? (BucketLowerBound(idx + 1) - 1)
+             : (std::numeric_limits<uint64_t>::max)();
+}
+
+//==============================================================================
+
+void
+AtomicLatencyHistogram::Snapshot(LatencyHistogram* histogram) const
+{
+  histogram->counts_.resize(LatencyHistogram::kBucketCount);
+  histogram->count_ = 0;
+  for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+    histogram->counts_[i] = counts_[i].load(std::memory_order_relaxed);
+    histogram->count_ += histogram->counts_[i];
+  }
+  if (histogram->count_ == 0) {
+    histogram->counts_.clear();
+  }
+}
+
+void
+AtomicLatencyHistogram::Reset()
+{
+  for (auto& count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+//==============================================================================
+
+CompressionAdvisor::CompressionAdvisor(
+    const size_t min_byte_size, const double max_ratio)
+    : min_byte_size_(min_byte_size), max_ratio_(max_ratio),
+      compression_throughput_(0), transfer_throughput_(0)
+{
+}
+
+bool
+CompressionAdvisor::ShouldCompress(
+    const Buffers& buffers, const size_t byte_size)
+{
+  if (byte_size < min_byte_size_) {
+    return false;
+  }
+  const double ratio = EstimateCompressionRatio(buffers, byte_size);
+  if (ratio > max_ratio_) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if ((compression_throughput_ == 0) || (transfer_throughput_ == 0)) {
+    return true;
+  }
+  // Per byte, compressing costs 1 / compression_throughput_ and saves
+  // (1 - ratio) / transfer_throughput_ of the transfer.
+  return (compression_throughput_ * (1 - ratio)) > transfer_throughput_;
+}
+
+void
+CompressionAdvisor::RecordCompression(
+    const size_t byte_size, const uint64_t duration_ns)
+{
+  UpdateThroughput(byte_size, duration_ns, &compression_throughput_);
+}
+
+void
+CompressionAdvisor::RecordTransfer(
+    const size_t byte_size, const uint64_t duration_ns)
+{
+  // The transfer of small requests is dominated by the latency
+  if (byte_size >= min_byte_size_) {
+    UpdateThroughput(byte_size, duration_ns, &transfer_throughput_);
+  }
+}
+
+void
+CompressionAdvisor::UpdateThroughput(
+    const size_t byte_size, const uint64_t duration_ns, double* throughput)
+{
+  if ((duration_ns == 0) ||
+      (duration_ns == (std::numeric_limits<uint64_t>::max)())) {
+    return;
+  }
+  const double observed = static_cast<double>(byte_size) / duration_ns;
+  std::lock_guard<std::mutex> lk(mutex_);
+  *throughput = (*throughput == 0) ? observed
+                                   : ((1 - kThroughputWeight) * *throughput +
+                                      kThroughputWeight * observed);
+}
+
+double
+CompressionAdvisor::EstimateCompressionRatio(
+    const Buffers& buffers, const size_t byte_size)
+{
+  // Sample the whole request if it is small, otherwise take evenly spaced
+  // samples from the start to the end of the request.
+  std::vector<std::pair<size_t, size_t>> samples;
+  if (byte_size <= (kCompressionSampleCount * kCompressionSampleByteSize)) {
+    samples.emplace_back(0, byte_size);
+  } else {
+    const size_t last_sample_offset = byte_size - kCompressionSampleByteSize;
+    for (size_t i = 0; i < kCompressionSampleCount; ++i) {
+      const size_t offset =
+          last_sample_offset * i / (kCompressionSampleCount - 1);
+      samples.emplace_back(offset, offset + kCompressionSampleByteSize);
+    }
+  }
+
+  std::array<size_t, 256> counts{};
+  size_t sampled_byte_size = 0;
+  size_t idx = 0;
+  size_t buffer_offset = 0;
+  for (const auto& sample : samples) {
+    size_t pos = sample.first;
+    while ((pos < sample.second) && (idx < buffers.size())) {
+      const size_t buffer_end = buffer_offset + buffers[idx].second;
+      if (pos >= buffer_end) {
+        buffer_offset = buffer_end;
+        ++idx;
+        continue;
+      }
+      const size_t span_end = (std::min)(sample.second, buffer_end);
+      sampled_byte_size += span_end - pos;
+      for (; pos < span_end; ++pos) {
+        counts[buffers[idx].first[pos - buffer_offset]]++;
+      }
+    }
+  }
+  if (sampled_byte_size == 0) {
+    return 1.0;
+  }
+
+  // The order-0 entropy in bits per byte bounds the size achievable by
+  // entropy coding, so it is the estimated ratio after dividing by 8.
+  double entropy = 0;
+  for (const auto count : counts) {
+    if (count != 0) {
+      const double p = static_cast<double>(count) / sampled_byte_size;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy / 8;
+}
+
+//==============================================================================
+
 }}  // namespace triton::client
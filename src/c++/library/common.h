@@ -28,6 +28,8 @@
 /// \file
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
@@ -83,6 +85,96 @@ class Error {
   std::string msg_;
 };
 
+//==============================================================================
+/// A histogram of latencies in nanoseconds. Like in an HDR histogram the
+/// buckets are log-linear, each power of two range is split into
+/// kSubBucketCount buckets of equal width. So a latency is known within
+/// 1/kSubBucketCount (about 3%) of its value over the full range of
+/// uint64_t, with a fixed number of buckets. Histograms can be merged, for
+/// example to combine the statistics of several clients.
+///
+class LatencyHistogram {
+ public:
+  /// The number of buckets that each power of two range is split into.
+  static constexpr size_t kSubBucketCount = 32;
+  /// The total number of buckets.
+  static constexpr size_t kBucketCount = kSubBucketCount * 60;
+
+  /// Create an empty histogram.
+  LatencyHistogram() : count_(0) {}
+
+  /// Add a latency to the histogram.
+  /// \param latency_ns The latency in nanoseconds.
+  void Record(const uint64_t latency_ns);
+
+  /// Add the latencies of another histogram to the histogram.
+  /// \param other The histogram to merge.
+  void Merge(const LatencyHistogram& other);
+
+  /// Remove all the latencies from the histogram.
+  void Reset();
+
+  /// \return The number of latencies in the histogram.
+  uint64_t Count() const { return count_; }
+
+  /// \param idx The index of the bucket.
+  /// \return The number of latencies in the bucket.
+  uint64_t BucketCount(const size_t idx) const
+  {
+    return counts_.empty() ? 0 : counts_[idx];
+  }
+
+  /// Get the latency at a percentile, which is reported as the highest
+  /// latency of the bucket holding it.
+  /// \param percentile The percentile, between 0 and 100.
+  /// \return The latency in nanoseconds, 0 if the histogram is empty.
+  uint64_t Percentile(const double percentile) const;
+
+  /// \param latency_ns The latency in nanoseconds.
+  /// \return The index of the bucket holding the latency.
+  static size_t BucketIndex(const uint64_t latency_ns);
+
+  /// \param idx The index of the bucket.
+  /// \return The lowest latency, in nanoseconds, held by the bucket.
+  static uint64_t BucketLowerBound(const size_t idx);
+
+  /// \param idx The index of the bucket.
+  /// \return The highest latency, in nanoseconds, held by the bucket.
+  static uint64_t BucketUpperBound(const size_t idx);
+
+ private:
+  friend class AtomicLatencyHistogram;
+
+  // The number of latencies of each bucket, empty until the first latency
+  // is added so that empty histograms are cheap to copy.
+  std::vector<uint64_t> counts_;
+  uint64_t count_;
+};
+
+//==============================================================================
+// A LatencyHistogram that any number of threads can add latencies to at
+// once without locking.
+//
+class AtomicLatencyHistogram {
+ public:
+  AtomicLatencyHistogram() { Reset(); }
+
+  void Record(const uint64_t latency_ns)
+  {
+    counts_[LatencyHistogram::BucketIndex(latency_ns)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+
+  // Copy the current latencies into 'histogram'. The latencies added while
+  // the copy is taken may or may not be included.
+  void Snapshot(LatencyHistogram* histogram) const;
+
+  void Reset();
+
+ private:
+  std::array<std::atomic<uint64_t>, LatencyHistogram::kBucketCount> counts_;
+};
+
 //==============================================================================
 /// Cumulative inference statistics.
 ///
@@ -91,6 +183,12 @@ class Error {
 ///   time for marshaling infer request.
 ///   'cumulative_receive_time_ns' represents the time for
 ///   unmarshaling infer response.
+///
+/// The phases of the client overhead, 'cumulative_serialize_time_ns' to
+/// 'cumulative_callback_time_ns', only sum the requests the phase was
+/// measured for, and are usually averaged over
+/// 'completed_request_count'. The callback time of an asynchronous
+/// request is added once its callback returns.
 struct InferStat {
   /// Total number of requests completed.
   size_t completed_request_count;
@@ -106,14 +204,117 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// Time spent serializing the requests.
+  uint64_t cumulative_serialize_time_ns;
+
+  /// Time the serialized requests were queued in the transport before
+  /// being written. Not measured for streaming requests.
+  uint64_t cumulative_enqueue_time_ns;
+
+  /// Time spent constructing the results from the responses.
+  uint64_t cumulative_deserialize_time_ns;
+
+  /// Time spent in the completion callbacks of asynchronous requests.
+  uint64_t cumulative_callback_time_ns;
+
+  /// Number of requests that reused an idle connection handle from the
+  /// client's handle pool. Only reported by the HTTP client.
+  size_t handle_pool_reuse_count;
+
+  /// Number of requests that found the client's handle pool empty and
+  /// had to create a new connection handle. Only reported by the HTTP
+  /// client.
+  size_t handle_pool_exhausted_count;
+
+  /// Number of requests that reused the state of a completed request
+  /// from the client's request pool. The HTTP client only pools the
+  /// state of asynchronous requests.
+  size_t request_pool_reuse_count;
+
+  /// Number of requests that found no reusable state in the client's
+  /// request pool and had to create it. This happens until the pool holds
+  /// enough state for the number of requests in flight, and for the
+  /// requests in flight beyond the size limit of the pool.
+  size_t request_pool_miss_count;
+
+  /// Number of requests with automatic compression that the client
+  /// decided to send compressed.
+  size_t auto_compressed_request_count;
+
+  /// Number of requests with automatic compression that the client
+  /// decided to send uncompressed.
+  size_t auto_uncompressed_request_count;
+
+  /// Time spent by the requests with automatic compression on estimating
+  /// the compressibility of the request and on compressing it. The gRPC
+  /// client compresses in the gRPC library, so only the estimation is
+  /// included.
+  uint64_t cumulative_auto_compression_time_ns;
+
+  /// Total size of the requests that automatic compression decided to
+  /// compress, before and after the compression. Only reported by the
+  /// HTTP client.
+  uint64_t auto_compression_input_byte_size;
+  uint64_t auto_compression_output_byte_size;
+
+  /// Number of completion callbacks handed to the callback executor of the
+  /// client that haven't started yet, and the largest such number seen. A
+  /// growing queue shows that the callbacks don't keep up with the
+  /// completions. Always 0 when the client has no callback executor.
+  size_t callback_queue_depth;
+  size_t max_callback_queue_depth;
+
+  /// The distributions of the times that are summed in
+  /// 'cumulative_total_request_time_ns', 'cumulative_send_time_ns' and
+  /// 'cumulative_receive_time_ns', for reporting percentiles.
+  LatencyHistogram total_request_time_histogram;
+  LatencyHistogram send_time_histogram;
+  LatencyHistogram receive_time_histogram;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cumulative_serialize_time_ns(0), cumulative_enqueue_time_ns(0),
+        cumulative_deserialize_time_ns(0), cumulative_callback_time_ns(0),
+        handle_pool_reuse_count(0), handle_pool_exhausted_count(0),
+        request_pool_reuse_count(0), request_pool_miss_count(0),
+        auto_compressed_request_count(0), auto_uncompressed_request_count(0),
+        cumulative_auto_compression_time_ns(0),
+        auto_compression_input_byte_size(0),
+        auto_compression_output_byte_size(0), callback_queue_depth(0),
+        max_callback_queue_depth(0)
   {
   }
 };
 
+//==============================================================================
+/// An executor for the completion callbacks of asynchronous requests. By
+/// default a callback runs on the thread that completes the request, so a
+/// slow callback delays the completion of the other requests. A client
+/// given an executor hands the callbacks to it instead. A custom executor
+/// can be implemented to run the callbacks on the application's threads.
+///
+class CallbackExecutor {
+ public:
+  virtual ~CallbackExecutor() = default;
+
+  /// Run a task, typically on another thread. Called by the threads
+  /// completing the requests, so it should return without waiting for
+  /// the task to run.
+  /// \param task The task to run.
+  virtual void Execute(std::function<void()> task) = 0;
+
+  /// Create an executor running the tasks in submission order on a pool
+  /// of threads. The tasks still queued when the executor is destroyed
+  /// are run before the threads exit.
+  /// \param executor Returns the executor.
+  /// \param thread_count The number of threads, must be at least 1.
+  /// \return Error object indicating success or failure.
+  static Error CreateThreadPool(
+      std::shared_ptr<CallbackExecutor>* executor, const size_t thread_count);
+};
+
 //==============================================================================
 /// The base class for InferenceServerClients
 ///
@@ -123,20 +324,55 @@ class InferenceServerClient {
   using OnMultiCompleteFn = std::function<void(std::vector<InferResult*>)>;
 
   explicit InferenceServerClient(bool verbose)
-      : verbose_(verbose), exiting_(false)
+      : verbose_(verbose), exiting_(false), queued_callback_count_(0),
+        pending_callback_count_(0)
   {
   }
 
-  virtual ~InferenceServerClient() = default;
+  virtual ~InferenceServerClient();
 
   /// Obtain the cumulative inference statistics of the client.
   /// \param Returns the InferStat object holding current statistics.
   /// \return Error object indicating success or failure.
   Error ClientInferStat(InferStat* infer_stat) const;
 
+  /// Reset the inference statistics of the client, including the latency
+  /// histograms, to zero. The statistics of a request completing at the
+  /// same time may be partially reset.
+  /// \return Error object indicating success or failure.
+  Error ResetClientInferStat();
+
  protected:
   // Update the infer stat with the given timer
   Error UpdateInferStat(const RequestTimers& timer);
+  // Update the infer stat with the callback phase of the given timer, which
+  // completes after the request stat is updated by UpdateInferStat().
+  void UpdateCallbackStat(const RequestTimers& timer);
+  // Run the completion callback of an asynchronous request with its result,
+  // on 'callback_executor_' if set and otherwise on the calling thread, and
+  // record the time spent in the callback.
+  void RunCallback(OnCompleteFn callback, InferResult* result);
+  // Block until the callbacks handed to 'callback_executor_' have returned.
+  // Must be called by the destructor of the derived clients once no request
+  // can complete anymore, as the callbacks may use the client.
+  void WaitForCallbacks();
+  // Update the request pool counters of the infer stat, 'reused' is
+  // whether the request reused pooled state.
+  void UpdateRequestPoolStat(const bool reused);
+  // Update the automatic compression counters of the infer stat with the
+  // decision for a request and what it cost. The byte sizes are only
+  // recorded if the request is compressed.
+  void UpdateAutoCompressionStat(
+      const bool compressed, const uint64_t time_ns,
+      const size_t input_byte_size, const size_t output_byte_size);
+  // Issue the requests of a synchronous multi-inference at once by calling
+  // 'async_infer_multi' with the completion callback, and block until all
+  // the results are back. The results are appended to 'results' in request
+  // order. Returns the error of issuing the requests, or else the status of
+  // the first failed request.
+  Error WaitInferMulti(
+      const std::function<Error(OnMultiCompleteFn)>& async_infer_multi,
+      std::vector<InferResult*>* results);
   // Enables verbose operation in the client.
   bool verbose_;
 
@@ -151,6 +387,29 @@ class InferenceServerClient {
 
   // The inference statistic of the current client
   InferStat infer_stat_;
+  // Guards 'infer_stat_' which is updated by any thread submitting or
+  // completing requests.
+  mutable std::mutex stat_mutex_;
+  // The latency histograms of the infer stat, updated without holding
+  // 'stat_mutex_'.
+  AtomicLatencyHistogram total_request_time_histogram_;
+  AtomicLatencyHistogram send_time_histogram_;
+  AtomicLatencyHistogram receive_time_histogram_;
+
+  // The executor running the completion callbacks of the asynchronous
+  // requests, null to run them on the threads completing the requests.
+  std::shared_ptr<CallbackExecutor> callback_executor_;
+
+ private:
+  // Run 'callback' on the calling thread and record its duration.
+  void InvokeCallback(const OnCompleteFn& callback, InferResult* result);
+
+  // The number of callbacks handed to 'callback_executor_' that haven't
+  // started and that haven't returned yet. Guarded by 'stat_mutex_'.
+  size_t queued_callback_count_;
+  size_t pending_callback_count_;
+  // Signaled when 'pending_callback_count_' drops to 0.
+  std::condition_variable callback_cv_;
 };
 
 //==============================================================================
@@ -161,7 +420,7 @@ struct InferOptions {
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
         sequence_end_(false), priority_(0), server_timeout_(0),
-        client_timeout_(0)
+        client_timeout_(0), enable_empty_final_response_(false)
   {
   }
   /// The name of the model to run inference.
@@ -219,6 +478,12 @@ struct InferOptions {
   // timeout < 1000 microseconds will be rounded down to 0 milliseconds and have
   // no effect.
   uint64_t client_timeout_;
+  /// Whether the server sends an empty response, flagged as final, when a
+  /// decoupled model completes the request without sending a final
+  /// response. Only supported for gRPC streaming requests, where the final
+  /// flag marks the end of the responses of the request, see
+  /// ResponseTimeline. Default value is false.
+  bool enable_empty_final_response_;
 };
 
 //==============================================================================
@@ -425,6 +690,35 @@ class InferRequestedOutput {
   Error SharedMemoryInfo(
       std::string* name, size_t* byte_size, size_t* offset) const;
 
+  /// Set the output tensor data to be written into the specified buffer
+  /// when the response is received, instead of into memory owned by the
+  /// InferResult. InferResult::RawData() then returns a pointer into
+  /// 'buf'. The buffer must stay valid until the result is released and
+  /// must not be shared by requests that are in flight at the same time.
+  /// The request fails if the output is larger than 'byte_size'. Setting
+  /// a buffer clears the shared memory option and vice versa.
+  /// \param buf The buffer to write the output tensor data into.
+  /// \param byte_size The size of the buffer in bytes.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error SetBuffer(uint8_t* buf, const size_t byte_size);
+
+  /// Clears the buffer set by the last call to
+  /// InferRequestedOutput::SetBuffer().
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error UnsetBuffer();
+
+  /// \return true if this output is being written into a buffer set with
+  /// InferRequestedOutput::SetBuffer().
+  bool HasBuffer() const { return (io_type_ == RAW); }
+
+  /// Get information about the buffer being used for this output.
+  /// \param buf Returns the buffer.
+  /// \param byte_size Returns the size of the buffer in bytes.
+  /// \return Error object indicating success or failure.
+  Error BufferInfo(uint8_t** buf, size_t* byte_size) const;
+
  private:
 #ifdef TRITON_INFERENCE_SERVER_CLIENT_CLASS
   friend class TRITON_INFERENCE_SERVER_CLIENT_CLASS;
@@ -436,12 +730,74 @@ class InferRequestedOutput {
   std::string name_;
   size_t class_count_;
 
-  // Used only if working with Shared Memory
+  // Used only if working with Shared Memory or a caller provided buffer
   enum IOType { NONE, RAW, SHARED_MEMORY };
   IOType io_type_;
   std::string shm_name_;
   size_t shm_byte_size_;
   size_t shm_offset_;
+  uint8_t* buf_;
+  size_t buf_byte_size_;
+};
+
+//==============================================================================
+/// A PreparedInferRequest holds an inference request for a fixed model,
+/// set of inputs and set of requested outputs, processed once by the
+/// client that created it so that the request can be issued repeatedly
+/// without preparing the whole request each time. Between requests only
+/// the request id, the sequence settings, and the shape and data of the
+/// inputs may change. Any other change, for example to the input names,
+/// datatypes, shared memory regions or to the requested outputs,
+/// requires a new prepared request. The inputs and outputs are referenced,
+/// not copied, so they must outlive the prepared request. A prepared
+/// request can only be used with the client that created it, and must not
+/// be issued from multiple threads at the same time.
+///
+class PreparedInferRequest {
+ public:
+  virtual ~PreparedInferRequest() = default;
+
+  /// Set the identifier of the requests issued after this call.
+  /// \param request_id The request identifier. An empty string means no
+  /// request_id will be used.
+  /// \return Error object indicating success or failure.
+  Error SetRequestId(const std::string& request_id);
+
+  /// Set the sequence of the requests issued after this call.
+  /// \param sequence_id The unique identifier for the sequence. 0 means
+  /// that the requests do not belong to a sequence.
+  /// \return Error object indicating success or failure.
+  Error SetSequenceId(const uint64_t sequence_id);
+
+  /// Set the sequence of the requests issued after this call.
+  /// \param sequence_id The unique identifier for the sequence. An empty
+  /// string means that the requests do not belong to a sequence.
+  /// \return Error object indicating success or failure.
+  Error SetSequenceId(const std::string& sequence_id);
+
+  /// Set the sequence flags of the requests issued after this call. The
+  /// flags are ignored if the requests do not belong to a sequence.
+  /// \param sequence_start Whether the request marks the start of the
+  /// sequence.
+  /// \param sequence_end Whether the request marks the end of the
+  /// sequence.
+  /// \return Error object indicating success or failure.
+  Error SetSequenceFlags(const bool sequence_start, const bool sequence_end);
+
+  /// \return The options used for the requests.
+  const InferOptions& Options() const { return options_; }
+
+ protected:
+  PreparedInferRequest(
+      const InferenceServerClient* client, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs);
+
+  // The client that prepared the request
+  const InferenceServerClient* client_;
+  InferOptions options_;
+  const std::vector<InferInput*> inputs_;
+  const std::vector<const InferRequestedOutput*> outputs_;
 };
 
 //==============================================================================
@@ -515,6 +871,48 @@ class InferResult {
   /// \return Error object indicating the success or failure of the
   /// request.
   virtual Error RequestStatus() const = 0;
+
+  /// Get whether this is the final response of its request. A decoupled
+  /// model may send any number of responses for a request, the last of
+  /// which is flagged as final. The responses of a non-decoupled model are
+  /// always final, which is what results that don't track it report.
+  /// \param is_final_response Returns true if this is the final response.
+  /// \return Error object indicating success or failure.
+  virtual Error IsFinalResponse(bool* is_final_response) const
+  {
+    *is_final_response = true;
+    return Error::Success;
+  }
+
+  /// Get whether this is an empty response that only flags the completion
+  /// of its request, see InferOptions::enable_empty_final_response_. Results
+  /// that don't track it report a non-empty response.
+  /// \param is_null_response Returns true if the response is empty.
+  /// \return Error object indicating success or failure.
+  virtual Error IsNullResponse(bool* is_null_response) const
+  {
+    *is_null_response = false;
+    return Error::Success;
+  }
+};
+
+//==============================================================================
+/// A CancelHandle is returned by the AsyncInfer() variant of the clients
+/// that accepts one, to cancel the asynchronous inference request while it
+/// is in progress. The handle can be used from any thread and may outlive
+/// the request and the client, it then has no effect.
+///
+class CancelHandle {
+ public:
+  virtual ~CancelHandle() = default;
+
+  /// Cancel the request if it is still in progress. The transfer of the
+  /// request is abandoned and the callback of the request is invoked with
+  /// a "Cancelled" status once the client has released the resources of
+  /// the request, on the thread that would have completed it. The call
+  /// has no effect if the request is already completed.
+  /// \return Error object indicating success or failure.
+  virtual Error Cancel() = 0;
 };
 
 //==============================================================================
@@ -546,18 +944,38 @@ class RequestTimers {
     /// byte).
     RECV_END,
 
+    /// The start and end of serializing the request, i.e. building the
+    /// HTTP request body or marshalling the gRPC request message.
+    SERIALIZE_START,
+    SERIALIZE_END,
+
+    /// The start and end of the queueing of the serialized request in
+    /// the transport. The HTTP client ends it when libcurl asks for the
+    /// first byte of the request body, the gRPC client when the call has
+    /// been handed to gRPC as gRPC doesn't report when the bytes are
+    /// written.
+    ENQUEUE_START,
+    ENQUEUE_END,
+
+    /// The start and end of constructing the InferResult from the
+    /// response.
+    DESERIALIZE_START,
+    DESERIALIZE_END,
+
+    /// The start and end of running the completion callback of an
+    /// asynchronous request.
+    CALLBACK_START,
+    CALLBACK_END,
+
     COUNT__
   };
 
   /// Construct a timer with zero-ed timestamps.
-  RequestTimers() : timestamps_((size_t)Kind::COUNT__) { Reset(); }
+  RequestTimers() { Reset(); }
 
   /// Reset all timestamp values to zero. Must be called before
   /// re-using the timer.
-  void Reset()
-  {
-    memset(&timestamps_[0], 0, sizeof(uint64_t) * timestamps_.size());
-  }
+  void Reset() { timestamps_.fill(0); }
 
   /// Get the timestamp, in nanoseconds, for a kind.
   /// \param kind The timestamp kind.
@@ -599,7 +1017,59 @@ class RequestTimers {
   }
 
  private:
-  std::vector<uint64_t> timestamps_;
+  std::array<uint64_t, (size_t)Kind::COUNT__> timestamps_;
+};
+
+//==============================================================================
+/// The arrival of the responses of a request sent on a gRPC stream. A
+/// decoupled model may send any number of responses for a request. All the
+/// times are in nanoseconds on the clock of RequestTimers.
+///
+struct ResponseTimeline {
+  ResponseTimeline() : request_start_ns(0), complete(false), complete_ns(0) {}
+
+  /// The id of the request, empty if the request has no id.
+  std::string request_id;
+
+  /// The time the request started.
+  uint64_t request_start_ns;
+
+  /// The time each response of the request was received, in the order of
+  /// the responses. An empty final response is not included.
+  std::vector<uint64_t> response_ns;
+
+  /// Whether the final response of the request was received. A request is
+  /// incomplete if the stream ended before its final response.
+  bool complete;
+
+  /// The time the final response was received, 0 if the request is
+  /// incomplete.
+  uint64_t complete_ns;
+
+  /// \return The number of responses received.
+  size_t ResponseCount() const { return response_ns.size(); }
+
+  /// \return The time from the request start until the first response is
+  /// received, 0 if no response is received.
+  uint64_t TimeToFirstResponseNs() const
+  {
+    return response_ns.empty() ? 0 : response_ns.front() - request_start_ns;
+  }
+
+  /// \param idx The index of the response, must be in [1, ResponseCount()).
+  /// \return The time between receiving the previous response and the
+  /// response at 'idx'.
+  uint64_t ResponseGapNs(size_t idx) const
+  {
+    return response_ns[idx] - response_ns[idx - 1];
+  }
+
+  /// \return The time from the request start until the final response is
+  /// received, 0 if the request is incomplete.
+  uint64_t TimeToFinalResponseNs() const
+  {
+    return complete ? complete_ns - request_start_ns : 0;
+  }
 };
 
 
@@ -618,6 +1088,14 @@ class InferRequest {
 
   RequestTimers& Timer() { return timer_; }
 
+  // Prepare the request to be reused for another inference request
+  // that completes with 'callback'.
+  void Reuse(InferenceServerClient::OnCompleteFn callback)
+  {
+    callback_ = std::move(callback);
+    timer_.Reset();
+  }
+
  protected:
   InferenceServerClient::OnCompleteFn callback_;
   const bool verbose_;
@@ -627,5 +1105,168 @@ class InferRequest {
   RequestTimers timer_;
 };
 
+//==============================================================================
+// A pool of objects shared with std::shared_ptr. An object is handed out
+// again once the pool holds the only reference to it, so neither the
+// object nor its control block is reallocated once the pool holds as
+// many objects as are used at the same time. The pool holds at most
+// 'max_size' objects, the objects created when it is full are not kept.
+//
+template <typename T>
+class SharedObjectPool {
+ public:
+  // 'max_scan_count' is the number of objects checked for reuse by each
+  // call to Acquire(), which bounds the time the pool is locked.
+  explicit SharedObjectPool(
+      const size_t max_size = 256, const size_t max_scan_count = 8)
+      : max_size_(max_size), max_scan_count_(max_scan_count), next_(0)
+  {
+  }
+
+  // Return an object that is no longer referenced outside of the pool,
+  // or a new object owning the pointer returned by 'create' if none is
+  // found among the objects checked. 'reused' returns whether an existing
+  // object is returned.
+  template <typename CreateFn>
+  std::shared_ptr<T> Acquire(CreateFn create, bool* reused)
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    // Start after the last object handed out, the objects are usually
+    // released in the order they were acquired so the oldest ones are
+    // checked first.
+    const size_t last = next_;
+    const size_t scan_count = std::min(max_scan_count_, objects_.size());
+    for (size_t i = 0; i < scan_count; ++i) {
+      next_ = (next_ + 1) % objects_.size();
+      if (objects_[next_].use_count() == 1) {
+        // Synchronize with the release of the last outside reference.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        *reused = true;
+        return objects_[next_];
+      }
+    }
+    *reused = false;
+    if (objects_.size() >= max_size_) {
+      lk.unlock();
+      return std::shared_ptr<T>(create());
+    }
+    // Insert the new object as the last one handed out, so that the oldest
+    // objects are still checked first by the next call.
+    next_ = (objects_.empty() ? 0 : last + 1);
+    return *objects_.insert(
+        objects_.begin() + next_, std::shared_ptr<T>(create()));
+  }
+
+ private:
+  const size_t max_size_;
+  const size_t max_scan_count_;
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<T>> objects_;
+  size_t next_;
+};
+
+//==============================================================================
+// Keeps the memory of released objects of type T for the objects of the
+// type created later, for the class-specific operator new and operator
+// delete of a type that is created for every request. At most
+// 'kMaxBlockCount' blocks are kept, the others are freed.
+//
+template <typename T>
+class RecycledMemory {
+ public:
+  static void* Allocate(const size_t size)
+  {
+    // The objects of a derived type have a different size and are not
+    // recycled.
+    if (size == sizeof(T)) {
+      Blocks& blocks = GetBlocks();
+      std::lock_guard<std::mutex> lk(blocks.mutex);
+      if (!blocks.free.empty()) {
+        void* ptr = blocks.free.back();
+        blocks.free.pop_back();
+        return ptr;
+      }
+    }
+    return ::operator new(size);
+  }
+
+  static void Release(void* ptr, const size_t size)
+  {
+    if (size == sizeof(T)) {
+      Blocks& blocks = GetBlocks();
+      std::lock_guard<std::mutex> lk(blocks.mutex);
+      if (blocks.free.size() < kMaxBlockCount) {
+        blocks.free.push_back(ptr);
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+ private:
+  enum { kMaxBlockCount = 256 };
+
+  struct Blocks {
+    Blocks() { free.reserve(kMaxBlockCount); }
+    std::mutex mutex;
+    std::vector<void*> free;
+  };
+
+  // Never destroyed, as objects may still be released during the
+  // destruction of static objects.
+  static Blocks& GetBlocks()
+  {
+    static Blocks* blocks = new Blocks();
+    return *blocks;
+  }
+};
+
+//==============================================================================
+// Decides whether the automatic compression mode compresses a request.
+// Requests smaller than 'min_byte_size' are sent uncompressed since the
+// saving can't outweigh the fixed cost. For larger requests the compressed
+// size is estimated from the byte entropy of samples spread over the
+// request, and requests that are not expected to shrink below 'max_ratio'
+// of their size are sent uncompressed. Otherwise, once the throughput of
+// the compression and of the transfer have been observed, the request is
+// compressed only if compressing and sending the smaller request is
+// expected to be faster than sending the original request. The throughputs
+// are moving averages over the recent requests. The methods can be called
+// from any number of threads at once.
+//
+class CompressionAdvisor {
+ public:
+  using Buffers = std::vector<std::pair<const uint8_t*, size_t>>;
+
+  explicit CompressionAdvisor(
+      const size_t min_byte_size = 4096, const double max_ratio = 0.9);
+
+  // Return whether to compress the request held by 'buffers', which has a
+  // total size of 'byte_size'.
+  bool ShouldCompress(const Buffers& buffers, const size_t byte_size);
+
+  // Record that compressing 'byte_size' bytes took 'duration_ns'.
+  void RecordCompression(const size_t byte_size, const uint64_t duration_ns);
+
+  // Record that sending a request of 'byte_size' bytes took 'duration_ns'.
+  void RecordTransfer(const size_t byte_size, const uint64_t duration_ns);
+
+  // Return the estimated ratio of the compressed size to the original size
+  // of the request held by 'buffers'.
+  static double EstimateCompressionRatio(
+      const Buffers& buffers, const size_t byte_size);
+
+ private:
+  void UpdateThroughput(
+      const size_t byte_size, const uint64_t duration_ns, double* throughput);
+
+  const size_t min_byte_size_;
+  const double max_ratio_;
+  std::mutex mutex_;
+  // The throughputs in bytes per nanosecond, 0 until observed
+  double compression_throughput_;
+  double transfer_throughput_;
+};
+
 
 }}  // namespace triton::client
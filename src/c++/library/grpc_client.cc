@@ -32,9 +32,12 @@
 #include <cstdint>
 #include <fstream>
 #include <future>
+#include <google/protobuf/io/coded_stream.h>
 #include <iostream>
 #include <mutex>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
 #include "grpc_client.h"
 
 namespace triton { namespace client {
@@ -50,6 +53,14 @@ std::map<
                      size_t, std::shared_ptr<grpc::Channel>,
                      std::shared_ptr<inference::GRPCInferenceService::Stub>>>
     grpc_channel_stub_map_;
+// Use map to keep track of the GRPC channel pools. <key, value> : <<url,
+// channel_count>, <shared_count, Channels>> A pool is reused the same way as
+// the channels of 'grpc_channel_stub_map_'.
+std::map<
+    std::pair<std::string, size_t>,
+    std::pair<size_t, std::vector<std::shared_ptr<grpc::Channel>>>>
+    grpc_channel_pool_map_;
+// Guards both 'grpc_channel_stub_map_' and 'grpc_channel_pool_map_'
 std::mutex grpc_channel_stub_map_mtx_;
 
 std::string
@@ -75,33 +86,43 @@ ReadFile(const std::string& filename, std::string& data)
   }
 }
 
-std::shared_ptr<inference::GRPCInferenceService::Stub>
-GetStub(
-    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
-    const grpc::ChannelArguments& channel_args, const bool use_cached_channel,
-    bool verbose)
+// The full name of the ModelInfer method, for calling it with a generic stub
+const char kModelInferMethod[] = "/inference.GRPCInferenceService/ModelInfer";
+
+// The protobuf wire type of length-delimited fields
+constexpr uint32_t kLengthDelimitedWireType = 2;
+
+// The largest output capacity kept by a pooled request for the next
+// response, larger outputs are released.
+constexpr size_t kMaxRetainedResponseByteSize = 1024 * 1024;
+
+// The current time in nanoseconds, on the clock of RequestTimers
+uint64_t
+NowNs()
 {
-  std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::high_resolution_clock::now().time_since_epoch())
+      .count();
+}
 
-  // Limit the number of sharing for each channel connects to the url,
-  // distributing clients to different channels relieves
-  // the pressure of reaching max connection concurrency
-  // https://grpc.io/docs/guides/performance/ (4th point)
+// Limit the number of sharing for each channel connects to the url,
+// distributing clients to different channels relieves
+// the pressure of reaching max connection concurrency
+// https://grpc.io/docs/guides/performance/ (4th point)
+size_t
+MaxShareCount()
+{
   static const size_t max_share_count =
       std::stoul(GetEnvironmentVariableOrDefault(
           "TRITON_CLIENT_GRPC_CHANNEL_MAX_SHARE_COUNT", "6"));
-  const auto& channel_itr = grpc_channel_stub_map_.find(url);
-  // Reuse cached channel if the channel is found in the map and
-  // used_cached_channel flag is true
-  if ((channel_itr != grpc_channel_stub_map_.end()) && use_cached_channel) {
-    // check if NewStub should be created
-    const auto& shared_count = std::get<0>(channel_itr->second);
-    if (shared_count % max_share_count != 0) {
-      std::get<0>(channel_itr->second)++;
-      return std::get<2>(channel_itr->second);
-    }
-  }
+  return max_share_count;
+}
 
+std::shared_ptr<grpc::Channel>
+CreateChannel(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const grpc::ChannelArguments& channel_args, bool verbose)
+{
   if (verbose) {
     std::cout << "Creating new channel with url:" << url << std::endl;
   }
@@ -129,8 +150,32 @@ GetStub(
   } else {
     credentials = grpc::InsecureChannelCredentials();
   }
+  return grpc::CreateCustomChannel(url, credentials, arguments);
+}
+
+std::shared_ptr<inference::GRPCInferenceService::Stub>
+GetStub(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const grpc::ChannelArguments& channel_args, const bool use_cached_channel,
+    bool verbose, std::shared_ptr<grpc::Channel>* stub_channel)
+{
+  std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
+
+  const auto& channel_itr = grpc_channel_stub_map_.find(url);
+  // Reuse cached channel if the channel is found in the map and
+  // used_cached_channel flag is true
+  if ((channel_itr != grpc_channel_stub_map_.end()) && use_cached_channel) {
+    // check if NewStub should be created
+    const auto& shared_count = std::get<0>(channel_itr->second);
+    if (shared_count % MaxShareCount() != 0) {
+      std::get<0>(channel_itr->second)++;
+      *stub_channel = std::get<1>(channel_itr->second);
+      return std::get<2>(channel_itr->second);
+    }
+  }
+
   std::shared_ptr<grpc::Channel> channel =
-      grpc::CreateCustomChannel(url, credentials, arguments);
+      CreateChannel(url, use_ssl, ssl_options, channel_args, verbose);
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub =
       inference::GRPCInferenceService::NewStub(channel);
   // Replace if channel / stub have been in the map
@@ -141,30 +186,607 @@ GetStub(
         std::make_pair(url, std::make_tuple(1, channel, stub)));
   }
 
+  *stub_channel = channel;
   return stub;
 }
+
+// Get 'channel_count' channels connecting to 'url', each channel has its
+// own connection to the server.
+void
+GetChannelPool(
+    const std::string& url, bool use_ssl, const SslOptions& ssl_options,
+    const grpc::ChannelArguments& channel_args, const size_t channel_count,
+    const bool use_cached_channel, bool verbose,
+    std::vector<std::shared_ptr<grpc::Channel>>* channels)
+{
+  std::lock_guard<std::mutex> lock(grpc_channel_stub_map_mtx_);
+
+  auto& pool = grpc_channel_pool_map_[std::make_pair(url, channel_count)];
+  // A new pool has a shared count of 0 and is always populated
+  if (use_cached_channel && (pool.first % MaxShareCount() != 0)) {
+    pool.first++;
+    *channels = pool.second;
+    return;
+  }
+
+  channels->clear();
+  for (size_t i = 0; i < channel_count; ++i) {
+    channels->push_back(
+        CreateChannel(url, use_ssl, ssl_options, channel_args, verbose));
+  }
+  pool = std::make_pair(1, *channels);
+}
+
+// The caller provided buffers to write the outputs into, keyed by output name
+typedef std::map<std::string, std::pair<uint8_t*, size_t>> OutputBufferMap;
+// The buffer and the byte size that each output of a response was written
+// into, indexed like the outputs of the response. A null buffer means that
+// the output is in the response.
+typedef std::vector<std::pair<const uint8_t*, size_t>> OutputBuffers;
+
+// Add the buffers set for 'outputs' to 'output_buffers'.
+void
+GetOutputBuffers(
+    const std::vector<const InferRequestedOutput*>& outputs,
+    OutputBufferMap* output_buffers)
+{
+  for (const auto output : outputs) {
+    if (output->HasBuffer()) {
+      uint8_t* buf;
+      size_t byte_size;
+      output->BufferInfo(&buf, &byte_size);
+      (*output_buffers)[output->Name()] = std::make_pair(buf, byte_size);
+    }
+  }
+}
+
+// Sequential reader over the slices of a serialized message.
+class SliceReader {
+ public:
+  explicit SliceReader(const std::vector<grpc::Slice>& slices)
+      : slices_(slices), index_(0), offset_(0)
+  {
+  }
+
+  bool Done()
+  {
+    while ((index_ < slices_.size()) && (offset_ == slices_[index_].size())) {
+      index_++;
+      offset_ = 0;
+    }
+    return (index_ >= slices_.size());
+  }
+
+  // Read a varint into 'value' and append its encoding to 'encoded' if not
+  // nullptr.
+  bool ReadVarint(uint64_t* value, std::string* encoded)
+  {
+    *value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+      if (Done()) {
+        return false;
+      }
+      const uint8_t byte = slices_[index_].begin()[offset_++];
+      if (encoded != nullptr) {
+        encoded->push_back(static_cast<char>(byte));
+      }
+      *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Copy the next 'size' bytes to 'dest'.
+  bool Read(size_t size, uint8_t* dest)
+  {
+    while (size > 0) {
+      if (Done()) {
+        return false;
+      }
+      const size_t count = std::min(size, slices_[index_].size() - offset_);
+      std::memcpy(dest, slices_[index_].begin() + offset_, count);
+      offset_ += count;
+      dest += count;
+      size -= count;
+    }
+    return true;
+  }
+
+  // Append the next 'size' bytes to 'dest'.
+  bool Read(size_t size, std::string* dest)
+  {
+    const size_t dest_size = dest->size();
+    dest->resize(dest_size + size);
+    return Read(size, reinterpret_cast<uint8_t*>(&(*dest)[dest_size]));
+  }
+
+ private:
+  const std::vector<grpc::Slice>& slices_;
+  size_t index_;
+  size_t offset_;
+};
+
+// Parse the serialized 'buffer' into 'response'. The raw_output_contents of
+// the outputs in 'output_buffers' are written directly into those buffers
+// and left empty in 'response', 'received_buffers' returns the buffer and
+// the byte size of each such output, indexed like the outputs of
+// 'response'.
+Error
+DeserializeInferResponse(
+    grpc::ByteBuffer* buffer, const OutputBufferMap& output_buffers,
+    inference::ModelInferResponse* response, OutputBuffers* received_buffers)
+{
+  received_buffers->clear();
+  if (output_buffers.empty()) {
+    grpc::Status status =
+        grpc::SerializationTraits<inference::ModelInferResponse>::Deserialize(
+            buffer, response);
+    if (!status.ok()) {
+      return Error(
+          "failed to parse inference response: " + status.error_message());
+    }
+    return Error::Success;
+  }
+
+  std::vector<grpc::Slice> slices;
+  grpc::Status status = buffer->Dump(&slices);
+  if (!status.ok()) {
+    return Error(
+        "failed to read inference response: " + status.error_message());
+  }
+
+  // Copy all the fields except the raw_output_contents written into the
+  // caller's buffers, which are replaced by empty entries so that the
+  // entries still match the outputs.
+  const Error parse_error("failed to parse inference response");
+  std::string message;
+  std::vector<std::string> output_names;
+  size_t raw_output_index = 0;
+  SliceReader reader(slices);
+  while (!reader.Done()) {
+    const size_t tag_offset = message.size();
+    uint64_t tag;
+    if (!reader.ReadVarint(&tag, &message)) {
+      return parse_error;
+    }
+    const uint64_t field_number = tag >> 3;
+    switch (tag & 0x7) {
+      case 0: {  // varint
+        uint64_t value;
+        if (!reader.ReadVarint(&value, &message)) {
+          return parse_error;
+        }
+        break;
+      }
+      case 1:  // 64-bit
+        if (!reader.Read(8, &message)) {
+          return parse_error;
+        }
+        break;
+      case 5:  // 32-bit
+        if (!reader.Read(4, &message)) {
+          return parse_error;
+        }
+        break;
+      case kLengthDelimitedWireType: {
+        uint64_t length;
+        if (!reader.ReadVarint(&length, &message)) {
+          return parse_error;
+        }
+        if (field_number ==
+            inference::ModelInferResponse::kRawOutputContentsFieldNumber) {
+          const auto it =
+              (raw_output_index < output_names.size())
+                  ? output_buffers.find(output_names[raw_output_index])
+                  : output_buffers.end();
+          if (it != output_buffers.end()) {
+            if (length > it->second.second) {
+              return Error(
+                  "output '" + it->first + "' has byte size " +
+                  std::to_string(length) +
+                  " which exceeds the byte size of its buffer " +
+                  std::to_string(it->second.second));
+            }
+            if (!reader.Read(length, it->second.first)) {
+              return parse_error;
+            }
+            // Replace the entry with an empty one
+            message.resize(tag_offset);
+            uint8_t empty_entry[6];
+            uint8_t* empty_entry_end =
+                google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+                    static_cast<uint32_t>(tag), empty_entry);
+            *empty_entry_end++ = 0;
+            message.append(
+                reinterpret_cast<char*>(empty_entry),
+                empty_entry_end - empty_entry);
+            received_buffers->resize(raw_output_index + 1);
+            (*received_buffers)[raw_output_index] =
+                std::make_pair(it->second.first, length);
+          } else if (!reader.Read(length, &message)) {
+            return parse_error;
+          }
+          raw_output_index++;
+        } else {
+          const size_t value_offset = message.size();
+          if (!reader.Read(length, &message)) {
+            return parse_error;
+          }
+          if (field_number ==
+              inference::ModelInferResponse::kOutputsFieldNumber) {
+            inference::ModelInferResponse::InferOutputTensor output;
+            if (!output.ParseFromArray(&message[value_offset], length)) {
+              return parse_error;
+            }
+            output_names.emplace_back(output.name());
+          }
+        }
+        break;
+      }
+      default:
+        return parse_error;
+    }
+  }
+
+  if (!response->ParseFromString(message)) {
+    return parse_error;
+  }
+  return Error::Success;
+}
 }  // namespace
 
+//==============================================================================
+// A StreamResponseTracker matches the responses received on a stream with
+// the requests sent on the stream by request id. Requests with the same id,
+// including the requests without id, are matched in the order they are sent.
+// A request completes with the response flagged by the
+// "triton_final_response" parameter, a response without the parameter is
+// the only response of its request.
+//
+class StreamResponseTracker {
+ public:
+  // Track a request sent on the stream, must be called before the request
+  // is written. 'timer' is null if the stats are not recorded.
+  void AddRequest(
+      const std::string& request_id, uint64_t request_start_ns,
+      std::unique_ptr<RequestTimers>&& timer);
+
+  // Record 'response' received at 'receive_ns'. Return true if the response
+  // completes its request, 'timer' and 'timeline' then return the timer and
+  // the timeline of the request.
+  bool AddResponse(
+      const inference::ModelStreamInferResponse& response, uint64_t receive_ns,
+      std::unique_ptr<RequestTimers>* timer, ResponseTimeline* timeline);
+
+  // Stop tracking the incomplete requests and return their timelines.
+  void Clear(std::vector<ResponseTimeline>* timelines);
+
+ private:
+  struct TrackedRequest {
+    std::unique_ptr<RequestTimers> timer;
+    ResponseTimeline timeline;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::deque<TrackedRequest>> requests_;
+};
+
+void
+StreamResponseTracker::AddRequest(
+    const std::string& request_id, uint64_t request_start_ns,
+    std::unique_ptr<RequestTimers>&& timer)
+{
+  TrackedRequest request;
+  request.timer = std::move(timer);
+  request.timeline.request_id = request_id;
+  request.timeline.request_start_ns = request_start_ns;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  requests_[request_id].emplace_back(std::move(request));
+}
+
+bool
+StreamResponseTracker::AddResponse(
+    const inference::ModelStreamInferResponse& response, uint64_t receive_ns,
+    std::unique_ptr<RequestTimers>* timer, ResponseTimeline* timeline)
+{
+  const auto& infer_response = response.infer_response();
+  bool is_final = true;
+  bool is_empty = false;
+  const auto& final_itr =
+      infer_response.parameters().find("triton_final_response");
+  if (final_itr != infer_response.parameters().end()) {
+    is_final = final_itr->second.bool_param();
+    is_empty = is_final && (infer_response.outputs_size() == 0) &&
+               response.error_message().empty();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto itr = requests_.find(infer_response.id());
+  if (itr == requests_.end()) {
+    return false;
+  }
+  TrackedRequest& request = itr->second.front();
+  if (!is_empty) {
+    request.timeline.response_ns.push_back(receive_ns);
+  }
+  if (!is_final) {
+    return false;
+  }
+
+  request.timeline.complete = true;
+  request.timeline.complete_ns = receive_ns;
+  *timer = std::move(request.timer);
+  *timeline = std::move(request.timeline);
+  itr->second.pop_front();
+  if (itr->second.empty()) {
+    requests_.erase(itr);
+  }
+  return true;
+}
+
+void
+StreamResponseTracker::Clear(std::vector<ResponseTimeline>* timelines)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& requests : requests_) {
+    for (auto& request : requests.second) {
+      timelines->emplace_back(std::move(request.timeline));
+    }
+  }
+  requests_.clear();
+}
+
+//==============================================================================
+// A GrpcInferChannel is a channel that the client sends inference requests
+// over, along with the number of its requests that are waiting for their
+// response.
+//
+class GrpcInferChannel {
+ public:
+  explicit GrpcInferChannel(const std::shared_ptr<grpc::Channel>& channel)
+      : stub_(channel), outstanding_count_(0)
+  {
+  }
+
+  grpc::GenericStub& Stub() { return stub_; }
+  size_t OutstandingCount() const { return outstanding_count_; }
+  void Acquire() { outstanding_count_++; }
+  void Release() { outstanding_count_--; }
+
+ private:
+  grpc::GenericStub stub_;
+  std::atomic<size_t> outstanding_count_;
+};
+
 //==============================================================================
 // An GrpcInferRequest represents an inflght inference request on gRPC.
 //
 class GrpcInferRequest : public InferRequest {
  public:
   GrpcInferRequest(InferenceServerClient::OnCompleteFn callback = nullptr)
-      : InferRequest(callback), grpc_status_(),
-        grpc_response_(std::make_shared<inference::ModelInferResponse>())
+      : InferRequest(callback), client_(nullptr), infer_channel_(nullptr),
+        call_id_(0), cancelled_(false), grpc_context_(nullptr),
+        grpc_status_(),
+        grpc_response_(std::make_shared<inference::ModelInferResponse>()),
+        received_output_buffers_(std::make_shared<OutputBuffers>())
   {
   }
+  ~GrpcInferRequest();
 
   friend InferenceServerGrpcClient;
 
+  // Reset the per call state so that the request can be reused for
+  // another call.
+  void ResetCall();
+
+  // Cancel the call identified by 'call_id' if it is the current call.
+  void Cancel(const uint64_t call_id);
+
  private:
-  // Variables for GRPC call
-  grpc::ClientContext grpc_context_;
+  // Reference to itself held while the call is in flight, the completion
+  // queue tag is the raw pointer.
+  std::shared_ptr<GrpcInferRequest> in_flight_;
+  // The client that completes the call, the completion queue may be shared
+  // by several clients.
+  InferenceServerGrpcClient* client_;
+  // The channel that the call in flight is sent over
+  GrpcInferChannel* infer_channel_;
+  // The request populated for the call, one request object can be used for
+  // multiple calls since it can be overwritten as soon as the send finishes.
+  inference::ModelInferRequest infer_request_;
+  // Guards the replacement of 'grpc_context_' against the cancellation of
+  // the call.
+  std::mutex cancel_mutex_;
+  // Identifies the call that the request is used for, so that a
+  // cancellation of a previous call doesn't affect the current one.
+  uint64_t call_id_;
+  // Whether the current call was cancelled
+  std::atomic<bool> cancelled_;
+  // Variables for GRPC call, a context can't be reused across calls so a
+  // new context is constructed in 'grpc_context_storage_' for each call.
+  std::aligned_storage<
+      sizeof(grpc::ClientContext), alignof(grpc::ClientContext)>::type
+      grpc_context_storage_;
+  grpc::ClientContext* grpc_context_;
   grpc::Status grpc_status_;
+  // The queue to wait on for the completion of a synchronous call, created
+  // on the first synchronous call made with this request.
+  std::unique_ptr<grpc::CompletionQueue> sync_completion_queue_;
+  // The serialized response received with the generic stub, parsed into
+  // 'grpc_response_' once the call completes.
+  grpc::ByteBuffer grpc_response_buffer_;
   std::shared_ptr<inference::ModelInferResponse> grpc_response_;
+  // The buffers to write the outputs into and, once the response is
+  // parsed, the buffers that received the outputs.
+  OutputBufferMap output_buffers_;
+  // Shared with the result as 'grpc_response_' is, and reused the same way.
+  std::shared_ptr<OutputBuffers> received_output_buffers_;
+};
+
+GrpcInferRequest::~GrpcInferRequest()
+{
+  if (sync_completion_queue_ != nullptr) {
+    sync_completion_queue_->Shutdown();
+    void* tag;
+    bool ok;
+    while (sync_completion_queue_->Next(&tag, &ok)) {
+    }
+  }
+  if (grpc_context_ != nullptr) {
+    grpc_context_->~ClientContext();
+  }
+}
+
+void
+GrpcInferRequest::ResetCall()
+{
+  {
+    std::lock_guard<std::mutex> lk(cancel_mutex_);
+    call_id_++;
+    cancelled_ = false;
+    if (grpc_context_ != nullptr) {
+      grpc_context_->~ClientContext();
+    }
+    grpc_context_ = new (&grpc_context_storage_) grpc::ClientContext();
+  }
+  grpc_status_ = grpc::Status();
+  grpc_response_buffer_.Clear();
+  // The response of the previous call keeps its allocated fields for the
+  // next response, unless it is still referenced by the previous result or
+  // its outputs have grown too large.
+  bool reuse_response = (grpc_response_.use_count() == 1);
+  if (reuse_response) {
+    // Synchronize with the release of the result's reference.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    size_t retained_byte_size = 0;
+    for (const auto& contents : grpc_response_->raw_output_contents()) {
+      retained_byte_size += contents.capacity();
+    }
+    reuse_response = (retained_byte_size <= kMaxRetainedResponseByteSize);
+  }
+  if (reuse_response) {
+    grpc_response_->Clear();
+  } else {
+    grpc_response_ = std::make_shared<inference::ModelInferResponse>();
+  }
+  output_buffers_.clear();
+  if (received_output_buffers_.use_count() == 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    received_output_buffers_->clear();
+  } else {
+    received_output_buffers_ = std::make_shared<OutputBuffers>();
+  }
+}
+
+void
+GrpcInferRequest::Cancel(const uint64_t call_id)
+{
+  std::lock_guard<std::mutex> lk(cancel_mutex_);
+  if (call_id == call_id_) {
+    cancelled_ = true;
+    grpc_context_->TryCancel();
+  }
+}
+
+//==============================================================================
+// A GrpcCancelHandle cancels the call of an asynchronous request, the
+// request then completes on its completion queue as any other request.
+//
+class GrpcCancelHandle : public CancelHandle {
+ public:
+  GrpcCancelHandle(
+      const std::shared_ptr<GrpcInferRequest>& request, const uint64_t call_id)
+      : request_(request), call_id_(call_id)
+  {
+  }
+
+  Error Cancel() override
+  {
+    // The request is released with the client
+    std::shared_ptr<GrpcInferRequest> request = request_.lock();
+    if (request != nullptr) {
+      request->Cancel(call_id_);
+    }
+    return Error::Success;
+  }
+
+ private:
+  std::weak_ptr<GrpcInferRequest> request_;
+  const uint64_t call_id_;
+};
+
+//==============================================================================
+// A GrpcPreparedInferRequest keeps a populated ModelInferRequest so that
+// issuing a request only needs to update the fields that may change between
+// requests: the id, the sequence parameters and the shape of each input.
+// The request has no raw_input_contents, the input data is appended when
+// the request is serialized.
+//
+class GrpcPreparedInferRequest : public PreparedInferRequest {
+ public:
+  GrpcPreparedInferRequest(
+      const InferenceServerClient* client, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const inference::ModelInferRequest& infer_request)
+      : PreparedInferRequest(client, options, inputs, outputs),
+        infer_request_(infer_request)
+  {
+  }
+
+  // Update the request with the current request id, sequence settings and
+  // input shapes.
+  Error Update();
+
+  const InferenceServerClient* Client() const { return client_; }
+  const inference::ModelInferRequest& Request() const
+  {
+    return infer_request_;
+  }
+  const std::vector<InferInput*>& Inputs() const { return inputs_; }
+  const std::vector<const InferRequestedOutput*>& Outputs() const
+  {
+    return outputs_;
+  }
+
+ private:
+  inference::ModelInferRequest infer_request_;
 };
 
+Error
+GrpcPreparedInferRequest::Update()
+{
+  infer_request_.set_id(options_.request_id_);
+
+  auto& parameters = *infer_request_.mutable_parameters();
+  if ((options_.sequence_id_ != 0) || (options_.sequence_id_str_ != "")) {
+    if (options_.sequence_id_ != 0) {
+      parameters["sequence_id"].set_int64_param(options_.sequence_id_);
+    } else {
+      parameters["sequence_id"].set_string_param(options_.sequence_id_str_);
+    }
+    parameters["sequence_start"].set_bool_param(options_.sequence_start_);
+    parameters["sequence_end"].set_bool_param(options_.sequence_end_);
+  } else {
+    parameters.erase("sequence_id");
+    parameters.erase("sequence_start");
+    parameters.erase("sequence_end");
+  }
+
+  for (size_t index = 0; index < inputs_.size(); ++index) {
+    auto grpc_input = infer_request_.mutable_inputs(index);
+    grpc_input->mutable_shape()->Clear();
+    for (const auto dim : inputs_[index]->Shape()) {
+      grpc_input->mutable_shape()->Add(dim);
+    }
+  }
+
+  return Error::Success;
+}
+
 //==============================================================================
 
 class InferResultGrpc : public InferResult {
@@ -172,7 +794,8 @@ class InferResultGrpc : public InferResult {
   static Error Create(
       InferResult** infer_result,
       std::shared_ptr<inference::ModelInferResponse> response,
-      Error& request_status);
+      Error& request_status,
+      std::shared_ptr<const OutputBuffers> output_buffers = nullptr);
   static Error Create(
       InferResult** infer_result,
       std::shared_ptr<inference::ModelStreamInferResponse> response);
@@ -192,32 +815,50 @@ class InferResultGrpc : public InferResult {
       const std::string& output_name,
       std::vector<std::string>* string_result) const override;
   std::string DebugString() const override { return response_->DebugString(); }
+  Error IsFinalResponse(bool* is_final_response) const override;
+  Error IsNullResponse(bool* is_null_response) const override;
+
+  // A result is created for every response, its memory is recycled.
+  static void* operator new(size_t size)
+  {
+    return RecycledMemory<InferResultGrpc>::Allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size)
+  {
+    RecycledMemory<InferResultGrpc>::Release(ptr, size);
+  }
 
  private:
   InferResultGrpc(
       std::shared_ptr<inference::ModelInferResponse> response,
-      Error& request_status);
+      Error& request_status,
+      std::shared_ptr<const OutputBuffers> output_buffers);
   InferResultGrpc(
       std::shared_ptr<inference::ModelStreamInferResponse> response);
 
-  std::map<std::string, const inference::ModelInferResponse::InferOutputTensor*>
-      output_name_to_tensor_map_;
-  std::map<std::string, std::pair<const uint8_t*, const uint32_t>>
-      output_name_to_buffer_map_;
+  // Return the index of the output named 'output_name' in the response, or
+  // -1 if there is no such output. The outputs are few, so they are searched
+  // instead of being indexed into a map for every response.
+  int OutputIndex(const std::string& output_name) const;
 
   std::shared_ptr<inference::ModelInferResponse> response_;
+  // The buffers that the outputs were written into, null if all outputs are
+  // in 'response_'.
+  std::shared_ptr<const OutputBuffers> output_buffers_;
   std::shared_ptr<inference::ModelStreamInferResponse> stream_response_;
   Error request_status_;
+  bool is_final_response_{true};
+  bool is_null_response_{false};
 };
 
 Error
 InferResultGrpc::Create(
     InferResult** infer_result,
     std::shared_ptr<inference::ModelInferResponse> response,
-    Error& request_status)
+    Error& request_status, std::shared_ptr<const OutputBuffers> output_buffers)
 {
-  *infer_result = reinterpret_cast<InferResult*>(
-      new InferResultGrpc(response, request_status));
+  *infer_result = reinterpret_cast<InferResult*>(new InferResultGrpc(
+      std::move(response), request_status, std::move(output_buffers)));
   return Error::Success;
 }
 
@@ -262,9 +903,9 @@ InferResultGrpc::Shape(
     const std::string& output_name, std::vector<int64_t>* shape) const
 {
   shape->clear();
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    for (const auto dim : it->second->shape()) {
+  const int index = OutputIndex(output_name);
+  if (index >= 0) {
+    for (const auto dim : response_->outputs(index).shape()) {
       shape->push_back(dim);
     }
   } else {
@@ -279,9 +920,9 @@ Error
 InferResultGrpc::Datatype(
     const std::string& output_name, std::string* datatype) const
 {
-  auto it = output_name_to_tensor_map_.find(output_name);
-  if (it != output_name_to_tensor_map_.end()) {
-    *datatype = it->second->datatype();
+  const int index = OutputIndex(output_name);
+  if (index >= 0) {
+    *datatype = response_->outputs(index).datatype();
   } else {
     return Error(
         "The response does not contain datatype for output name '" +
@@ -296,10 +937,22 @@ InferResultGrpc::RawData(
     const std::string& output_name, const uint8_t** buf,
     size_t* byte_size) const
 {
-  auto it = output_name_to_buffer_map_.find(output_name);
-  if (it != output_name_to_buffer_map_.end()) {
-    *buf = it->second.first;
-    *byte_size = it->second.second;
+  const int index = OutputIndex(output_name);
+  if (index >= 0) {
+    *buf = nullptr;
+    *byte_size = 0;
+    if (index < response_->raw_output_contents_size()) {
+      const std::string& contents = response_->raw_output_contents(index);
+      *buf = (uint8_t*)&(contents[0]);
+      *byte_size = contents.size();
+    }
+    // The output was written into the buffer provided by the caller
+    if ((output_buffers_ != nullptr) &&
+        (static_cast<size_t>(index) < output_buffers_->size()) &&
+        ((*output_buffers_)[index].first != nullptr)) {
+      *buf = (*output_buffers_)[index].first;
+      *byte_size = (*output_buffers_)[index].second;
+    }
   } else {
     return Error(
         "The response does not contain results for output name '" +
@@ -342,8 +995,9 @@ InferResultGrpc::StringData(
       buf_offset += (sizeof(element_size) + element_size);
     }
   } else {
-    auto it = output_name_to_tensor_map_.find(output_name);
-    for (const auto& element : it->second->contents().bytes_contents()) {
+    const int index = OutputIndex(output_name);
+    for (const auto& element :
+         response_->outputs(index).contents().bytes_contents()) {
       string_result->push_back(element);
     }
   }
@@ -351,21 +1005,44 @@ InferResultGrpc::StringData(
   return Error::Success;
 }
 
+Error
+InferResultGrpc::IsFinalResponse(bool* is_final_response) const
+{
+  if (is_final_response == nullptr) {
+    return Error("is_final_response cannot be nullptr");
+  }
+  *is_final_response = is_final_response_;
+  return Error::Success;
+}
+
+Error
+InferResultGrpc::IsNullResponse(bool* is_null_response) const
+{
+  if (is_null_response == nullptr) {
+    return Error("is_null_response cannot be nullptr");
+  }
+  *is_null_response = is_null_response_;
+  return Error::Success;
+}
+
+int
+InferResultGrpc::OutputIndex(const std::string& output_name) const
+{
+  for (int index = 0; index < response_->outputs_size(); index++) {
+    if (response_->outputs(index).name() == output_name) {
+      return index;
+    }
+  }
+  return -1;
+}
+
 InferResultGrpc::InferResultGrpc(
     std::shared_ptr<inference::ModelInferResponse> response,
-    Error& request_status)
-    : response_(response), request_status_(request_status)
-{
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
-  }
+    Error& request_status, std::shared_ptr<const OutputBuffers> output_buffers)
+    : response_(std::move(response)),
+      output_buffers_(std::move(output_buffers)),
+      request_status_(request_status)
+{
 }
 
 InferResultGrpc::InferResultGrpc(
@@ -376,15 +1053,12 @@ InferResultGrpc::InferResultGrpc(
   response_.reset(
       stream_response->mutable_infer_response(),
       [](inference::ModelInferResponse*) {});
-  uint32_t index = 0;
-  for (const auto& output : response_->outputs()) {
-    output_name_to_tensor_map_[output.name()] = &output;
-    const uint8_t* buf =
-        (uint8_t*)&(response_->raw_output_contents()[index][0]);
-    const uint32_t byte_size = response_->raw_output_contents()[index].size();
-    output_name_to_buffer_map_.insert(
-        std::make_pair(output.name(), std::make_pair(buf, byte_size)));
-    index++;
+  const auto& final_itr = response_->parameters().find("triton_final_response");
+  if (final_itr != response_->parameters().end()) {
+    is_final_response_ = final_itr->second.bool_param();
+    is_null_response_ = is_final_response_ &&
+                        (response_->outputs_size() == 0) &&
+                        request_status_.IsOk();
   }
 }
 
@@ -399,11 +1073,17 @@ InferenceServerGrpcClient::Create(
     std::unique_ptr<InferenceServerGrpcClient>* client,
     const std::string& server_url, const grpc::ChannelArguments& channel_args,
     bool verbose, bool use_ssl, const SslOptions& ssl_options,
-    const bool use_cached_channel)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
 {
+  if (client_options.completion_queue_count == 0) {
+    return Error("completion_queue_count must be at least 1");
+  }
+  if (client_options.channel_count == 0) {
+    return Error("channel_count must be at least 1");
+  }
   client->reset(new InferenceServerGrpcClient(
       server_url, verbose, use_ssl, ssl_options, channel_args,
-      use_cached_channel));
+      use_cached_channel, client_options));
   return Error::Success;
 }
 
@@ -414,7 +1094,7 @@ InferenceServerGrpcClient::Create(
     std::unique_ptr<InferenceServerGrpcClient>* client,
     const std::string& server_url, bool verbose, bool use_ssl,
     const SslOptions& ssl_options, const KeepAliveOptions& keepalive_options,
-    const bool use_cached_channel)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
 {
   // Construct channel channel_args specific to Triton
   grpc::ChannelArguments channel_args;
@@ -434,10 +1114,9 @@ InferenceServerGrpcClient::Create(
       GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA,
       keepalive_options.http2_max_pings_without_data);
 
-  client->reset(new InferenceServerGrpcClient(
-      server_url, verbose, use_ssl, ssl_options, channel_args,
-      use_cached_channel));
-  return Error::Success;
+  return Create(
+      client, server_url, channel_args, verbose, use_ssl, ssl_options,
+      use_cached_channel, client_options);
 }
 
 Error
@@ -1011,17 +1690,54 @@ InferenceServerGrpcClient::Infer(
     const std::vector<const InferRequestedOutput*>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
-  Error err;
-
-  grpc::ClientContext context;
-
-  std::shared_ptr<GrpcInferRequest> sync_request(new GrpcInferRequest());
+  return DoInfer(
+      result, options, inputs, outputs, nullptr /* prepared */, headers,
+      compression_algorithm);
+}
 
-  sync_request->Timer().Reset();
-  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
-  // Use send timer to measure time for marshalling infer request
-  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
-  for (const auto& it : headers) {
+Error
+InferenceServerGrpcClient::Infer(
+    InferResult** result, PreparedInferRequest* request,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  GrpcPreparedInferRequest* prepared;
+  Error err = ValidatePreparedRequest(request, &prepared);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return DoInfer(
+      result, prepared->Options(), prepared->Inputs(), prepared->Outputs(),
+      prepared, headers, compression_algorithm);
+}
+
+Error
+InferenceServerGrpcClient::DoInfer(
+    InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    GrpcPreparedInferRequest* prepared, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm)
+{
+  Error err;
+
+  // The request state is taken from the pool so that concurrent calls from
+  // different threads don't share it.
+  bool reused;
+  std::shared_ptr<GrpcInferRequest> sync_request = request_pool_.Acquire(
+      []() { return new GrpcInferRequest(); }, &reused);
+  UpdateRequestPoolStat(reused);
+  sync_request->Reuse(nullptr);
+  sync_request->ResetCall();
+  if (sync_request->sync_completion_queue_ == nullptr) {
+    sync_request->sync_completion_queue_.reset(new grpc::CompletionQueue());
+  }
+  grpc::ClientContext& context = *sync_request->grpc_context_;
+
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+  // Use send timer to measure time for marshalling infer request
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  for (const auto& it : headers) {
     context.AddMetadata(it.first, it.second);
   }
 
@@ -1030,23 +1746,70 @@ InferenceServerGrpcClient::Infer(
                     std::chrono::microseconds(options.client_timeout_);
     context.set_deadline(deadline);
   }
-  context.set_compression_algorithm(compression_algorithm);
 
-  err = PreRunProcessing(options, inputs, outputs);
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  grpc::ByteBuffer request_buffer;
+  err = (prepared != nullptr) ? prepared->Update()
+                              : PreRunProcessing(
+                                    options, inputs, outputs,
+                                    false /* copy_input_data */,
+                                    &sync_request->infer_request_);
+  if (err.IsOk()) {
+    err = SerializeInferRequest(
+        (prepared != nullptr) ? prepared->Request()
+                              : sync_request->infer_request_,
+        inputs, &request_buffer);
+  }
+  if (err.IsOk()) {
+    context.set_compression_algorithm(
+        RequestCompression(compression_algorithm, request_buffer));
+  }
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   if (!err.IsOk()) {
     return err;
   }
-  sync_request->grpc_response_->Clear();
-  sync_request->grpc_status_ = stub_->ModelInfer(
-      &context, infer_request_, sync_request->grpc_response_.get());
 
-  if (!sync_request->grpc_status_.ok()) {
-    err = Error(sync_request->grpc_status_.error_message());
+  // The request references the input buffers, so the call is sent through
+  // the generic stub and waited on before returning.
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_START);
+  GrpcInferChannel* infer_channel = AcquireInferChannel();
+  std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+      infer_channel->Stub().PrepareUnaryCall(
+          &context, kModelInferMethod, request_buffer,
+          sync_request->sync_completion_queue_.get()));
+  rpc->StartCall();
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_END);
+  rpc->Finish(
+      &sync_request->grpc_response_buffer_, &sync_request->grpc_status_,
+      (void*)sync_request.get());
+  void* tag;
+  bool ok = false;
+  const bool completed = sync_request->sync_completion_queue_->Next(&tag, &ok);
+  infer_channel->Release();
+  if (!completed) {
+    return Error("Completion queue is closed.");
   }
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
-  InferResultGrpc::Create(result, sync_request->grpc_response_, err);
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
+  sync_request->grpc_response_->Clear();
+  if (!sync_request->grpc_status_.ok()) {
+    err = Error(sync_request->grpc_status_.error_message());
+  } else {
+    GetOutputBuffers(outputs, &sync_request->output_buffers_);
+    err = DeserializeInferResponse(
+        &sync_request->grpc_response_buffer_, sync_request->output_buffers_,
+        sync_request->grpc_response_.get(),
+        sync_request->received_output_buffers_.get());
+  }
+  InferResultGrpc::Create(
+      result, sync_request->grpc_response_, err,
+      sync_request->received_output_buffers_);
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_END);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
@@ -1071,50 +1834,128 @@ InferenceServerGrpcClient::AsyncInfer(
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  return DoAsyncInfer(
+      std::move(callback), options, inputs, outputs, nullptr /* prepared */,
+      headers, compression_algorithm, nullptr /* cancel_handle */);
+}
+
+Error
+InferenceServerGrpcClient::AsyncInfer(
+    std::shared_ptr<CancelHandle>* cancel_handle, OnCompleteFn callback,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  return DoAsyncInfer(
+      std::move(callback), options, inputs, outputs, nullptr /* prepared */,
+      headers, compression_algorithm, cancel_handle);
+}
+
+Error
+InferenceServerGrpcClient::AsyncInfer(
+    OnCompleteFn callback, PreparedInferRequest* request,
+    const Headers& headers, grpc_compression_algorithm compression_algorithm)
+{
+  GrpcPreparedInferRequest* prepared;
+  Error err = ValidatePreparedRequest(request, &prepared);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return DoAsyncInfer(
+      std::move(callback), prepared->Options(), prepared->Inputs(),
+      prepared->Outputs(), prepared, headers, compression_algorithm,
+      nullptr /* cancel_handle */);
+}
+
+Error
+InferenceServerGrpcClient::DoAsyncInfer(
+    OnCompleteFn callback, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    GrpcPreparedInferRequest* prepared, const Headers& headers,
+    grpc_compression_algorithm compression_algorithm,
+    std::shared_ptr<CancelHandle>* cancel_handle)
 {
   if (callback == nullptr) {
     return Error(
         "Callback function must be provided along with AsyncInfer() call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
-  }
+  StartAsyncTransfer();
 
-  GrpcInferRequest* async_request;
-  async_request = new GrpcInferRequest(std::move(callback));
+  bool reused;
+  std::shared_ptr<GrpcInferRequest> async_request = request_pool_.Acquire(
+      []() { return new GrpcInferRequest(); }, &reused);
+  UpdateRequestPoolStat(reused);
+  async_request->Reuse(std::move(callback));
+  async_request->ResetCall();
+  GetOutputBuffers(outputs, &async_request->output_buffers_);
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
   for (const auto& it : headers) {
-    async_request->grpc_context_.AddMetadata(it.first, it.second);
+    async_request->grpc_context_->AddMetadata(it.first, it.second);
   }
 
   if (options.client_timeout_ != 0) {
     auto deadline = std::chrono::system_clock::now() +
                     std::chrono::microseconds(options.client_timeout_);
-    async_request->grpc_context_.set_deadline(deadline);
+    async_request->grpc_context_->set_deadline(deadline);
+  }
+
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  grpc::ByteBuffer request_buffer;
+  Error err = (prepared != nullptr) ? prepared->Update()
+                                    : PreRunProcessing(
+                                          options, inputs, outputs,
+                                          false /* copy_input_data */,
+                                          &async_request->infer_request_);
+  if (err.IsOk()) {
+    err = SerializeInferRequest(
+        (prepared != nullptr) ? prepared->Request()
+                              : async_request->infer_request_,
+        inputs, &request_buffer);
   }
-  async_request->grpc_context_.set_compression_algorithm(compression_algorithm);
-
-  Error err = PreRunProcessing(options, inputs, outputs);
   if (!err.IsOk()) {
-    delete async_request;
     return err;
   }
+  async_request->grpc_context_->set_compression_algorithm(
+      RequestCompression(compression_algorithm, request_buffer));
 
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_START);
 
-  std::unique_ptr<
-      grpc::ClientAsyncResponseReader<inference::ModelInferResponse>>
-      rpc(stub_->PrepareAsyncModelInfer(
-          &async_request->grpc_context_, infer_request_,
-          &async_request_completion_queue_));
+  grpc::CompletionQueue* completion_queue = polled_completion_queue_;
+  if (completion_queue == nullptr) {
+    const size_t queue_idx =
+        next_completion_queue_++ % async_request_completion_queues_.size();
+    completion_queue = async_request_completion_queues_[queue_idx].get();
+  }
+  async_request->client_ = this;
+  async_request->infer_channel_ = AcquireInferChannel();
+  std::unique_ptr<grpc::GenericClientAsyncResponseReader> rpc(
+      async_request->infer_channel_->Stub().PrepareUnaryCall(
+          async_request->grpc_context_, kModelInferMethod,
+          request_buffer, completion_queue));
 
   rpc->StartCall();
+  // Captured before Finish() as the request may complete on the transfer
+  // thread as soon as it is called.
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_END);
 
+  // The handle is created before Finish() since the request may be reused
+  // for another call as soon as it is called.
+  if (cancel_handle != nullptr) {
+    cancel_handle->reset(
+        new GrpcCancelHandle(async_request, async_request->call_id_));
+  }
+  async_request->in_flight_ = async_request;
   rpc->Finish(
-      async_request->grpc_response_.get(), &async_request->grpc_status_,
-      (void*)async_request);
+      &async_request->grpc_response_buffer_, &async_request->grpc_status_,
+      (void*)async_request.get());
 
   if (verbose_) {
     std::cout << "Sent request";
@@ -1135,8 +1976,6 @@ InferenceServerGrpcClient::InferMulti(
     const std::vector<std::vector<const InferRequestedOutput*>>& outputs,
     const Headers& headers, grpc_compression_algorithm compression_algorithm)
 {
-  Error err;
-
   // Sanity check
   if ((inputs.size() != options.size()) && (options.size() != 1)) {
     return Error(
@@ -1148,24 +1987,44 @@ InferenceServerGrpcClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
-  int64_t max_option_idx = options.size() - 1;
-  // value of '-1' means no output is specified
-  int64_t max_output_idx = outputs.size() - 1;
-  static std::vector<const InferRequestedOutput*> empty_outputs{};
-  for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
-    const auto& request_options = options[std::min(max_option_idx, i)];
-    const auto& request_output = (max_output_idx == -1)
-                                     ? empty_outputs
-                                     : outputs[std::min(max_output_idx, i)];
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
-        compression_algorithm);
-    if (!err.IsOk()) {
-      return err;
+  if (inputs.empty()) {
+    return Error::Success;
+  }
+
+  // When the application polls the completion queue nothing completes the
+  // asynchronous calls while this call waits, so the requests are sent one
+  // after another instead.
+  if (polled_completion_queue_ != nullptr) {
+    int64_t max_option_idx = options.size() - 1;
+    // value of '-1' means no output is specified
+    int64_t max_output_idx = outputs.size() - 1;
+    static std::vector<const InferRequestedOutput*> empty_outputs{};
+    for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
+      const auto& request_options = options[std::min(max_option_idx, i)];
+      const auto& request_output = (max_output_idx == -1)
+                                       ? empty_outputs
+                                       : outputs[std::min(max_output_idx, i)];
+
+      results->emplace_back();
+      Error err = Infer(
+          &results->back(), request_options, inputs[i], request_output,
+          headers, compression_algorithm);
+      if (!err.IsOk()) {
+        return err;
+      }
     }
+    return Error::Success;
   }
-  return Error::Success;
+
+  // Issue all the requests as asynchronous calls at once instead of one
+  // round trip after another, and wait for the last response.
+  return WaitInferMulti(
+      [&](OnMultiCompleteFn callback) {
+        return AsyncInferMulti(
+            callback, options, inputs, outputs, headers,
+            compression_algorithm);
+      },
+      results);
 }
 
 Error
@@ -1190,9 +2049,7 @@ InferenceServerGrpcClient::AsyncInferMulti(
         "Callback function must be provided along with AsyncInferMulti() "
         "call.");
   }
-  if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerGrpcClient::AsyncTransfer, this);
-  }
+  StartAsyncTransfer();
 
   int64_t max_option_idx = options.size() - 1;
   // value of '-1' means no output is specified
@@ -1306,20 +2163,28 @@ InferenceServerGrpcClient::AsyncStreamInfer(
     timer->CaptureTimestamp(RequestTimers::Kind::SEND_START);
   }
 
-  Error err = PreRunProcessing(options, inputs, outputs);
+  // Only one write may be outstanding on the stream, and the requests must
+  // be tracked in the order they are written.
+  std::lock_guard<std::mutex> write_lock(stream_write_mutex_);
+  if (enable_stream_stats_) {
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_START);
+  }
+  Error err = PreRunProcessing(
+      options, inputs, outputs, true /* copy_input_data */,
+      &stream_infer_request_);
   if (!err.IsOk()) {
     return err;
   }
 
   if (enable_stream_stats_) {
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
     timer->CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    const uint64_t request_start_ns =
+        timer->Timestamp(RequestTimers::Kind::REQUEST_START);
+    stream_response_tracker_->AddRequest(
+        options.request_id_, request_start_ns, std::move(timer));
   }
-
-  if (enable_stream_stats_) {
-    std::lock_guard<std::mutex> lock(stream_mutex_);
-    ongoing_stream_request_timers_.push(std::move(timer));
-  }
-  bool ok = grpc_stream_->Write(infer_request_);
+  bool ok = grpc_stream_->Write(stream_infer_request_);
 
   if (ok) {
     if (verbose_) {
@@ -1336,47 +2201,174 @@ InferenceServerGrpcClient::AsyncStreamInfer(
 }
 
 Error
-InferenceServerGrpcClient::PreRunProcessing(
+InferenceServerGrpcClient::CreateStream(
+    std::unique_ptr<GrpcInferStream>* stream, OnCompleteFn callback,
+    const GrpcStreamOptions& stream_options)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with CreateStream() call.");
+  }
+
+  std::call_once(streams_worker_started_, [this]() {
+    streams_worker_ =
+        std::thread(&InferenceServerGrpcClient::AsyncStreamsTransfer, this);
+  });
+
+  stream->reset(new GrpcInferStream(this, callback, stream_options));
+  (*stream)->Start(stub_.get(), &streams_completion_queue_);
+
+  if (verbose_) {
+    std::cout << "Created stream..." << std::endl;
+  }
+
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::PrepareInferRequest(
+    std::unique_ptr<PreparedInferRequest>* request,
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
+{
+  // Populate the request once, the prepared request keeps its own copy
+  // that is updated for each request.
+  inference::ModelInferRequest infer_request;
+  Error err = PreRunProcessing(
+      options, inputs, outputs, false /* copy_input_data */, &infer_request);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  request->reset(new GrpcPreparedInferRequest(
+      this, options, inputs, outputs, infer_request));
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::ValidatePreparedRequest(
+    PreparedInferRequest* request, GrpcPreparedInferRequest** prepared)
+{
+  *prepared = dynamic_cast<GrpcPreparedInferRequest*>(request);
+  if ((*prepared == nullptr) || ((*prepared)->Client() != this)) {
+    return Error("The request was not prepared by this client.");
+  }
+  return Error::Success;
+}
+
+// Serialize 'infer_request' into 'buffer' followed by the data of the
+// 'inputs' that are not in shared memory, as the raw_input_contents of the
+// request. 'infer_request' must not have any raw_input_contents. The input
+// data is referenced by 'buffer' instead of copied, so it must not be
+// modified or released until the request is sent.
+Error
+InferenceServerGrpcClient::SerializeInferRequest(
+    const inference::ModelInferRequest& infer_request,
+    const std::vector<InferInput*>& inputs, grpc::ByteBuffer* buffer)
+{
+  std::vector<grpc::Slice> slices;
+
+  // The request without the input data is small, serialize it directly
+  // into a slice owned by the buffer.
+  const size_t header_size = infer_request.ByteSizeLong();
+  grpc_slice header = grpc_slice_malloc(header_size);
+  infer_request.SerializeWithCachedSizesToArray(GRPC_SLICE_START_PTR(header));
+  slices.emplace_back(header, grpc::Slice::STEAL_REF);
+
+  size_t request_size = header_size;
+  const uint32_t tag =
+      (inference::ModelInferRequest::kRawInputContentsFieldNumber << 3) |
+      kLengthDelimitedWireType;
+  for (const auto input : inputs) {
+    if (input->IsSharedMemory()) {
+      continue;
+    }
+
+    // Each raw_input_contents entry starts with the field tag and the
+    // length of the data, at most 5 and 10 bytes as varints.
+    size_t content_size;
+    input->ByteSize(&content_size);
+    uint8_t prefix[16];
+    uint8_t* prefix_end =
+        google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+            tag, prefix);
+    prefix_end = google::protobuf::io::CodedOutputStream::WriteVarint64ToArray(
+        content_size, prefix_end);
+    slices.emplace_back(prefix, prefix_end - prefix);
+    request_size += (prefix_end - prefix) + content_size;
+
+    input->PrepareForRequest();
+    bool end_of_input = false;
+    while (!end_of_input) {
+      const uint8_t* buf;
+      size_t buf_size;
+      input->GetNext(&buf, &buf_size, &end_of_input);
+      if ((buf != nullptr) && (buf_size > 0)) {
+        slices.emplace_back(buf, buf_size, grpc::Slice::STATIC_SLICE);
+      }
+    }
+  }
+
+  if (request_size > INT_MAX) {
+    return Error(
+        "Request has byte size " + std::to_string(request_size) +
+        " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
+        ".");
+  }
+
+  grpc::ByteBuffer request_buffer(slices.data(), slices.size());
+  buffer->Swap(&request_buffer);
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::PreRunProcessing(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const bool copy_input_data, inference::ModelInferRequest* infer_request)
 {
   // Populate the request protobuf
-  infer_request_.set_model_name(options.model_name_);
-  infer_request_.set_model_version(options.model_version_);
-  infer_request_.set_id(options.request_id_);
+  infer_request->set_model_name(options.model_name_);
+  infer_request->set_model_version(options.model_version_);
+  infer_request->set_id(options.request_id_);
 
-  infer_request_.mutable_parameters()->clear();
+  infer_request->mutable_parameters()->clear();
   if ((options.sequence_id_ != 0) || (options.sequence_id_str_ != "")) {
     if (options.sequence_id_ != 0) {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_int64_param(
+      (*infer_request->mutable_parameters())["sequence_id"].set_int64_param(
           options.sequence_id_);
     } else {
-      (*infer_request_.mutable_parameters())["sequence_id"].set_string_param(
+      (*infer_request->mutable_parameters())["sequence_id"].set_string_param(
           options.sequence_id_str_);
     }
-    (*infer_request_.mutable_parameters())["sequence_start"].set_bool_param(
+    (*infer_request->mutable_parameters())["sequence_start"].set_bool_param(
         options.sequence_start_);
-    (*infer_request_.mutable_parameters())["sequence_end"].set_bool_param(
+    (*infer_request->mutable_parameters())["sequence_end"].set_bool_param(
         options.sequence_end_);
   }
   if (options.priority_ != 0) {
-    (*infer_request_.mutable_parameters())["priority"].set_int64_param(
+    (*infer_request->mutable_parameters())["priority"].set_int64_param(
         options.priority_);
   }
 
   if (options.server_timeout_ != 0) {
-    (*infer_request_.mutable_parameters())["timeout"].set_int64_param(
+    (*infer_request->mutable_parameters())["timeout"].set_int64_param(
         options.server_timeout_);
   }
 
+  if (options.enable_empty_final_response_) {
+    (*infer_request->mutable_parameters())["triton_enable_empty_final_response"]
+        .set_bool_param(true);
+  }
+
   int index = 0;
-  infer_request_.mutable_raw_input_contents()->Clear();
+  infer_request->mutable_raw_input_contents()->Clear();
   for (const auto input : inputs) {
     // Add new InferInputTensor submessages only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_input = (infer_request_.inputs().size() <= index)
-                          ? infer_request_.add_inputs()
-                          : infer_request_.mutable_inputs()->Mutable(index);
+    auto grpc_input = (infer_request->inputs().size() <= index)
+                          ? infer_request->add_inputs()
+                          : infer_request->mutable_inputs()->Mutable(index);
 
     if (input->IsSharedMemory()) {
       // The input contents must be cleared when using shared memory.
@@ -1406,9 +2398,9 @@ InferenceServerGrpcClient::PreRunProcessing(
         (*grpc_input->mutable_parameters())["shared_memory_offset"]
             .set_int64_param(offset);
       }
-    } else {
+    } else if (copy_input_data) {
       bool end_of_input = false;
-      std::string* raw_contents = infer_request_.add_raw_input_contents();
+      std::string* raw_contents = infer_request->add_raw_input_contents();
       size_t content_size;
       input->ByteSize(&content_size);
       raw_contents->reserve(content_size);
@@ -1427,17 +2419,17 @@ InferenceServerGrpcClient::PreRunProcessing(
 
   // Remove extra InferInputTensor submessages, that are not required for
   // this request.
-  while (index < infer_request_.inputs().size()) {
-    infer_request_.mutable_inputs()->RemoveLast();
+  while (index < infer_request->inputs().size()) {
+    infer_request->mutable_inputs()->RemoveLast();
   }
 
   index = 0;
   for (const auto routput : outputs) {
     // Add new InferRequestedOutputTensor submessage only if required, otherwise
     // reuse the submessages already available.
-    auto grpc_output = (infer_request_.outputs().size() <= index)
-                           ? infer_request_.add_outputs()
-                           : infer_request_.mutable_outputs()->Mutable(index);
+    auto grpc_output = (infer_request->outputs().size() <= index)
+                           ? infer_request->add_outputs()
+                           : infer_request->mutable_outputs()->Mutable(index);
     grpc_output->Clear();
     grpc_output->set_name(routput->Name());
     size_t class_count = routput->ClassificationCount();
@@ -1464,13 +2456,13 @@ InferenceServerGrpcClient::PreRunProcessing(
 
   // Remove extra InferRequestedOutputTensor submessages, that are not required
   // for this request.
-  while (index < infer_request_.outputs().size()) {
-    infer_request_.mutable_outputs()->RemoveLast();
+  while (index < infer_request->outputs().size()) {
+    infer_request->mutable_outputs()->RemoveLast();
   }
 
-  if (infer_request_.ByteSizeLong() > INT_MAX) {
-    size_t request_size = infer_request_.ByteSizeLong();
-    infer_request_.Clear();
+  if (infer_request->ByteSizeLong() > INT_MAX) {
+    size_t request_size = infer_request->ByteSizeLong();
+    infer_request->Clear();
     return Error(
         "Request has byte size " + std::to_string(request_size) +
         " which exceed gRPC's byte size limit " + std::to_string(INT_MAX) +
@@ -1481,15 +2473,89 @@ InferenceServerGrpcClient::PreRunProcessing(
 }
 
 void
-InferenceServerGrpcClient::AsyncTransfer()
+InferenceServerGrpcClient::StartAsyncTransfer()
+{
+  // 'async_request_completion_queues_' is empty when the application polls
+  // the completion queue.
+  std::call_once(workers_started_, [this]() {
+    for (auto& completion_queue : async_request_completion_queues_) {
+      async_workers_.emplace_back(
+          &InferenceServerGrpcClient::AsyncTransfer, this,
+          completion_queue.get());
+    }
+  });
+}
+
+GrpcInferChannel*
+InferenceServerGrpcClient::AcquireInferChannel()
+{
+  const size_t start = next_infer_channel_++ % infer_channels_.size();
+  GrpcInferChannel* infer_channel = infer_channels_[start].get();
+  if (channel_selection_ ==
+      GrpcClientOptions::ChannelSelection::LEAST_OUTSTANDING) {
+    // Scan from the channel in turn so that ties are spread across channels
+    for (size_t i = 1; i < infer_channels_.size(); ++i) {
+      GrpcInferChannel* candidate =
+          infer_channels_[(start + i) % infer_channels_.size()].get();
+      if (candidate->OutstandingCount() < infer_channel->OutstandingCount()) {
+        infer_channel = candidate;
+      }
+    }
+  }
+  infer_channel->Acquire();
+  return infer_channel;
+}
+
+grpc_compression_algorithm
+InferenceServerGrpcClient::RequestCompression(
+    const grpc_compression_algorithm compression_algorithm,
+    const grpc::ByteBuffer& request_buffer)
+{
+  if (!adaptive_compression_ || (compression_algorithm == GRPC_COMPRESS_NONE)) {
+    return compression_algorithm;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  // The slices reference the serialized request, nothing is copied
+  std::vector<grpc::Slice> slices;
+  CompressionAdvisor::Buffers buffers;
+  if (request_buffer.Dump(&slices).ok()) {
+    for (const auto& slice : slices) {
+      buffers.emplace_back(slice.begin(), slice.size());
+    }
+  }
+  const bool compress =
+      compression_advisor_.ShouldCompress(buffers, request_buffer.Length());
+  UpdateAutoCompressionStat(
+      compress,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count(),
+      0 /* input_byte_size */, 0 /* output_byte_size */);
+  return compress ? compression_algorithm : GRPC_COMPRESS_NONE;
+}
+
+void
+InferenceServerGrpcClient::AsyncTransfer(
+    grpc::CompletionQueue* completion_queue)
 {
   while (!exiting_) {
     // GRPC async APIs are thread-safe https://github.com/grpc/grpc/issues/4486
     GrpcInferRequest* raw_async_request;
     bool ok = true;
-    bool status =
-        async_request_completion_queue_.Next((void**)(&raw_async_request), &ok);
-    std::shared_ptr<GrpcInferRequest> async_request;
+    bool status;
+    if (busy_poll_) {
+      // A deadline in the past returns right away if no request is completed
+      grpc::CompletionQueue::NextStatus next_status;
+      do {
+        next_status = completion_queue->AsyncNext(
+            (void**)(&raw_async_request), &ok,
+            std::chrono::system_clock::time_point());
+      } while ((next_status == grpc::CompletionQueue::TIMEOUT) && !exiting_);
+      status = (next_status == grpc::CompletionQueue::GOT_EVENT);
+    } else {
+      status = completion_queue->Next((void**)(&raw_async_request), &ok);
+    }
     if (!ok) {
       fprintf(stderr, "Unexpected not ok on client side.\n");
     }
@@ -1500,30 +2566,127 @@ InferenceServerGrpcClient::AsyncTransfer()
     } else if (raw_async_request == nullptr) {
       fprintf(stderr, "Unexpected null tag received at client.\n");
     } else {
-      async_request.reset(raw_async_request);
-      InferResult* async_result;
-      Error err;
-      if (!async_request->grpc_status_.ok()) {
-        err = Error(async_request->grpc_status_.error_message());
-      }
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
-      InferResultGrpc::Create(
-          &async_result, async_request->grpc_response_, err);
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
-      err = UpdateInferStat(async_request->Timer());
-      if (!err.IsOk()) {
-        std::cerr << "Failed to update context stat: " << err << std::endl;
-      }
-      if (async_request->grpc_status_.ok()) {
-        if (verbose_) {
-          std::cout << async_request->grpc_response_->DebugString()
-                    << std::endl;
-        }
-      }
-      async_request->callback_(async_result);
+      CompleteAsyncRequest(raw_async_request);
+    }
+  }
+}
+
+Error
+InferenceServerGrpcClient::Poll(
+    const uint64_t timeout_us, size_t* completed_count)
+{
+  if (polled_completion_queue_ == nullptr) {
+    return Error(
+        "the client must be created with a 'completion_queue' to process its "
+        "requests");
+  }
+  const size_t count = ProcessCompletionQueue(
+      std::chrono::system_clock::now() +
+          std::chrono::microseconds(timeout_us),
+      SIZE_MAX);
+  if (completed_count != nullptr) {
+    *completed_count = count;
+  }
+  return Error::Success;
+}
+
+Error
+InferenceServerGrpcClient::ProcessCompletions(
+    const size_t max_count, size_t* completed_count)
+{
+  if (polled_completion_queue_ == nullptr) {
+    return Error(
+        "the client must be created with a 'completion_queue' to process its "
+        "requests");
+  }
+  const size_t count = ProcessCompletionQueue(
+      std::chrono::system_clock::time_point(), max_count);
+  if (completed_count != nullptr) {
+    *completed_count = count;
+  }
+  return Error::Success;
+}
+
+size_t
+InferenceServerGrpcClient::ProcessCompletionQueue(
+    const std::chrono::system_clock::time_point& deadline,
+    const size_t max_count)
+{
+  size_t count = 0;
+  // A deadline in the past only returns the completions already available
+  std::chrono::system_clock::time_point next_deadline = deadline;
+  while (count < max_count) {
+    GrpcInferRequest* raw_async_request;
+    bool ok = true;
+    if (polled_completion_queue_->AsyncNext(
+            (void**)(&raw_async_request), &ok, next_deadline) !=
+        grpc::CompletionQueue::GOT_EVENT) {
+      break;
+    }
+    next_deadline = std::chrono::system_clock::time_point();
+    if (!ok) {
+      fprintf(stderr, "Unexpected not ok on client side.\n");
+    }
+    if (raw_async_request == nullptr) {
+      fprintf(stderr, "Unexpected null tag received at client.\n");
+      continue;
+    }
+    // The request may be from another client sharing the queue
+    raw_async_request->client_->CompleteAsyncRequest(raw_async_request);
+    ++count;
+  }
+  return count;
+}
+
+void
+InferenceServerGrpcClient::CompleteAsyncRequest(
+    GrpcInferRequest* raw_async_request)
+{
+  std::shared_ptr<GrpcInferRequest> async_request =
+      std::move(raw_async_request->in_flight_);
+  async_request->infer_channel_->Release();
+  InferResult* async_result;
+  Error err;
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_START);
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
+  // A call cancelled after it completed keeps the status it completed with
+  const bool cancelled =
+      async_request->cancelled_ && !async_request->grpc_status_.ok();
+  if (cancelled) {
+    err = Error("Cancelled");
+  } else if (!async_request->grpc_status_.ok()) {
+    err = Error(async_request->grpc_status_.error_message());
+  } else {
+    err = DeserializeInferResponse(
+        &async_request->grpc_response_buffer_,
+        async_request->output_buffers_,
+        async_request->grpc_response_.get(),
+        async_request->received_output_buffers_.get());
+  }
+  InferResultGrpc::Create(
+      &async_result, async_request->grpc_response_, err,
+      async_request->received_output_buffers_);
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_END);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::RECV_END);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+  if (!cancelled) {
+    err = UpdateInferStat(async_request->Timer());
+    if (!err.IsOk()) {
+      std::cerr << "Failed to update context stat: " << err << std::endl;
     }
   }
+  if (async_request->grpc_status_.ok()) {
+    if (verbose_) {
+      std::cout << async_request->grpc_response_->DebugString() << std::endl;
+    }
+  }
+  // Release the request before the callback so that it can be reused
+  // as soon as the callback returns.
+  auto callback = std::move(async_request->callback_);
+  async_request.reset();
+  RunCallback(std::move(callback), async_result);
 }
 
 void
@@ -1538,25 +2701,22 @@ InferenceServerGrpcClient::AsyncStreamTransfer()
       continue;
     }
 
+    // The stats of a request are recorded with its final response
     std::unique_ptr<RequestTimers> timer;
     if (enable_stream_stats_) {
-      std::lock_guard<std::mutex> lock(stream_mutex_);
-      if (!ongoing_stream_request_timers_.empty()) {
-        timer = std::move(ongoing_stream_request_timers_.front());
-        ongoing_stream_request_timers_.pop();
-      }
+      ResponseTimeline timeline;
+      stream_response_tracker_->AddResponse(
+          *response, NowNs(), &timer, &timeline);
     }
 
     InferResult* stream_result;
-    // FIXME, DLIS-1263 there is no 1:1 mapping between
-    // requests and response for decoupled streaming case
-    // hence, this method will record incorrect statistics
-    // for decoupled case.
     if (timer.get() != nullptr) {
       timer->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
     }
     InferResultGrpc::Create(&stream_result, response);
     if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
       timer->CaptureTimestamp(RequestTimers::Kind::RECV_END);
       timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
       Error err = UpdateInferStat(*timer);
@@ -1567,48 +2727,378 @@ InferenceServerGrpcClient::AsyncStreamTransfer()
     if (verbose_) {
       std::cout << response->DebugString() << std::endl;
     }
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::CALLBACK_START);
+    }
     stream_callback_(stream_result);
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::CALLBACK_END);
+      UpdateCallbackStat(*timer);
+    }
     response = std::make_shared<inference::ModelStreamInferResponse>();
   }
   grpc_stream_->Finish();
+
+  std::vector<ResponseTimeline> timelines;
+  stream_response_tracker_->Clear(&timelines);
+}
+
+void
+InferenceServerGrpcClient::AsyncStreamsTransfer()
+{
+  void* tag;
+  bool ok;
+  // End loop once the queue is shut down and drained
+  while (streams_completion_queue_.Next(&tag, &ok)) {
+    GrpcInferStream::Tag* stream_tag = static_cast<GrpcInferStream::Tag*>(tag);
+    stream_tag->stream->Process(stream_tag->op, ok);
+  }
 }
 
 InferenceServerGrpcClient::InferenceServerGrpcClient(
     const std::string& url, bool verbose, bool use_ssl,
     const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
-    const bool use_cached_channel)
-    : InferenceServerClient(verbose)
+    const bool use_cached_channel, const GrpcClientOptions& client_options)
+    : InferenceServerClient(verbose),
+      polled_completion_queue_(client_options.completion_queue),
+      busy_poll_(client_options.busy_poll), next_completion_queue_(0),
+      stream_response_tracker_(new StreamResponseTracker()),
+      channel_selection_(client_options.channel_selection),
+      next_infer_channel_(0),
+      adaptive_compression_(client_options.adaptive_compression)
 {
-  stub_ = GetStub(
-      url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose);
+  callback_executor_ = client_options.callback_executor;
+  if (polled_completion_queue_ == nullptr) {
+    for (size_t i = 0; i < client_options.completion_queue_count; ++i) {
+      async_request_completion_queues_.emplace_back(
+          new grpc::CompletionQueue());
+    }
+  }
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  if (client_options.channel_count > 1) {
+    GetChannelPool(
+        url, use_ssl, ssl_options, channel_args, client_options.channel_count,
+        use_cached_channel, verbose, &channels);
+    stub_ = inference::GRPCInferenceService::NewStub(channels[0]);
+  } else {
+    std::shared_ptr<grpc::Channel> channel;
+    stub_ = GetStub(
+        url, use_ssl, ssl_options, channel_args, use_cached_channel, verbose,
+        &channel);
+    channels.push_back(channel);
+  }
+  for (const auto& channel : channels) {
+    infer_channels_.emplace_back(new GrpcInferChannel(channel));
+  }
 }
 
 InferenceServerGrpcClient::~InferenceServerGrpcClient()
 {
   exiting_ = true;
-  // Close complete queue and wait for the worker thread to return
-  async_request_completion_queue_.Shutdown();
+  // Close complete queues and wait for the worker threads to return
+  for (auto& completion_queue : async_request_completion_queues_) {
+    completion_queue->Shutdown();
+  }
 
-  // thread not joinable if AsyncInfer() is not called
-  // (it is default constructed thread before the first AsyncInfer() call)
-  if (worker_.joinable()) {
-    worker_.join();
+  // no worker thread is started if AsyncInfer() is not called
+  for (auto& worker : async_workers_) {
+    worker.join();
+  }
+
+  for (auto& completion_queue : async_request_completion_queues_) {
+    bool has_next = true;
+    GrpcInferRequest* async_request;
+    bool ok;
+    do {
+      has_next = completion_queue->Next((void**)&async_request, &ok);
+      if (has_next && async_request != nullptr) {
+        async_request->in_flight_.reset();
+      }
+    } while (has_next);
   }
+  WaitForCallbacks();
 
-  bool has_next = true;
-  GrpcInferRequest* async_request;
+  // The created streams are destroyed before the client, so no operation is
+  // left on the queue of the streams.
+  streams_completion_queue_.Shutdown();
+  if (streams_worker_.joinable()) {
+    streams_worker_.join();
+  }
+  void* tag;
   bool ok;
-  do {
-    has_next =
-        async_request_completion_queue_.Next((void**)&async_request, &ok);
-    if (has_next && async_request != nullptr) {
-      delete async_request;
-    }
-  } while (has_next);
+  while (streams_completion_queue_.Next(&tag, &ok)) {
+  }
 
   StopStream();
 }
 
 //==============================================================================
 
+GrpcInferStream::GrpcInferStream(
+    InferenceServerGrpcClient* client,
+    InferenceServerClient::OnCompleteFn callback,
+    const GrpcStreamOptions& stream_options)
+    : client_(client), callback_(callback),
+      timeline_callback_(stream_options.timeline_callback),
+      enable_stats_(stream_options.enable_stats),
+      max_pending_writes_(stream_options.max_pending_writes),
+      start_tag_{this, Op::START}, read_tag_{this, Op::READ},
+      write_tag_{this, Op::WRITE}, writes_done_tag_{this, Op::WRITES_DONE},
+      finish_tag_{this, Op::FINISH},
+      response_(std::make_shared<inference::ModelStreamInferResponse>()),
+      response_tracker_(new StreamResponseTracker()), started_(false),
+      writing_(false), closed_(false), writes_done_(false), read_done_(false),
+      finishing_(false), finished_(false)
+{
+  for (const auto& it : stream_options.headers) {
+    grpc_context_.AddMetadata(it.first, it.second);
+  }
+
+  if (stream_options.stream_timeout != 0) {
+    auto deadline = std::chrono::system_clock::now() +
+                    std::chrono::microseconds(stream_options.stream_timeout);
+    grpc_context_.set_deadline(deadline);
+  }
+  grpc_context_.set_compression_algorithm(stream_options.compression_algorithm);
+}
+
+GrpcInferStream::~GrpcInferStream()
+{
+  Stop();
+}
+
+Error
+GrpcInferStream::AsyncStreamInfer(
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  const uint64_t request_start_ns = NowNs();
+  std::unique_ptr<RequestTimers> timer;
+  if (enable_stats_) {
+    timer.reset(new RequestTimers());
+    timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
+    timer->CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  }
+
+  std::unique_ptr<inference::ModelInferRequest> request;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      return Error("Stream has been closed.");
+    }
+    if ((max_pending_writes_ != 0) &&
+        (pending_writes_.size() >= max_pending_writes_)) {
+      return Error("The write queue of the stream is full.");
+    }
+    if (!free_requests_.empty()) {
+      request = std::move(free_requests_.back());
+      free_requests_.pop_back();
+    }
+  }
+  if (request == nullptr) {
+    request.reset(new inference::ModelInferRequest());
+  }
+
+  // The request is written after returning, so it must own the input data.
+  if (enable_stats_) {
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_START);
+  }
+  Error err = client_->PreRunProcessing(
+      options, inputs, outputs, true /* copy_input_data */, request.get());
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  if (enable_stats_) {
+    timer->CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
+    timer->CaptureTimestamp(RequestTimers::Kind::SEND_END);
+  }
+
+  // The requests must be tracked in the order they are written.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return Error("Stream has been closed.");
+  }
+  if ((max_pending_writes_ != 0) &&
+      (pending_writes_.size() >= max_pending_writes_)) {
+    free_requests_.push_back(std::move(request));
+    return Error("The write queue of the stream is full.");
+  }
+  response_tracker_->AddRequest(
+      options.request_id_, request_start_ns, std::move(timer));
+  pending_writes_.push_back(std::move(request));
+  WriteNext();
+
+  if (client_->verbose_) {
+    std::cout << "Queued request";
+    if (options.request_id_.size() != 0) {
+      std::cout << " '" << options.request_id_ << "'";
+    }
+    std::cout << " to the stream" << std::endl;
+  }
+
+  return Error::Success;
+}
+
+size_t
+GrpcInferStream::PendingWriteCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_writes_.size();
+}
+
+Error
+GrpcInferStream::Stop()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  closed_ = true;
+  WriteNext();
+  // The reader drains the stream properly
+  cv_.wait(lock, [this] { return finished_; });
+
+  if (!grpc_status_.ok()) {
+    return Error(grpc_status_.error_message());
+  }
+  return Error::Success;
+}
+
+void
+GrpcInferStream::Start(
+    inference::GRPCInferenceService::Stub* stub,
+    grpc::CompletionQueue* completion_queue)
+{
+  grpc_stream_ =
+      stub->PrepareAsyncModelStreamInfer(&grpc_context_, completion_queue);
+  grpc_stream_->StartCall(&start_tag_);
+}
+
+void
+GrpcInferStream::Process(Op op, bool ok)
+{
+  if ((op == Op::READ) && ok) {
+    // The stats of a request are recorded with its final response
+    std::unique_ptr<RequestTimers> timer;
+    ResponseTimeline timeline;
+    const bool completed =
+        response_tracker_->AddResponse(*response_, NowNs(), &timer, &timeline);
+
+    InferResult* stream_result;
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::RECV_START);
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
+    }
+    InferResultGrpc::Create(&stream_result, response_);
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
+      timer->CaptureTimestamp(RequestTimers::Kind::RECV_END);
+      timer->CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+      Error err = client_->UpdateInferStat(*timer);
+      if (!err.IsOk()) {
+        std::cerr << "Failed to update context stat: " << err << std::endl;
+      }
+    }
+    if (client_->verbose_) {
+      std::cout << response_->DebugString() << std::endl;
+    }
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::CALLBACK_START);
+    }
+    callback_(stream_result);
+    if (timer.get() != nullptr) {
+      timer->CaptureTimestamp(RequestTimers::Kind::CALLBACK_END);
+      client_->UpdateCallbackStat(*timer);
+    }
+    if (completed && (timeline_callback_ != nullptr)) {
+      timeline_callback_(timeline);
+    }
+    response_ = std::make_shared<inference::ModelStreamInferResponse>();
+    grpc_stream_->Read(response_.get(), &read_tag_);
+    return;
+  }
+
+  if (op == Op::FINISH) {
+    std::vector<ResponseTimeline> timelines;
+    response_tracker_->Clear(&timelines);
+    if (timeline_callback_ != nullptr) {
+      for (const auto& timeline : timelines) {
+        timeline_callback_(timeline);
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+    cv_.notify_all();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  switch (op) {
+    case Op::START:
+      if (ok) {
+        started_ = true;
+        grpc_stream_->Read(response_.get(), &read_tag_);
+        WriteNext();
+      } else {
+        read_done_ = true;
+        Close();
+      }
+      break;
+    case Op::READ:
+      // The stream ended and all responses are drained
+      read_done_ = true;
+      Close();
+      break;
+    case Op::WRITE:
+      writing_ = false;
+      free_requests_.push_back(std::move(pending_writes_.front()));
+      pending_writes_.pop_front();
+      if (!ok) {
+        Close();
+      }
+      WriteNext();
+      break;
+    case Op::WRITES_DONE:
+      writing_ = false;
+      break;
+    case Op::FINISH:
+      // Handled above
+      break;
+  }
+
+  // Finish the call once no read or write is outstanding
+  if (read_done_ && !writing_ && !finishing_) {
+    finishing_ = true;
+    grpc_stream_->Finish(&grpc_status_, &finish_tag_);
+  }
+}
+
+void
+GrpcInferStream::WriteNext()
+{
+  if (!started_ || writing_ || writes_done_) {
+    return;
+  }
+  if (!pending_writes_.empty()) {
+    writing_ = true;
+    grpc_stream_->Write(*pending_writes_.front(), &write_tag_);
+  } else if (closed_) {
+    writing_ = true;
+    writes_done_ = true;
+    grpc_stream_->WritesDone(&writes_done_tag_);
+  }
+}
+
+void
+GrpcInferStream::Close()
+{
+  closed_ = true;
+  writes_done_ = true;
+  // Drop the requests that are not being written
+  while (pending_writes_.size() > (writing_ ? 1 : 0)) {
+    free_requests_.push_back(std::move(pending_writes_.back()));
+    pending_writes_.pop_back();
+  }
+}
+
+//==============================================================================
+
 }}  // namespace triton::client
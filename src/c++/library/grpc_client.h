@@ -27,7 +27,10 @@
 
 /// \file
 
+#include <grpcpp/generic/generic_stub.h>
 #include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
 #include <queue>
 #include "common.h"
 #include "grpc_service.grpc.pb.h"
@@ -36,6 +39,12 @@
 
 namespace triton { namespace client {
 
+class GrpcInferChannel;
+class GrpcInferRequest;
+class GrpcInferStream;
+class StreamResponseTracker;
+class GrpcPreparedInferRequest;
+
 /// The key-value map type to be included in the request
 /// metadata
 typedef std::map<std::string, std::string> Headers;
@@ -81,12 +90,117 @@ struct KeepAliveOptions {
   int http2_max_pings_without_data;
 };
 
+// The options for tuning the processing of asynchronous requests by
+// InferenceServerGrpcClient.
+struct GrpcClientOptions {
+  // The policies for picking the channel that an inference request is sent
+  // over.
+  enum class ChannelSelection {
+    // Send the requests over the channels in turn.
+    ROUND_ROBIN,
+    // Send each request over the channel with the fewest requests waiting
+    // for their response.
+    LEAST_OUTSTANDING
+  };
+  explicit GrpcClientOptions()
+      : completion_queue_count(1), channel_count(1),
+        channel_selection(ChannelSelection::ROUND_ROBIN),
+        adaptive_compression(false), completion_queue(nullptr),
+        busy_poll(false)
+  {
+  }
+  // The number of completion queues for asynchronous requests, each polled
+  // by its own thread that creates the results and runs the callbacks,
+  // unless 'callback_executor' is set. The requests are distributed across
+  // the queues in round-robin order, so the callbacks of up to this many
+  // requests run concurrently. Must be at least 1. Default value is 1.
+  size_t completion_queue_count;
+  // The number of channels, each with its own connection to the server, that
+  // the inference requests are sent over. The other requests always use the
+  // first channel. With 'use_cached_channel' the channels are shared with
+  // the other clients created for the same url and channel count. Must be at
+  // least 1. Default value is 1.
+  size_t channel_count;
+  // The policy for picking the channel of each inference request when
+  // 'channel_count' is more than 1. Default value is ROUND_ROBIN.
+  ChannelSelection channel_selection;
+  // Whether the compression algorithm given to an inference call is applied
+  // automatically. The client then decides for each request whether to
+  // compress it with that algorithm or to send it uncompressed, from the
+  // size of the request and an estimate of its compressibility from samples
+  // of the data. Unlike the HTTP client, the throughput isn't considered
+  // since gRPC compresses the request internally. The decisions are reported
+  // in InferStat. Streams are not affected. Default value is false.
+  bool adaptive_compression;
+  // The executor running the callbacks of the asynchronous requests, see
+  // CallbackExecutor. When not set the callbacks run on the threads polling
+  // the completion queues. The callbacks of streams always run on the
+  // thread reading the stream so that the responses are delivered in order.
+  // The executor may be shared with other clients. Default value is null.
+  std::shared_ptr<CallbackExecutor> callback_executor;
+  // The completion queue of the asynchronous requests, polled by the
+  // application with Poll() or ProcessCompletions() instead of by threads
+  // owned by the client, 'completion_queue_count' is then ignored. The queue
+  // is owned by the application and may be shared by several clients, so
+  // that one thread processes the requests of all of them. It must only be
+  // used for the requests of these clients and must outlive them, and all
+  // the asynchronous requests must be completed before their client is
+  // destroyed. The streams are not affected. InferMulti() then sends its
+  // requests one after another since no thread completes them while it
+  // waits. Default value is null.
+  grpc::CompletionQueue* completion_queue;
+  // Whether the threads polling the completion queues spin on them without
+  // a deadline instead of blocking until a request completes. This avoids
+  // the latency of waking up a thread for each completion at the cost of
+  // keeping a core busy per completion queue. Not used when the application
+  // polls 'completion_queue'. Default value is false.
+  bool busy_poll;
+};
+
+struct GrpcStreamOptions {
+  explicit GrpcStreamOptions()
+      : enable_stats(true), stream_timeout(0),
+        compression_algorithm(GRPC_COMPRESS_NONE), max_pending_writes(0)
+  {
+  }
+  // Whether the client library records the client-side statistics for the
+  // inference requests on the stream. The statistics of a request are
+  // recorded when its final response is received, the responses are matched
+  // with their request by request id. Default value is true.
+  bool enable_stats;
+  // The end-to-end timeout for the stream in microseconds. The default value
+  // is 0 which means that there is no limitation on deadline.
+  uint32_t stream_timeout;
+  // Additional HTTP headers to include in the metadata of the stream.
+  Headers headers;
+  // The compression algorithm used by gRPC when sending the requests. By
+  // default compression is not used.
+  grpc_compression_algorithm compression_algorithm;
+  // The maximum number of requests queued on the stream that are not written
+  // yet. A request is rejected while the queue is full. The default value is
+  // 0 which means that the queue is unbounded.
+  size_t max_pending_writes;
+  // Optional function invoked with the timeline of the responses of each
+  // request, after the callback of its final response. The requests that are
+  // incomplete when the stream ends are reported once the stream ends. The
+  // responses are matched with their request by request id, requests with
+  // the same id are matched in the order they are sent. A response without
+  // the final flag is the only response of its request, so requests of a
+  // decoupled model should enable InferOptions::enable_empty_final_response_
+  // unless the model always flags its final response.
+  std::function<void(const ResponseTimeline&)> timeline_callback;
+};
+
 //==============================================================================
 /// An InferenceServerGrpcClient object is used to perform any kind of
-/// communication with the InferenceServer using gRPC protocol.  Most
-/// of the methods are thread-safe except Infer, AsyncInfer, StartStream
-/// StopStream and AsyncStreamInfer. Calling these functions from different
-/// threads will cause undefined behavior.
+/// communication with the InferenceServer using gRPC protocol. The
+/// methods are thread-safe except StartStream and StopStream, which must
+/// not be called from different threads at the same time or while
+/// AsyncStreamInfer is running. Infer, AsyncInfer and AsyncStreamInfer can
+/// be called from any number of threads at once, each call uses its own
+/// request state. A PreparedInferRequest must not be used by different
+/// threads at the same time. The streams created with CreateStream() can be
+/// used from any number of threads, see GrpcInferStream.
 ///
 /// \code
 ///   std::unique_ptr<InferenceServerGrpcClient> client;
@@ -116,13 +230,16 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param use_cached_channel If false, a new channel is created for each
   /// new client instance. When true, re-use old channels from cache for new
   /// client instances. The default value is true.
+  /// \param client_options Specifies the options for tuning the processing
+  /// of asynchronous requests.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerGrpcClient>* client,
       const std::string& server_url, bool verbose = false, bool use_ssl = false,
       const SslOptions& ssl_options = SslOptions(),
       const KeepAliveOptions& keepalive_options = KeepAliveOptions(),
-      const bool use_cached_channel = true);
+      const bool use_cached_channel = true,
+      const GrpcClientOptions& client_options = GrpcClientOptions());
 
   /// Create a client that can be used to communicate with the server.
   /// This method is available for advanced users who need to specify custom
@@ -142,13 +259,16 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param use_cached_channel If false, a new channel is created for each
   /// new client instance. When true, re-use old channels from cache for new
   /// client instances. The default value is true.
+  /// \param client_options Specifies the options for tuning the processing
+  /// of asynchronous requests.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerGrpcClient>* client,
       const std::string& server_url, const grpc::ChannelArguments& channel_args,
       bool verbose = false, bool use_ssl = false,
       const SslOptions& ssl_options = SslOptions(),
-      const bool use_cached_channel = true);
+      const bool use_cached_channel = true,
+      const GrpcClientOptions& client_options = GrpcClientOptions());
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -418,6 +538,9 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// results inside the callback function or deferring it to a different thread
   /// so that the client is unblocked. In order to prevent memory leak, user
   /// must ensure this object gets deleted.
+  /// Note: The input data is not copied into the request but sent from the
+  /// buffers provided with InferInput::AppendRaw(). The buffer contents must
+  /// not be modified or released until the respective callback is invoked.
   /// \param callback The callback function to be invoked on request completion.
   /// \param options The options for inference request.
   /// \param inputs The vector of InferInput describing the model inputs.
@@ -437,8 +560,80 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const Headers& headers = Headers(),
       grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
 
-  /// Run multiple synchronous inferences on server.
-  /// \param results Returns the results of the inferences.
+  /// Run asynchronous inference on server and return a handle to cancel the
+  /// request, see CancelHandle. The call of a cancelled request is cancelled
+  /// with grpc::ClientContext::TryCancel(), the request is not recorded in
+  /// the statistics. See the other AsyncInfer() for the other parameters.
+  /// \param cancel_handle Returns the handle to cancel the request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      std::shared_ptr<CancelHandle>* cancel_handle, OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Prepare an inference request that can be issued repeatedly with
+  /// Infer() or AsyncInfer(). The request protobuf is populated once, only
+  /// the fields that may change between requests are updated when the
+  /// request is issued. See PreparedInferRequest for the changes allowed
+  /// between requests.
+  /// \param request Returns the prepared request.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how the
+  /// output must be returned. If not provided then all the outputs in the model
+  /// config will be returned as default settings.
+  /// \return Error object indicating success or failure.
+  Error PrepareInferRequest(
+      std::unique_ptr<PreparedInferRequest>* request,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Run synchronous inference on server using a prepared request.
+  /// \param result Returns the result of inference.
+  /// \param request The request prepared by PrepareInferRequest() of this
+  /// client.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error Infer(
+      InferResult** result, PreparedInferRequest* request,
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Run asynchronous inference on server using a prepared request. See
+  /// the other AsyncInfer() for the handling of the callback. Once as many
+  /// calls have completed as are in flight at the same time, the request
+  /// state, the response message, the storage of the client context and the
+  /// memory of the result are reused. gRPC still allocates for each call,
+  /// for the client context it requires per call, the serialized request and
+  /// the call itself.
+  /// \param callback The callback function to be invoked on request completion.
+  /// \param request The request prepared by PrepareInferRequest() of this
+  /// client.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in the metadata of gRPC request.
+  /// \param compression_algorithm The compression algorithm to be used
+  /// by gRPC when sending requests. By default compression is not used.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      OnCompleteFn callback, PreparedInferRequest* request,
+      const Headers& headers = Headers(),
+      grpc_compression_algorithm compression_algorithm = GRPC_COMPRESS_NONE);
+
+  /// Run multiple synchronous inferences on server. All the requests are
+  /// sent concurrently and the call blocks until every response is received,
+  /// so the function must not be called from within a callback of this
+  /// client. If the client was created with a 'completion_queue' polled by
+  /// the application, the requests are sent one after another.
+  /// \param results Returns the results of the inferences, one per request
+  /// in the order of 'inputs', including the results of failed requests.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
   /// \param inputs The vector of InferInput objects describing the model inputs
@@ -452,7 +647,7 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   /// \param compression_algorithm The compression algorithm to be used
   /// by gRPC when sending requests. By default compression is not used.
   /// \return Error object indicating success or failure of the
-  /// request.
+  /// requests, the error of the first failed request is returned.
   Error InferMulti(
       std::vector<InferResult*>* results,
       const std::vector<InferOptions>& options,
@@ -534,21 +729,125 @@ class InferenceServerGrpcClient : public InferenceServerClient {
       const std::vector<const InferRequestedOutput*>& outputs =
           std::vector<const InferRequestedOutput*>());
 
+  /// Create a grpc bi-directional stream that is independent of the stream
+  /// of StartStream() and of the other created streams. The requests are
+  /// written to the stream asynchronously, see GrpcInferStream. The stream
+  /// must be destroyed before the client.
+  /// \param stream Returns the new stream.
+  /// \param callback The callback function to be invoked on receiving a
+  /// response at the stream.
+  /// \param stream_options The options of the stream.
+  /// \return Error object indicating success or failure.
+  Error CreateStream(
+      std::unique_ptr<GrpcInferStream>* stream, OnCompleteFn callback,
+      const GrpcStreamOptions& stream_options = GrpcStreamOptions());
+
+  /// Process the asynchronous requests on the completion queue given in the
+  /// client options, waiting up to 'timeout_us' for the first completion.
+  /// The results are created and the callbacks of the completed requests
+  /// are run, on the calling thread unless a callback executor is set. The
+  /// requests of all the clients sharing the queue are processed. The
+  /// function can be called from several threads at once.
+  /// \param timeout_us The maximum time to wait, in microseconds. A value of
+  /// 0 returns without waiting.
+  /// \param completed_count Optional, returns the number of completed
+  /// requests whose callback was run.
+  /// \return Error object indicating success or failure.
+  Error Poll(const uint64_t timeout_us, size_t* completed_count = nullptr);
+
+  /// Process the asynchronous requests on the completion queue given in the
+  /// client options without waiting, completing at most 'max_count'
+  /// requests. See Poll() for how the requests are processed.
+  /// \param max_count The maximum number of requests to complete.
+  /// \param completed_count Optional, returns the number of completed
+  /// requests whose callback was run.
+  /// \return Error object indicating success or failure.
+  Error ProcessCompletions(
+      const size_t max_count, size_t* completed_count = nullptr);
+
  private:
+  friend GrpcInferStream;
+
   InferenceServerGrpcClient(
       const std::string& url, bool verbose, bool use_ssl,
       const SslOptions& ssl_options, const grpc::ChannelArguments& channel_args,
-      const bool use_cached_channel);
+      const bool use_cached_channel, const GrpcClientOptions& client_options);
 
+  // Run the inference, the request is taken from 'prepared' if provided,
+  // otherwise it is populated from 'options', 'inputs' and 'outputs'.
+  Error DoInfer(
+      InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      GrpcPreparedInferRequest* prepared, const Headers& headers,
+      grpc_compression_algorithm compression_algorithm);
+  Error DoAsyncInfer(
+      OnCompleteFn callback, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      GrpcPreparedInferRequest* prepared, const Headers& headers,
+      grpc_compression_algorithm compression_algorithm,
+      std::shared_ptr<CancelHandle>* cancel_handle);
+  // Check that 'request' was prepared by this client.
+  Error ValidatePreparedRequest(
+      PreparedInferRequest* request, GrpcPreparedInferRequest** prepared);
+
+  // Serialize 'infer_request' into 'buffer' followed by the data of the
+  // 'inputs' that are not in shared memory, as the raw_input_contents of
+  // the request. The input data is referenced by 'buffer' instead of
+  // copied, so it must not be modified or released until the request is
+  // sent.
+  static Error SerializeInferRequest(
+      const inference::ModelInferRequest& infer_request,
+      const std::vector<InferInput*>& inputs, grpc::ByteBuffer* buffer);
+  // Populate 'infer_request', the input data is copied into the
+  // raw_input_contents only if 'copy_input_data' is true.
   Error PreRunProcessing(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
-      const std::vector<const InferRequestedOutput*>& outputs);
-  void AsyncTransfer();
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const bool copy_input_data, inference::ModelInferRequest* infer_request);
+  // Start the worker threads if they are not started yet, no thread is
+  // started when the application polls the completion queue.
+  void StartAsyncTransfer();
+  // Complete the asynchronous requests of 'completion_queue'.
+  void AsyncTransfer(grpc::CompletionQueue* completion_queue);
+  // Create the result of a completed asynchronous request and run its
+  // callback.
+  void CompleteAsyncRequest(GrpcInferRequest* raw_async_request);
+  // Complete at most 'max_count' requests of the application polled queue,
+  // only the first completion is waited for until 'deadline'. Return the
+  // number of completed requests.
+  size_t ProcessCompletionQueue(
+      const std::chrono::system_clock::time_point& deadline,
+      const size_t max_count);
   void AsyncStreamTransfer();
-
-  // The producer-consumer queue used to communicate asynchronously with
-  // the GRPC runtime.
-  grpc::CompletionQueue async_request_completion_queue_;
+  // Process the operations of the streams created with CreateStream().
+  void AsyncStreamsTransfer();
+  // Pick the channel to send an inference request over, the request is
+  // counted as outstanding on the channel until it is released.
+  GrpcInferChannel* AcquireInferChannel();
+  // Return the compression algorithm of the request serialized into
+  // 'request_buffer' that is called with 'compression_algorithm', which
+  // depends on the decision of 'compression_advisor_' if the adaptive
+  // compression is enabled.
+  grpc_compression_algorithm RequestCompression(
+      const grpc_compression_algorithm compression_algorithm,
+      const grpc::ByteBuffer& request_buffer);
+
+  // The producer-consumer queues used to communicate asynchronously with
+  // the GRPC runtime, each drained by the worker thread at the same index.
+  // The threads are started on the first asynchronous request.
+  std::vector<std::unique_ptr<grpc::CompletionQueue>>
+      async_request_completion_queues_;
+  std::vector<std::thread> async_workers_;
+  std::once_flag workers_started_;
+  // The queue polled by the application instead, used for all asynchronous
+  // requests if set.
+  grpc::CompletionQueue* polled_completion_queue_;
+  // Whether the worker threads spin on their completion queue
+  bool busy_poll_;
+  // index used for distributing requests across the completion queues
+  std::atomic<size_t> next_completion_queue_;
 
   // Required to support the grpc bi-directional streaming API.
   InferenceServerClient::OnCompleteFn stream_callback_;
@@ -559,14 +858,159 @@ class InferenceServerGrpcClient : public InferenceServerClient {
   grpc::ClientContext grpc_context_;
 
   bool enable_stream_stats_;
-  std::queue<std::unique_ptr<RequestTimers>> ongoing_stream_request_timers_;
-  std::mutex stream_mutex_;
+  // Matches the responses with the timers of their request when the stream
+  // stats are enabled.
+  std::unique_ptr<StreamResponseTracker> stream_response_tracker_;
+  // request written to the stream, one request object can be used for
+  // multiple writes since it can be overwritten as soon as the write
+  // finishes. Guarded by 'stream_write_mutex_'.
+  inference::ModelInferRequest stream_infer_request_;
+  std::mutex stream_write_mutex_;
+
+  // The queue of the operations of the streams created with CreateStream(),
+  // drained by a single worker thread that is started with the first stream.
+  grpc::CompletionQueue streams_completion_queue_;
+  std::thread streams_worker_;
+  std::once_flag streams_worker_started_;
 
   // GRPC end point.
   std::shared_ptr<inference::GRPCInferenceService::Stub> stub_;
-  // request for GRPC call, one request object can be used for multiple calls
-  // since it can be overwritten as soon as the GRPC send finishes.
-  inference::ModelInferRequest infer_request_;
+  // The channels for sending inference requests that are serialized by the
+  // client, which references the input data instead of copying it. The
+  // first channel is the one of 'stub_'.
+  std::vector<std::unique_ptr<GrpcInferChannel>> infer_channels_;
+  GrpcClientOptions::ChannelSelection channel_selection_;
+  // index used for distributing requests across the channels in turn
+  std::atomic<size_t> next_infer_channel_;
+  // Whether the compression of the inference requests is decided by
+  // 'compression_advisor_'.
+  bool adaptive_compression_;
+  CompressionAdvisor compression_advisor_;
+  // State of completed requests that can be reused.
+  SharedObjectPool<GrpcInferRequest> request_pool_;
+};
+
+//==============================================================================
+/// A GrpcInferStream is a grpc bi-directional stream created with
+/// InferenceServerGrpcClient::CreateStream(). Unlike the stream of
+/// StartStream(), AsyncStreamInfer() doesn't wait for the request to be
+/// written. The request is queued and the queued requests are written in
+/// order by the worker thread of the client, so a slow server or the flow
+/// control of the stream never blocks the caller. The worker thread serves
+/// all the streams of the client. The methods are thread-safe.
+///
+/// \code
+///   std::unique_ptr<GrpcInferStream> stream;
+///   client->CreateStream(&stream, callback);
+///   stream->AsyncStreamInfer(options, inputs);
+///   ...
+///   stream->Stop();
+/// \endcode
+///
+class GrpcInferStream {
+ public:
+  /// Stops the stream, see Stop().
+  ~GrpcInferStream();
+
+  /// Queue an inference request to be written to the stream. All the results
+  /// will be provided to the callback function provided when creating the
+  /// stream.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how the
+  /// output must be returned. If not provided then all the outputs in the model
+  /// config will be returned as default settings.
+  /// \return Error object indicating success or failure of the request. The
+  /// request is rejected if the stream is closed or if the write queue of the
+  /// stream is full, see PendingWriteCount().
+  Error AsyncStreamInfer(
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Get the number of requests queued on the stream that are not written
+  /// yet. A producer can use it to slow down before the write queue is full.
+  /// \return The number of queued requests.
+  size_t PendingWriteCount() const;
+
+  /// Close the stream once the queued requests are written and wait for the
+  /// responses of the requests. No request can be queued afterwards. Must
+  /// not be called from the callback of a stream of the same client.
+  /// \return Error object indicating success or failure of the stream.
+  Error Stop();
+
+ private:
+  friend InferenceServerGrpcClient;
+
+  // The operations of the stream, the address of the tag of an operation is
+  // the completion queue tag of the operation.
+  enum class Op { START, READ, WRITE, WRITES_DONE, FINISH };
+  struct Tag {
+    GrpcInferStream* stream;
+    Op op;
+  };
+
+  GrpcInferStream(
+      InferenceServerGrpcClient* client,
+      InferenceServerClient::OnCompleteFn callback,
+      const GrpcStreamOptions& stream_options);
+
+  // Start the call of the stream on 'completion_queue'.
+  void Start(
+      inference::GRPCInferenceService::Stub* stub,
+      grpc::CompletionQueue* completion_queue);
+  // Handle the completion of operation 'op'.
+  void Process(Op op, bool ok);
+  // Write the next queued request, or close the writes once the stream is
+  // stopped and all the requests are written. Must be called with 'mutex_'
+  // held.
+  void WriteNext();
+  // Stop writing to the stream once it failed or ended, the queued requests
+  // that are not being written are dropped. Must be called with 'mutex_'
+  // held.
+  void Close();
+
+  InferenceServerGrpcClient* client_;
+  InferenceServerClient::OnCompleteFn callback_;
+  std::function<void(const ResponseTimeline&)> timeline_callback_;
+  const bool enable_stats_;
+  const size_t max_pending_writes_;
+
+  grpc::ClientContext grpc_context_;
+  std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<
+      inference::ModelInferRequest, inference::ModelStreamInferResponse>>
+      grpc_stream_;
+  Tag start_tag_;
+  Tag read_tag_;
+  Tag write_tag_;
+  Tag writes_done_tag_;
+  Tag finish_tag_;
+  // The response being read, only accessed by the worker thread
+  std::shared_ptr<inference::ModelStreamInferResponse> response_;
+  grpc::Status grpc_status_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // The requests to be written, the front request is being written if a
+  // write is outstanding.
+  std::deque<std::unique_ptr<inference::ModelInferRequest>> pending_writes_;
+  // Written requests that can be reused.
+  std::vector<std::unique_ptr<inference::ModelInferRequest>> free_requests_;
+  // Matches the responses with the timers and the timeline of their request
+  std::unique_ptr<StreamResponseTracker> response_tracker_;
+  bool started_;
+  // Whether a write, or the close of the writes, is outstanding
+  bool writing_;
+  // Whether Stop() is called, or the stream failed, and no request can be
+  // queued.
+  bool closed_;
+  // Whether no more write is issued to the stream
+  bool writes_done_;
+  // Whether the last read completed, the call is finished once no write is
+  // outstanding either.
+  bool read_done_;
+  bool finishing_;
+  bool finished_;
 };
 
 
@@ -0,0 +1,462 @@
+// Copyright 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+/// \file
+/// Hedged inference over the AsyncInfer() of InferenceServerHttpClient and
+/// InferenceServerGrpcClient, to cut the tail latency of the requests: a
+/// request that hasn't completed after a delay is sent again to another
+/// endpoint, and the first response is used.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "common.h"
+
+namespace triton { namespace client {
+
+//==============================================================================
+/// The options of HedgedInferClient.
+///
+struct HedgingOptions {
+  HedgingOptions()
+      : delay_us(10000), adaptive_delay(false), delay_percentile(95),
+        min_sample_count(100)
+  {
+  }
+
+  /// The time in microseconds after which a request without response is
+  /// sent again to the next endpoint.
+  uint64_t delay_us;
+
+  /// Whether to use the 'delay_percentile' of the latencies of the
+  /// completed requests as the delay, which then follows the load of the
+  /// endpoints. 'delay_us' is used until 'min_sample_count' requests are
+  /// completed.
+  bool adaptive_delay;
+  double delay_percentile;
+  uint64_t min_sample_count;
+};
+
+//==============================================================================
+/// Statistics of HedgedInferClient. The hedge rate is
+/// 'hedged_request_count' over 'request_count', and the win rate is
+/// 'hedge_win_count' over 'hedged_request_count'.
+///
+struct HedgingStat {
+  /// Number of requests sent.
+  size_t request_count;
+
+  /// Number of requests sent again to another endpoint.
+  size_t hedged_request_count;
+
+  /// Number of hedged requests that were completed first by the request
+  /// sent to the other endpoint.
+  size_t hedge_win_count;
+
+  /// The current delay before a request is hedged, in microseconds.
+  uint64_t hedge_delay_us;
+
+  /// The distribution of the time from sending the requests until the
+  /// first response, which the adaptive delay is taken from.
+  LatencyHistogram latency_histogram;
+
+  /// Create a new HedgingStat object with zero-ed statistics.
+  HedgingStat()
+      : request_count(0), hedged_request_count(0), hedge_win_count(0),
+        hedge_delay_us(0)
+  {
+  }
+};
+
+//==============================================================================
+/// A HedgedInferClient sends the asynchronous inference requests over
+/// several clients of InferenceServerHttpClient or
+/// InferenceServerGrpcClient, usually connected to different endpoints
+/// serving the same model. Each request goes to the next client in turn,
+/// and is sent again to the client after it if the request hasn't
+/// completed after the hedging delay. The first result is the result of
+/// the request, and the other request is cancelled with its CancelHandle,
+/// its result is discarded. The callback of the request is invoked once
+/// both requests are completed, so that the inputs are no longer used by
+/// either client when the callback releases them.
+///
+/// The requests are hedged from an internal thread. The clients are not
+/// owned and must outlive the requests sent through the HedgedInferClient.
+///
+template <typename Client>
+class HedgedInferClient {
+ public:
+  /// Create a hedged client over the given clients.
+  /// \param client Returns a new HedgedInferClient object.
+  /// \param clients The clients to send the requests with, at least one.
+  /// A request is hedged with the same client if there is only one.
+  /// \param options The hedging options.
+  /// \return Error object indicating success or failure.
+  static Error Create(
+      std::unique_ptr<HedgedInferClient>* client,
+      const std::vector<Client*>& clients,
+      const HedgingOptions& options = HedgingOptions())
+  {
+    if (clients.empty()) {
+      return Error("at least one client must be provided for hedging");
+    }
+    if (options.adaptive_delay &&
+        ((options.delay_percentile <= 0) || (options.delay_percentile > 100))) {
+      return Error("hedging delay percentile must be in (0, 100]");
+    }
+    client->reset(new HedgedInferClient(clients, options));
+    return Error::Success;
+  }
+
+  ~HedgedInferClient()
+  {
+    {
+      std::lock_guard<std::mutex> lk(timer_mutex_);
+      exiting_ = true;
+    }
+    timer_cv_.notify_all();
+    timer_thread_.join();
+  }
+
+  HedgedInferClient(const HedgedInferClient&) = delete;
+  HedgedInferClient& operator=(const HedgedInferClient&) = delete;
+
+  /// Run asynchronous inference on server with hedging. The inputs and
+  /// outputs must stay valid until the callback is invoked, as for the
+  /// AsyncInfer() of the clients. The callback is invoked only after the
+  /// cancelled request of a hedged request is completed as well, so the
+  /// inputs may be released from the callback.
+  /// \param callback The callback function to be invoked with the first
+  /// result of the request once the request and its hedged request, if
+  /// any, are both completed, see the AsyncInfer() of the clients.
+  /// \param options The options for the inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs Optional vector of InferRequestedOutput describing how
+  /// the outputs must be returned. The outputs must not have a buffer set
+  /// with InferRequestedOutput::SetBuffer(), since the original and the
+  /// hedged request would both write into it.
+  /// \param args The optional trailing arguments of the AsyncInfer() of
+  /// the clients, such as the headers.
+  /// \return Error object indicating success or failure of the request.
+  template <typename... Args>
+  Error AsyncInfer(
+      InferenceServerClient::OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Args&... args)
+  {
+    for (const auto output : outputs) {
+      if (output->HasBuffer()) {
+        return Error(
+            "output '" + output->Name() +
+            "' has a buffer set, which is not supported with hedging");
+      }
+    }
+
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->callback = callback;
+    call->send = [options, inputs, outputs, args...](
+                     Client* client,
+                     std::shared_ptr<CancelHandle>* cancel_handle,
+                     InferenceServerClient::OnCompleteFn on_complete) {
+      return client->AsyncInfer(
+          cancel_handle, on_complete, options, inputs, outputs, args...);
+    };
+    call->endpoint = next_endpoint_++ % clients_.size();
+    call->start_time = std::chrono::steady_clock::now();
+    call->pending_count = 1;
+
+    std::shared_ptr<State> state = state_;
+    std::shared_ptr<CancelHandle> cancel_handle;
+    Error err = call->send(
+        clients_[call->endpoint], &cancel_handle,
+        [call, state](InferResult* result) {
+          Complete(call, state, false /* hedge */, result);
+        });
+    if (!err.IsOk()) {
+      return err;
+    }
+
+    uint64_t delay_us;
+    {
+      std::lock_guard<std::mutex> lk(state_->mutex);
+      ++state_->stat.request_count;
+      delay_us = HedgeDelayUs();
+    }
+    {
+      std::lock_guard<std::mutex> lk(call->mutex);
+      if (call->completed) {
+        return Error::Success;
+      }
+      call->cancel_handles[0] = cancel_handle;
+    }
+
+    const auto deadline =
+        call->start_time + std::chrono::microseconds(delay_us);
+    bool earliest;
+    {
+      std::lock_guard<std::mutex> lk(timer_mutex_);
+      earliest = timers_.empty() || (deadline < timers_.top().deadline);
+      timers_.push(Timer{deadline, call});
+    }
+    if (earliest) {
+      timer_cv_.notify_one();
+    }
+    return Error::Success;
+  }
+
+  /// Get the hedging statistics of the client.
+  /// \param stat Returns the HedgingStat object holding the statistics.
+  /// \return Error object indicating success or failure.
+  Error ClientHedgingStat(HedgingStat* stat) const
+  {
+    std::lock_guard<std::mutex> lk(state_->mutex);
+    *stat = state_->stat;
+    return Error::Success;
+  }
+
+ private:
+  using SendFn = std::function<Error(
+      Client*, std::shared_ptr<CancelHandle>*,
+      InferenceServerClient::OnCompleteFn)>;
+
+  // The state of a request sent through the hedged client, shared by the
+  // callbacks of the original and the hedged request.
+  struct Call {
+    Call()
+        : endpoint(0), hedged(false), completed(false), pending_count(0),
+          result(nullptr)
+    {
+    }
+
+    InferenceServerClient::OnCompleteFn callback;
+    SendFn send;
+    size_t endpoint;
+    std::chrono::steady_clock::time_point start_time;
+
+    std::mutex mutex;
+    // The cancel handles of the original and the hedged request.
+    std::shared_ptr<CancelHandle> cancel_handles[2];
+    bool hedged;
+    bool completed;
+    // The number of requests sent whose callback is not invoked yet, the
+    // callback of the call is invoked with 'result' once it reaches 0.
+    size_t pending_count;
+    InferResult* result;
+  };
+
+  // The statistics, shared with the callbacks as the requests may complete
+  // after the hedged client is destroyed.
+  struct State {
+    std::mutex mutex;
+    HedgingStat stat;
+    std::chrono::steady_clock::time_point delay_update_time;
+  };
+
+  struct Timer {
+    std::chrono::steady_clock::time_point deadline;
+    std::shared_ptr<Call> call;
+
+    bool operator>(const Timer& other) const
+    {
+      return deadline > other.deadline;
+    }
+  };
+
+  HedgedInferClient(
+      const std::vector<Client*>& clients, const HedgingOptions& options)
+      : clients_(clients), options_(options), state_(new State()),
+        next_endpoint_(0), exiting_(false)
+  {
+    state_->stat.hedge_delay_us = options_.delay_us;
+    timer_thread_ = std::thread(&HedgedInferClient::HedgeRequests, this);
+  }
+
+  static void Complete(
+      const std::shared_ptr<Call>& call, const std::shared_ptr<State>& state,
+      const bool hedge, InferResult* result)
+  {
+    std::shared_ptr<CancelHandle> other;
+    bool first;
+    bool last;
+    {
+      std::lock_guard<std::mutex> lk(call->mutex);
+      last = (--call->pending_count == 0);
+      first = !call->completed;
+      if (first) {
+        call->completed = true;
+        call->result = result;
+        other = call->cancel_handles[hedge ? 0 : 1];
+      }
+    }
+    if (!first) {
+      // The other request completed first and waited for this one to be
+      // done with the inputs.
+      delete result;
+      if (last) {
+        call->callback(call->result);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lk(state->mutex);
+      state->stat.latency_histogram.Record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - call->start_time)
+              .count());
+      if (hedge) {
+        ++state->stat.hedge_win_count;
+      }
+    }
+    if (last) {
+      call->callback(result);
+      return;
+    }
+    // A handle not set yet is cancelled by whoever sets it. The callback
+    // is invoked once the cancelled request is completed.
+    if (other != nullptr) {
+      other->Cancel();
+    }
+  }
+
+  // Must be called with the mutex of the state held.
+  uint64_t HedgeDelayUs()
+  {
+    HedgingStat& stat = state_->stat;
+    if (!options_.adaptive_delay) {
+      return stat.hedge_delay_us;
+    }
+    // The percentile is taken again at most every 100 ms.
+    const auto now = std::chrono::steady_clock::now();
+    if ((now - state_->delay_update_time) >= std::chrono::milliseconds(100)) {
+      state_->delay_update_time = now;
+      if (stat.latency_histogram.Count() >= options_.min_sample_count) {
+        stat.hedge_delay_us =
+            stat.latency_histogram.Percentile(options_.delay_percentile) /
+            1000;
+      }
+    }
+    return stat.hedge_delay_us;
+  }
+
+  void HedgeRequests()
+  {
+    std::unique_lock<std::mutex> lk(timer_mutex_);
+    while (!exiting_) {
+      if (timers_.empty()) {
+        timer_cv_.wait(lk);
+        continue;
+      }
+      const auto deadline = timers_.top().deadline;
+      if (std::chrono::steady_clock::now() < deadline) {
+        timer_cv_.wait_until(lk, deadline);
+        continue;
+      }
+      std::shared_ptr<Call> call = timers_.top().call;
+      timers_.pop();
+      lk.unlock();
+      Hedge(call);
+      lk.lock();
+    }
+  }
+
+  void Hedge(const std::shared_ptr<Call>& call)
+  {
+    {
+      std::lock_guard<std::mutex> lk(call->mutex);
+      if (call->completed || call->hedged) {
+        return;
+      }
+      call->hedged = true;
+      ++call->pending_count;
+    }
+    // Counted before sending so that the win of the hedged request is never
+    // counted ahead of it.
+    {
+      std::lock_guard<std::mutex> lk(state_->mutex);
+      ++state_->stat.hedged_request_count;
+    }
+
+    std::shared_ptr<State> state = state_;
+    std::shared_ptr<CancelHandle> cancel_handle;
+    Error err = call->send(
+        clients_[(call->endpoint + 1) % clients_.size()], &cancel_handle,
+        [call, state](InferResult* result) {
+          Complete(call, state, true /* hedge */, result);
+        });
+    if (!err.IsOk()) {
+      {
+        std::lock_guard<std::mutex> lk(state_->mutex);
+        --state_->stat.hedged_request_count;
+      }
+      // The original request may have completed meanwhile and be waiting
+      // for the hedged request.
+      bool last;
+      {
+        std::lock_guard<std::mutex> lk(call->mutex);
+        last = (--call->pending_count == 0);
+      }
+      if (last) {
+        call->callback(call->result);
+      }
+      return;
+    }
+
+    bool completed;
+    {
+      std::lock_guard<std::mutex> lk(call->mutex);
+      completed = call->completed;
+      call->cancel_handles[1] = cancel_handle;
+    }
+    // No effect if the hedged request is the one that completed.
+    if (completed) {
+      cancel_handle->Cancel();
+    }
+  }
+
+  const std::vector<Client*> clients_;
+  const HedgingOptions options_;
+  std::shared_ptr<State> state_;
+  std::atomic<size_t> next_endpoint_;
+
+  // The requests to hedge, by deadline.
+  std::mutex timer_mutex_;
+  std::condition_variable timer_cv_;
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>>
+      timers_;
+  bool exiting_;
+  std::thread timer_thread_;
+};
+
+}}  // namespace triton::client
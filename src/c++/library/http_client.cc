@@ -33,10 +33,19 @@
 #include <atomic>
 #include <climits>
 #include <cstdint>
+#include <cstdio>
 #include <deque>
 #include <iostream>
 #include "http_client.h"
 
+#ifdef TRITON_ENABLE_ZSTD
+#include <zstd.h>
+#endif  // TRITON_ENABLE_ZSTD
+
+#ifdef TRITON_ENABLE_LZ4
+#include <lz4frame.h>
+#endif  // TRITON_ENABLE_LZ4
+
 extern "C" {
 #include "cencode.h"
 }
@@ -53,9 +62,84 @@ extern "C" {
 
 namespace triton { namespace client {
 
+//==============================================================================
+
+// Worker threads compressing the chunks of a request body in parallel.
+class HttpCompressionPool {
+ public:
+  explicit HttpCompressionPool(const size_t thread_count);
+  ~HttpCompressionPool();
+
+  // Run 'task' on a worker thread, without waiting for it to complete.
+  void Submit(std::function<void()> task);
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool exiting_;
+  std::vector<std::thread> workers_;
+};
+
+HttpCompressionPool::HttpCompressionPool(const size_t thread_count)
+    : exiting_(false)
+{
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_.emplace_back(&HttpCompressionPool::Work, this);
+  }
+}
+
+HttpCompressionPool::~HttpCompressionPool()
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void
+HttpCompressionPool::Submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void
+HttpCompressionPool::Work()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk, [this] { return exiting_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
 namespace {
 
 constexpr char kContentLengthHTTPHeader[] = "Content-Length";
+// The size of the deflate sliding window, which is the most input preceding
+// a chunk that can be referenced by the chunk.
+constexpr size_t kDeflateWindowByteSize = 32 * 1024;
+// The largest response buffer capacity kept by a pooled request for the
+// next response, larger buffers are released.
+constexpr size_t kMaxRetainedResponseByteSize = 1024 * 1024;
 
 //==============================================================================
 
@@ -133,41 +217,91 @@ Base64Encode(
   *encoded_size += padding_size;
 }
 
-// libcurl provides automatic decompression, so only implement compression
+// Collect the contiguous pieces holding the bytes in [begin, end) of the
+// buffers in 'source'.
+void
+GetSpans(
+    const std::deque<std::pair<uint8_t*, size_t>>& source, const size_t begin,
+    const size_t end, std::vector<std::pair<uint8_t*, size_t>>* spans)
+{
+  size_t offset = 0;
+  for (const auto& buffer : source) {
+    const size_t buffer_end = offset + buffer.second;
+    if ((buffer_end > begin) && (offset < end)) {
+      const size_t span_begin = std::max(begin, offset);
+      const size_t span_end = std::min(end, buffer_end);
+      spans->emplace_back(
+          buffer.first + (span_begin - offset), span_end - span_begin);
+    }
+    if (buffer_end >= end) {
+      break;
+    }
+    offset = buffer_end;
+  }
+}
+
+// Run deflate() over 'spans' with 'flush' applied to the last span, and
+// append the output to 'compressed_data' in buffers of 'buffer_byte_size'.
 Error
-CompressData(
-    const InferenceServerHttpClient::CompressionType type,
-    const std::deque<std::pair<uint8_t*, size_t>>& source,
-    const size_t source_byte_size,
+RunDeflate(
+    z_stream* stream, const std::vector<std::pair<uint8_t*, size_t>>& spans,
+    const int flush, const size_t buffer_byte_size,
     std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
 {
-  // nothing to be compressed
-  if (source_byte_size == 0) {
-    return Error("nothing to be compressed");
+  std::unique_ptr<char[]> current_reserved_space(new char[buffer_byte_size]);
+  stream->next_out =
+      reinterpret_cast<unsigned char*>(current_reserved_space.get());
+  stream->avail_out = buffer_byte_size;
+
+  // Compress until end of 'spans'
+  for (size_t i = 0; i < spans.size(); ++i) {
+    stream->next_in = reinterpret_cast<unsigned char*>(spans[i].first);
+    stream->avail_in = spans[i].second;
+
+    // run deflate() on input until source has been read in
+    do {
+      // Need additional buffer
+      if (stream->avail_out == 0) {
+        compressed_data->emplace_back(
+            std::move(current_reserved_space), buffer_byte_size);
+        current_reserved_space.reset(new char[buffer_byte_size]);
+        stream->next_out =
+            reinterpret_cast<unsigned char*>(current_reserved_space.get());
+        stream->avail_out = buffer_byte_size;
+      }
+      auto span_flush = ((i + 1) == spans.size()) ? flush : Z_NO_FLUSH;
+      auto ret = deflate(stream, span_flush);
+      if (ret == Z_STREAM_ERROR) {
+        return Error(
+            "encountered inconsistent stream state during compression");
+      }
+    } while (stream->avail_out == 0);
   }
+  // Make sure the last buffer is committed
+  compressed_data->emplace_back(
+      std::move(current_reserved_space), buffer_byte_size - stream->avail_out);
+  return Error::Success;
+}
 
+Error
+ZlibCompress(
+    const InferenceServerHttpClient::CompressionType type, const int level,
+    const std::vector<std::pair<uint8_t*, size_t>>& spans,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
   z_stream stream;
   stream.zalloc = Z_NULL;
   stream.zfree = Z_NULL;
   stream.opaque = Z_NULL;
-  switch (type) {
-    case InferenceServerHttpClient::CompressionType::GZIP:
-      if (deflateInit2(
-              &stream, Z_DEFAULT_COMPRESSION /* level */,
-              Z_DEFLATED /* method */, 15 | 16 /* windowBits */,
-              8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
-        return Error("failed to initialize state for gzip data compression");
-      }
-      break;
-    case InferenceServerHttpClient::CompressionType::DEFLATE: {
-      if (deflateInit(&stream, Z_DEFAULT_COMPRESSION /* level */) != Z_OK) {
-        return Error("failed to initialize state for deflate data compression");
-      }
-      break;
+  if (type == InferenceServerHttpClient::CompressionType::GZIP) {
+    if (deflateInit2(
+            &stream, level, Z_DEFLATED /* method */, 15 | 16 /* windowBits */,
+            8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
+      return Error("failed to initialize state for gzip data compression");
     }
-    case InferenceServerHttpClient::CompressionType::NONE:
-      return Error("can't compress data with NONE type");
-      break;
+  } else if (deflateInit(&stream, level) != Z_OK) {
+    return Error("failed to initialize state for deflate data compression");
   }
   // ensure the internal state are cleaned up on function return
   std::unique_ptr<z_stream, decltype(&deflateEnd)> managed_stream(
@@ -175,42 +309,495 @@ CompressData(
 
   // Reserve the same size as source for compressed data, it is less likely
   // that a negative compression happens.
-  std::unique_ptr<char[]> current_reserved_space(new char[source_byte_size]);
-  stream.next_out =
-      reinterpret_cast<unsigned char*>(current_reserved_space.get());
-  stream.avail_out = source_byte_size;
+  return RunDeflate(
+      &stream, spans, Z_FINISH, source_byte_size, compressed_data);
+}
+
+// Deflate the bytes in [begin, end) of 'source' as raw deflate data that
+// continues the deflate stream of the preceding bytes. The preceding window
+// is set as the dictionary so that the chunk can still reference it, and a
+// chunk that is not the last ends with a sync flush on a byte boundary so
+// the outputs of consecutive chunks can be concatenated. 'crc' returns the
+// CRC-32 of the chunk.
+Error
+DeflateChunk(
+    const int level, const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t begin, const size_t end, const bool last, uLong* crc,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  if (deflateInit2(
+          &stream, level, Z_DEFLATED /* method */, -15 /* windowBits */,
+          8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */) != Z_OK) {
+    return Error("failed to initialize state for gzip data compression");
+  }
+  std::unique_ptr<z_stream, decltype(&deflateEnd)> managed_stream(
+      &stream, deflateEnd);
 
-  // Compress until end of 'source'
-  for (auto it = source.begin(); it != source.end(); ++it) {
-    stream.next_in = reinterpret_cast<unsigned char*>(it->first);
-    stream.avail_in = it->second;
+  std::vector<std::pair<uint8_t*, size_t>> spans;
+  if (begin > 0) {
+    const size_t dictionary_begin =
+        (begin > kDeflateWindowByteSize) ? (begin - kDeflateWindowByteSize)
+                                         : 0;
+    GetSpans(source, dictionary_begin, begin, &spans);
+    std::vector<Bytef> dictionary;
+    dictionary.reserve(begin - dictionary_begin);
+    for (const auto& span : spans) {
+      dictionary.insert(
+          dictionary.end(), span.first, span.first + span.second);
+    }
+    if (deflateSetDictionary(
+            &stream, dictionary.data(), dictionary.size()) != Z_OK) {
+      return Error("failed to set dictionary for gzip data compression");
+    }
+    spans.clear();
+  }
 
-    // run deflate() on input until source has been read in
-    do {
+  GetSpans(source, begin, end, &spans);
+  *crc = crc32(0L, Z_NULL, 0);
+  for (const auto& span : spans) {
+    *crc = crc32(*crc, span.first, span.second);
+  }
+  return RunDeflate(
+      &stream, spans, last ? Z_FINISH : Z_SYNC_FLUSH, end - begin,
+      compressed_data);
+}
+
+// The gzip member of a request body whose chunks of 'chunk_byte_size' bytes
+// are deflated in parallel on the compression pool. The compressed data can
+// be read as soon as the chunks preceding it are deflated, so the body can be
+// sent while the chunks that follow it are still being deflated.
+class ParallelGzipStream {
+ public:
+  ParallelGzipStream(
+      const int level, const size_t chunk_byte_size,
+      const std::deque<std::pair<uint8_t*, size_t>>& source,
+      const size_t source_byte_size);
+
+  // Deflate the chunks of 'stream' on 'pool', the tasks keep 'stream' alive
+  // until they are completed.
+  static void Start(
+      const std::shared_ptr<ParallelGzipStream>& stream,
+      HttpCompressionPool* pool);
+
+  // Set the function invoked on a worker thread after each chunk is
+  // deflated.
+  void SetChunkCallback(std::function<void()> callback);
+
+  // Copy into 'buf' up to 'size' bytes of the compressed data and return the
+  // actual amount copied in 'read_bytes'. If the next chunk is not deflated
+  // yet the call waits for it, unless a chunk callback is set in which case
+  // 'pending' returns true and the read can be retried once the callback is
+  // invoked.
+  Error Read(uint8_t* buf, size_t size, size_t* read_bytes, bool* pending);
+
+  // Whether all of the compressed data has been read.
+  bool Done() const { return (next_chunk_ > chunks_.size()); }
+
+  // Wait for all the chunks to be deflated and append the compressed data to
+  // 'compressed_data', can't be combined with Read().
+  Error Collect(
+      std::vector<std::pair<std::unique_ptr<char[]>, size_t>>*
+          compressed_data);
+
+  // Skip the chunks that are not started and wait for the others, the source
+  // is no longer accessed once the call returns.
+  void Stop();
+
+ private:
+  struct Chunk {
+    Chunk() : crc(0), done(false) {}
+    Error error;
+    uLong crc;
+    bool done;
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>> data;
+  };
+
+  void Deflate(const size_t index);
+  // The size of the uncompressed data of the chunk at 'index'.
+  size_t ChunkSourceByteSize(const size_t index) const
+  {
+    return std::min(
+        chunk_byte_size_, source_byte_size_ - (index * chunk_byte_size_));
+  }
+  // Write the gzip trailer once the CRC-32 of all chunks is combined.
+  void WriteTrailer();
+
+  const int level_;
+  const size_t chunk_byte_size_;
+  const std::deque<std::pair<uint8_t*, size_t>> source_;
+  const size_t source_byte_size_;
+
+  // Protects the state shared with the worker threads, which is the
+  // completion of each chunk, 'running_count_' and 'stopped_'.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Chunk> chunks_;
+  size_t running_count_;
+  bool stopped_;
+  std::function<void()> chunk_callback_;
+
+  // The state of the reader. 'next_chunk_' is the next chunk to be appended
+  // to 'segments_', the trailer is appended after the last chunk.
+  std::deque<std::pair<const char*, size_t>> segments_;
+  size_t next_chunk_;
+  uLong crc_;
+  char trailer_[8];
+};
+
+// gzip header with no optional fields and unknown operating system
+constexpr char kGzipHeader[] = {'\x1f', '\x8b', Z_DEFLATED, 0, 0,
+                                0,      0,      0,          0, '\xff'};
+
+ParallelGzipStream::ParallelGzipStream(
+    const int level, const size_t chunk_byte_size,
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size)
+    : level_(level), chunk_byte_size_(chunk_byte_size), source_(source),
+      source_byte_size_(source_byte_size),
+      chunks_((source_byte_size + chunk_byte_size - 1) / chunk_byte_size),
+      running_count_(0), stopped_(false), next_chunk_(0),
+      crc_(crc32(0L, Z_NULL, 0))
+{
+  segments_.emplace_back(kGzipHeader, sizeof(kGzipHeader));
+}
+
+void
+ParallelGzipStream::Start(
+    const std::shared_ptr<ParallelGzipStream>& stream,
+    HttpCompressionPool* pool)
+{
+  for (size_t i = 0; i < stream->chunks_.size(); ++i) {
+    pool->Submit([stream, i] { stream->Deflate(i); });
+  }
+}
+
+void
+ParallelGzipStream::SetChunkCallback(std::function<void()> callback)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  chunk_callback_ = std::move(callback);
+}
+
+void
+ParallelGzipStream::Deflate(const size_t index)
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (stopped_) {
+      return;
+    }
+    ++running_count_;
+  }
+
+  // Only this task accesses the chunk until it is marked as done
+  Chunk& chunk = chunks_[index];
+  const size_t begin = index * chunk_byte_size_;
+  const size_t end = begin + ChunkSourceByteSize(index);
+  chunk.error = DeflateChunk(
+      level_, source_, begin, end, (end == source_byte_size_), &chunk.crc,
+      &chunk.data);
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  chunk.done = true;
+  --running_count_;
+  cv_.notify_all();
+  if (chunk_callback_ != nullptr) {
+    chunk_callback_();
+  }
+}
+
+Error
+ParallelGzipStream::Read(
+    uint8_t* buf, size_t size, size_t* read_bytes, bool* pending)
+{
+  *read_bytes = 0;
+  *pending = false;
+  while (size > 0) {
+    if (segments_.empty()) {
+      if (Done()) {
+        break;
+      }
+      if (next_chunk_ == chunks_.size()) {
+        WriteTrailer();
+        segments_.emplace_back(trailer_, sizeof(trailer_));
+        ++next_chunk_;
+        continue;
+      }
+
+      {
+        std::unique_lock<std::mutex> lk(mutex_);
+        if (!chunks_[next_chunk_].done) {
+          // Hand over the data copied so far instead of waiting
+          if (*read_bytes > 0) {
+            break;
+          }
+          if (chunk_callback_ != nullptr) {
+            *pending = true;
+            break;
+          }
+          cv_.wait(lk, [this] { return chunks_[next_chunk_].done; });
+        }
+      }
+      const Chunk& chunk = chunks_[next_chunk_];
+      if (!chunk.error.IsOk()) {
+        return chunk.error;
+      }
+      crc_ = crc32_combine(crc_, chunk.crc, ChunkSourceByteSize(next_chunk_));
+      for (const auto& data : chunk.data) {
+        segments_.emplace_back(data.first.get(), data.second);
+      }
+      ++next_chunk_;
+      continue;
+    }
+
+    auto& segment = segments_.front();
+    const size_t csz = std::min(segment.second, size);
+    std::copy(segment.first, segment.first + csz, buf);
+    buf += csz;
+    size -= csz;
+    *read_bytes += csz;
+    segment.first += csz;
+    segment.second -= csz;
+    if (segment.second == 0) {
+      segments_.pop_front();
+    }
+  }
+  return Error::Success;
+}
+
+Error
+ParallelGzipStream::Collect(
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    cv_.wait(lk, [this] {
+      for (const auto& chunk : chunks_) {
+        if (!chunk.done) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+  for (const auto& chunk : chunks_) {
+    if (!chunk.error.IsOk()) {
+      return chunk.error;
+    }
+  }
+
+  std::unique_ptr<char[]> header(new char[sizeof(kGzipHeader)]);
+  std::copy(kGzipHeader, kGzipHeader + sizeof(kGzipHeader), header.get());
+  compressed_data->emplace_back(std::move(header), sizeof(kGzipHeader));
+  for (; next_chunk_ < chunks_.size(); ++next_chunk_) {
+    Chunk& chunk = chunks_[next_chunk_];
+    crc_ = crc32_combine(crc_, chunk.crc, ChunkSourceByteSize(next_chunk_));
+    for (auto& data : chunk.data) {
+      compressed_data->emplace_back(std::move(data));
+    }
+  }
+  WriteTrailer();
+  std::unique_ptr<char[]> trailer(new char[sizeof(trailer_)]);
+  std::copy(trailer_, trailer_ + sizeof(trailer_), trailer.get());
+  compressed_data->emplace_back(std::move(trailer), sizeof(trailer_));
+  ++next_chunk_;
+  return Error::Success;
+}
+
+void
+ParallelGzipStream::Stop()
+{
+  std::unique_lock<std::mutex> lk(mutex_);
+  stopped_ = true;
+  cv_.wait(lk, [this] { return (running_count_ == 0); });
+}
+
+void
+ParallelGzipStream::WriteTrailer()
+{
+  // gzip trailer holding the CRC-32 and the size modulo 2^32 of the
+  // uncompressed data, both in little endian
+  const uint64_t isize = source_byte_size_;
+  for (size_t i = 0; i < 4; ++i) {
+    trailer_[i] = static_cast<char>((crc_ >> (8 * i)) & 0xff);
+    trailer_[i + 4] = static_cast<char>((isize >> (8 * i)) & 0xff);
+  }
+}
+
+// Compress 'source' into a single gzip member with the chunks of
+// 'chunk_byte_size' bytes deflated in parallel on 'pool'.
+Error
+ParallelGzipCompress(
+    const int level, HttpCompressionPool* pool, const size_t chunk_byte_size,
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  std::shared_ptr<ParallelGzipStream> stream(new ParallelGzipStream(
+      level, chunk_byte_size, source, source_byte_size));
+  ParallelGzipStream::Start(stream, pool);
+  return stream->Collect(compressed_data);
+}
+
+#ifdef TRITON_ENABLE_ZSTD
+Error
+ZstdCompress(
+    const int level, const std::vector<std::pair<uint8_t*, size_t>>& spans,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  if (context == nullptr) {
+    return Error("failed to initialize state for zstd data compression");
+  }
+  size_t ret = ZSTD_CCtx_setParameter(
+      context.get(), ZSTD_c_compressionLevel,
+      (level == -1) ? ZSTD_CLEVEL_DEFAULT : level);
+  if (!ZSTD_isError(ret)) {
+    ret = ZSTD_CCtx_setPledgedSrcSize(context.get(), source_byte_size);
+  }
+  if (ZSTD_isError(ret)) {
+    return Error(
+        "failed to initialize state for zstd data compression: " +
+        std::string(ZSTD_getErrorName(ret)));
+  }
+
+  const size_t buffer_byte_size = ZSTD_compressBound(source_byte_size);
+  std::unique_ptr<char[]> current_reserved_space(new char[buffer_byte_size]);
+  ZSTD_outBuffer output{current_reserved_space.get(), buffer_byte_size, 0};
+  for (size_t i = 0; i < spans.size(); ++i) {
+    const ZSTD_EndDirective mode =
+        ((i + 1) == spans.size()) ? ZSTD_e_end : ZSTD_e_continue;
+    ZSTD_inBuffer input{spans[i].first, spans[i].second, 0};
+    bool done = false;
+    while (!done) {
       // Need additional buffer
-      if (stream.avail_out == 0) {
+      if (output.pos == output.size) {
         compressed_data->emplace_back(
-            std::move(current_reserved_space), source_byte_size);
-        current_reserved_space.reset(new char[source_byte_size]);
-        stream.next_out =
-            reinterpret_cast<unsigned char*>(current_reserved_space.get());
-        stream.avail_out = source_byte_size;
+            std::move(current_reserved_space), output.pos);
+        current_reserved_space.reset(new char[buffer_byte_size]);
+        output = {current_reserved_space.get(), buffer_byte_size, 0};
       }
-      auto flush = (std::next(it) == source.end()) ? Z_FINISH : Z_NO_FLUSH;
-      auto ret = deflate(&stream, flush);
-      if (ret == Z_STREAM_ERROR) {
+      ret = ZSTD_compressStream2(context.get(), &output, &input, mode);
+      if (ZSTD_isError(ret)) {
         return Error(
-            "encountered inconsistent stream state during compression");
+            "failed to compress data with zstd: " +
+            std::string(ZSTD_getErrorName(ret)));
       }
-    } while (stream.avail_out == 0);
+      done = (mode == ZSTD_e_end) ? (ret == 0) : (input.pos == input.size);
+    }
   }
   // Make sure the last buffer is committed
-  if (current_reserved_space != nullptr) {
-    compressed_data->emplace_back(
-        std::move(current_reserved_space), source_byte_size - stream.avail_out);
+  compressed_data->emplace_back(std::move(current_reserved_space), output.pos);
+  return Error::Success;
+}
+#endif  // TRITON_ENABLE_ZSTD
+
+#ifdef TRITON_ENABLE_LZ4
+Error
+Lz4Compress(
+    const int level, const std::vector<std::pair<uint8_t*, size_t>>& spans,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  LZ4F_cctx* raw_context = nullptr;
+  if (LZ4F_isError(
+          LZ4F_createCompressionContext(&raw_context, LZ4F_VERSION))) {
+    return Error("failed to initialize state for lz4 data compression");
+  }
+  std::unique_ptr<LZ4F_cctx, decltype(&LZ4F_freeCompressionContext)> context(
+      raw_context, LZ4F_freeCompressionContext);
+
+  LZ4F_preferences_t preferences;
+  memset(&preferences, 0, sizeof(preferences));
+  preferences.frameInfo.contentSize = source_byte_size;
+  preferences.compressionLevel = (level == -1) ? 0 : level;
+
+  // Each call writes into its own buffer that is sized for the worst case,
+  // the frame is the concatenation of the buffers.
+  std::unique_ptr<char[]> buffer(new char[LZ4F_HEADER_SIZE_MAX]);
+  size_t written = LZ4F_compressBegin(
+      context.get(), buffer.get(), LZ4F_HEADER_SIZE_MAX, &preferences);
+  for (const auto& span : spans) {
+    if (LZ4F_isError(written)) {
+      break;
+    }
+    compressed_data->emplace_back(std::move(buffer), written);
+    const size_t bound = LZ4F_compressBound(span.second, &preferences);
+    buffer.reset(new char[bound]);
+    written = LZ4F_compressUpdate(
+        context.get(), buffer.get(), bound, span.first, span.second, nullptr);
+  }
+  if (!LZ4F_isError(written)) {
+    compressed_data->emplace_back(std::move(buffer), written);
+    const size_t bound = LZ4F_compressBound(0, &preferences);
+    buffer.reset(new char[bound]);
+    written = LZ4F_compressEnd(context.get(), buffer.get(), bound, nullptr);
+  }
+  if (LZ4F_isError(written)) {
+    return Error(
+        "failed to compress data with lz4: " +
+        std::string(LZ4F_getErrorName(written)));
   }
+  compressed_data->emplace_back(std::move(buffer), written);
   return Error::Success;
 }
+#endif  // TRITON_ENABLE_LZ4
+
+// libcurl provides automatic decompression, so only implement compression.
+// GZIP data larger than 'chunk_byte_size' is compressed in parallel if
+// 'pool' is provided.
+Error
+CompressData(
+    const InferenceServerHttpClient::CompressionType type, const int level,
+    HttpCompressionPool* pool, const size_t chunk_byte_size,
+    const std::deque<std::pair<uint8_t*, size_t>>& source,
+    const size_t source_byte_size,
+    std::vector<std::pair<std::unique_ptr<char[]>, size_t>>* compressed_data)
+{
+  // nothing to be compressed
+  if (source_byte_size == 0) {
+    return Error("nothing to be compressed");
+  }
+
+  std::vector<std::pair<uint8_t*, size_t>> spans;
+  GetSpans(source, 0, source_byte_size, &spans);
+  switch (type) {
+    case InferenceServerHttpClient::CompressionType::GZIP:
+      if ((pool != nullptr) && (chunk_byte_size > 0) &&
+          (source_byte_size > chunk_byte_size)) {
+        return ParallelGzipCompress(
+            level, pool, chunk_byte_size, source, source_byte_size,
+            compressed_data);
+      }
+      return ZlibCompress(
+          type, level, spans, source_byte_size, compressed_data);
+    case InferenceServerHttpClient::CompressionType::DEFLATE:
+      return ZlibCompress(
+          type, level, spans, source_byte_size, compressed_data);
+    case InferenceServerHttpClient::CompressionType::ZSTD:
+#ifdef TRITON_ENABLE_ZSTD
+      return ZstdCompress(level, spans, source_byte_size, compressed_data);
+#else
+      return Error("the client is not built with zstd compression support");
+#endif  // TRITON_ENABLE_ZSTD
+    case InferenceServerHttpClient::CompressionType::LZ4:
+#ifdef TRITON_ENABLE_LZ4
+      return Lz4Compress(level, spans, source_byte_size, compressed_data);
+#else
+      return Error("the client is not built with lz4 compression support");
+#endif  // TRITON_ENABLE_LZ4
+    case InferenceServerHttpClient::CompressionType::NONE:
+    case InferenceServerHttpClient::CompressionType::AUTO:
+      break;
+  }
+  return Error("can't compress data with NONE or AUTO type");
+}
 
 Error
 ParseSslCertType(
@@ -279,10 +866,250 @@ SetSSLCurlOptions(CURL** curl, const HttpSslOptions& ssl_options)
   return Error::Success;
 }
 
+// Append 'str' to 'json' as a quoted and escaped JSON string.
+void
+AppendJsonString(std::string* json, const std::string& str)
+{
+  json->push_back('"');
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        json->append("\\\"");
+        break;
+      case '\\':
+        json->append("\\\\");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          json->append(escaped);
+        } else {
+          json->push_back(c);
+        }
+        break;
+    }
+  }
+  json->push_back('"');
+}
+
 }  // namespace
 
 //==============================================================================
 
+// An HttpPreparedInferRequest keeps the request JSON as fragments that are
+// serialized once, so that issuing a request only needs to write the parts
+// that may change between requests: the request id, the sequence parameters
+// and the shape and byte size of each input.
+class HttpPreparedInferRequest : public PreparedInferRequest {
+ public:
+  HttpPreparedInferRequest(
+      const InferenceServerClient* client, const std::string& request_uri,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs);
+
+  // Serialize the fragments of the request JSON.
+  Error Init();
+
+  // Write the request JSON with the current request id, sequence settings
+  // and input shapes into 'json'.
+  Error WriteRequestJson(std::string* json) const;
+
+  const InferenceServerClient* Client() const { return client_; }
+  const std::string& RequestUri() const { return request_uri_; }
+  const std::vector<InferInput*>& Inputs() const { return inputs_; }
+  const std::vector<const InferRequestedOutput*>& Outputs() const
+  {
+    return outputs_;
+  }
+
+ private:
+  const std::string request_uri_;
+  // The request parameters that don't change between requests, without the
+  // enclosing braces.
+  std::string static_parameters_;
+  // For each input, the input object up to the opening bracket of the shape.
+  std::vector<std::string> input_prefixes_;
+  // For each input in shared memory, its parameters without the enclosing
+  // braces. Empty for the inputs that are sent with the request.
+  std::vector<std::string> input_parameters_;
+  // The "outputs" member including the leading comma, empty if no outputs
+  // are requested.
+  std::string outputs_json_;
+};
+
+HttpPreparedInferRequest::HttpPreparedInferRequest(
+    const InferenceServerClient* client, const std::string& request_uri,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+    : PreparedInferRequest(client, options, inputs, outputs),
+      request_uri_(request_uri)
+{
+}
+
+Error
+HttpPreparedInferRequest::Init()
+{
+  if (options_.priority_ != 0) {
+    static_parameters_ += "\"priority\":" + std::to_string(options_.priority_);
+  }
+  if (options_.server_timeout_ != 0) {
+    if (!static_parameters_.empty()) {
+      static_parameters_ += ',';
+    }
+    static_parameters_ +=
+        "\"timeout\":" + std::to_string(options_.server_timeout_);
+  }
+  // If no outputs are provided then set the request parameter to return all
+  // outputs as binary data.
+  if (outputs_.empty()) {
+    if (!static_parameters_.empty()) {
+      static_parameters_ += ',';
+    }
+    static_parameters_ += "\"binary_data_output\":true";
+  }
+
+  for (const auto io : inputs_) {
+    input_prefixes_.emplace_back("{\"name\":");
+    AppendJsonString(&input_prefixes_.back(), io->Name());
+    input_prefixes_.back() += ",\"datatype\":";
+    AppendJsonString(&input_prefixes_.back(), io->Datatype());
+    input_prefixes_.back() += ",\"shape\":[";
+
+    input_parameters_.emplace_back();
+    if (io->IsSharedMemory()) {
+      std::string region_name;
+      size_t offset;
+      size_t byte_size;
+      Error err = io->SharedMemoryInfo(&region_name, &byte_size, &offset);
+      if (!err.IsOk()) {
+        return err;
+      }
+
+      std::string& parameters = input_parameters_.back();
+      parameters = "\"shared_memory_region\":";
+      AppendJsonString(&parameters, region_name);
+      parameters +=
+          ",\"shared_memory_byte_size\":" + std::to_string(byte_size);
+      if (offset != 0) {
+        parameters += ",\"shared_memory_offset\":" + std::to_string(offset);
+      }
+    }
+  }
+
+  if (!outputs_.empty()) {
+    outputs_json_ = ",\"outputs\":[";
+    for (size_t i = 0; i < outputs_.size(); ++i) {
+      const InferRequestedOutput* io = outputs_[i];
+      if (i != 0) {
+        outputs_json_ += ',';
+      }
+      outputs_json_ += "{\"name\":";
+      AppendJsonString(&outputs_json_, io->Name());
+      outputs_json_ += ",\"parameters\":{";
+      if (io->ClassificationCount() > 0) {
+        outputs_json_ += "\"classification\":" +
+                         std::to_string(io->ClassificationCount()) + ",";
+      }
+
+      if (io->IsSharedMemory()) {
+        std::string region_name;
+        size_t offset;
+        size_t byte_size;
+        Error err = io->SharedMemoryInfo(&region_name, &byte_size, &offset);
+        if (!err.IsOk()) {
+          return err;
+        }
+
+        outputs_json_ += "\"shared_memory_region\":";
+        AppendJsonString(&outputs_json_, region_name);
+        outputs_json_ +=
+            ",\"shared_memory_byte_size\":" + std::to_string(byte_size);
+        if (offset != 0) {
+          outputs_json_ +=
+              ",\"shared_memory_offset\":" + std::to_string(offset);
+        }
+      } else {
+        outputs_json_ += "\"binary_data\":true";
+      }
+      outputs_json_ += "}}";
+    }
+    outputs_json_ += ']';
+  }
+
+  return Error::Success;
+}
+
+Error
+HttpPreparedInferRequest::WriteRequestJson(std::string* json) const
+{
+  json->clear();
+  json->append("{\"id\":");
+  AppendJsonString(json, options_.request_id_);
+
+  const bool in_sequence =
+      (options_.sequence_id_ != 0) || (!options_.sequence_id_str_.empty());
+  if (in_sequence || !static_parameters_.empty()) {
+    json->append(",\"parameters\":{");
+    if (in_sequence) {
+      json->append("\"sequence_id\":");
+      if (options_.sequence_id_ != 0) {
+        json->append(std::to_string(options_.sequence_id_));
+      } else {
+        AppendJsonString(json, options_.sequence_id_str_);
+      }
+      json->append(",\"sequence_start\":");
+      json->append(options_.sequence_start_ ? "true" : "false");
+      json->append(",\"sequence_end\":");
+      json->append(options_.sequence_end_ ? "true" : "false");
+      if (!static_parameters_.empty()) {
+        json->push_back(',');
+      }
+    }
+    json->append(static_parameters_);
+    json->push_back('}');
+  }
+
+  if (!inputs_.empty()) {
+    json->append(",\"inputs\":[");
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      if (i != 0) {
+        json->push_back(',');
+      }
+      json->append(input_prefixes_[i]);
+      bool first_dim = true;
+      for (const auto dim : inputs_[i]->Shape()) {
+        if (!first_dim) {
+          json->push_back(',');
+        }
+        json->append(std::to_string(dim));
+        first_dim = false;
+      }
+      json->append("],\"parameters\":{");
+      if (!input_parameters_[i].empty()) {
+        json->append(input_parameters_[i]);
+      } else {
+        size_t byte_size;
+        Error err = inputs_[i]->ByteSize(&byte_size);
+        if (!err.IsOk()) {
+          return err;
+        }
+        json->append("\"binary_data_size\":");
+        json->append(std::to_string(byte_size));
+      }
+      json->append("}}");
+    }
+    json->push_back(']');
+  }
+
+  json->append(outputs_json_);
+  json->push_back('}');
+
+  return Error::Success;
+}
+
+//==============================================================================
+
 class HttpInferRequest : public InferRequest {
  public:
   HttpInferRequest(
@@ -295,43 +1122,137 @@ class HttpInferRequest : public InferRequest {
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs);
 
+  // Initialize the request for HTTP transfer from a prepared request.
+  Error InitializeRequest(const HttpPreparedInferRequest& prepared);
+
   // Adds the input data to be delivered to the server
   Error AddInput(uint8_t* buf, size_t byte_size);
 
   // Copy into 'buf' up to 'size' bytes of input data. Return the
-  // actual amount copied in 'input_bytes'.
-  Error GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes);
-
-  Error CompressInput(const InferenceServerHttpClient::CompressionType type);
+  // actual amount copied in 'input_bytes'. 'pending' returns true if no
+  // data could be copied because the next compressed chunk is not ready, see
+  // ParallelGzipStream::Read().
+  Error GetNextInput(
+      uint8_t* buf, size_t size, size_t* input_bytes, bool* pending);
+
+  // Replace the input data with its compression, see CompressData() for the
+  // parameters.
+  Error CompressInput(
+      const InferenceServerHttpClient::CompressionType type, const int level,
+      HttpCompressionPool* pool, const size_t chunk_byte_size);
+
+  // Replace the input data with its gzip compression that is deflated in
+  // chunks of 'chunk_byte_size' bytes on 'pool' while it is sent. The size
+  // of the compressed data is not known in advance, 'total_input_byte_size_'
+  // stays the size of the uncompressed data.
+  void StartGzipStream(
+      const int level, HttpCompressionPool* pool,
+      const size_t chunk_byte_size);
+
+  // Wait for the compression started by StartGzipStream() to stop accessing
+  // the input data, must be called before the request completes.
+  void StopGzipStream();
+
+  // Build the list of the HTTP request header lines from 'headers' and
+  // 'content_encoding', which is null if the body is not compressed. The
+  // list is stored in the request and is valid until it is built again.
+  struct curl_slist* BuildHeaderList(
+      const Headers& headers, const char* content_encoding);
+
+  // Record the next 'byte_size' bytes of the response body. Once the
+  // response JSON header is complete the binary outputs that have a
+  // caller provided buffer are written directly into that buffer.
+  void ReceiveResponse(const char* buf, size_t byte_size);
 
  private:
   friend class InferenceServerHttpClient;
   friend class InferResultHttp;
 
+  // Reset the response state and collect the caller provided buffers of
+  // 'outputs'.
+  void PrepareResponse(const std::vector<const InferRequestedOutput*>& outputs);
+
+  // Parse the response JSON header and decide where each binary output
+  // that follows it is written.
+  void ParseResponseHeader();
+
   Error PrepareRequestJson(
       const InferOptions& options, const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs,
       triton::common::TritonJson::Value* request_json);
 
-  // Pointer to the list of the HTTP request header, keep it such that it will
-  // be valid during the transfer and can be freed once transfer is completed.
-  struct curl_slist* header_list_;
+  // The serialized request JSON.
+  const char* RequestJsonBase() const
+  {
+    return from_prepared_ ? prepared_request_json_.c_str()
+                          : request_json_.Base();
+  }
+  size_t RequestJsonSize() const
+  {
+    return from_prepared_ ? prepared_request_json_.size()
+                          : request_json_.Size();
+  }
+
+  // The URI of the request with its query string, it must be valid during
+  // the transfer.
+  std::string request_uri_;
+  // The lines of the HTTP request header that are not constant and the nodes
+  // of the list of all the lines, both are kept valid during the transfer
+  // and reused by the next call.
+  std::vector<std::string> header_lines_;
+  std::vector<struct curl_slist> header_nodes_;
 
   // HTTP response code for the inference request
   long http_code_;
+  // Identifies the asynchronous call that the request is used for, so that
+  // a cancellation of a previous call doesn't affect the current one.
+  uint64_t call_id_;
+  // Whether the asynchronous call was cancelled
+  bool cancelled_;
 
   size_t total_input_byte_size_;
+  // Whether the compression of the request was decided by the AUTO mode,
+  // the transfer of such a request is recorded for the next decisions.
+  bool auto_compression_;
 
   triton::common::TritonJson::WriteBuffer request_json_;
+  // The request JSON written from a prepared request, used instead of
+  // 'request_json_' if 'from_prepared_' is true.
+  std::string prepared_request_json_;
+  bool from_prepared_;
 
-  // Buffer that accumulates the response body.
+  // Buffer that accumulates the response body, except for the outputs
+  // written into a caller provided buffer.
   std::unique_ptr<std::string> infer_response_buffer_;
 
-  // The pointers to the input data.
+  // The caller provided buffers to write the outputs into, keyed by
+  // output name.
+  std::map<std::string, std::pair<uint8_t*, size_t>> output_buffers_;
+
+  // The response JSON header, parsed while the response is received if
+  // 'output_buffers_' is not empty.
+  triton::common::TritonJson::Value response_json_;
+  bool response_json_parsed_;
+  Error response_status_;
+
+  // The destination and byte size of each binary output, in the order
+  // they follow the header in the response body. A null destination
+  // means the output is accumulated in 'infer_response_buffer_'.
+  std::vector<std::pair<uint8_t*, size_t>> response_outputs_;
+  size_t next_response_output_;
+  size_t response_output_received_;
+
+  // The pointers to the input data and the index of the next one to send.
+  // The sent buffers are not popped, so that the deque keeps reusing the
+  // same storage once it is cleared for the next call.
   std::deque<std::pair<uint8_t*, size_t>> data_buffers_;
+  size_t next_data_buffer_;
 
   // Placeholder for the compressed data
   std::vector<std::pair<std::unique_ptr<char[]>, size_t>> compressed_data_;
+  // The compression in progress while the request is sent, it provides the
+  // input data instead of 'data_buffers_' if not null.
+  std::shared_ptr<ParallelGzipStream> gzip_stream_;
 
   size_t response_json_size_;
 };
@@ -339,25 +1260,25 @@ class HttpInferRequest : public InferRequest {
 
 HttpInferRequest::HttpInferRequest(
     InferenceServerClient::OnCompleteFn callback, const bool verbose)
-    : InferRequest(callback, verbose), header_list_(nullptr),
-      total_input_byte_size_(0), response_json_size_(0)
+    : InferRequest(callback, verbose), call_id_(0),
+      cancelled_(false), total_input_byte_size_(0), auto_compression_(false),
+      from_prepared_(false), response_json_parsed_(false),
+      next_response_output_(0), response_output_received_(0),
+      next_data_buffer_(0), response_json_size_(0)
 {
 }
 
-HttpInferRequest::~HttpInferRequest()
-{
-  if (header_list_ != nullptr) {
-    curl_slist_free_all(header_list_);
-    header_list_ = nullptr;
-  }
-}
+HttpInferRequest::~HttpInferRequest() {}
 
 Error
 HttpInferRequest::InitializeRequest(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs)
 {
-  data_buffers_ = {};
+  data_buffers_.clear();
+  next_data_buffer_ = 0;
+  compressed_data_.clear();
+  gzip_stream_.reset();
   total_input_byte_size_ = 0;
   http_code_ = 400;
 
@@ -370,16 +1291,183 @@ HttpInferRequest::InitializeRequest(
 
   request_json_.Clear();
   request_json.Write(&request_json_);
+  from_prepared_ = false;
+
+  // Add the buffer holding the json to be delivered first
+  AddInput((uint8_t*)RequestJsonBase(), RequestJsonSize());
+
+  PrepareResponse(outputs);
+
+  return Error::Success;
+}
+
+Error
+HttpInferRequest::InitializeRequest(const HttpPreparedInferRequest& prepared)
+{
+  data_buffers_.clear();
+  next_data_buffer_ = 0;
+  compressed_data_.clear();
+  gzip_stream_.reset();
+  total_input_byte_size_ = 0;
+  http_code_ = 400;
+
+  Error err = prepared.WriteRequestJson(&prepared_request_json_);
+  if (!err.IsOk()) {
+    return err;
+  }
+  from_prepared_ = true;
 
   // Add the buffer holding the json to be delivered first
-  AddInput((uint8_t*)request_json_.Base(), request_json_.Size());
+  AddInput((uint8_t*)RequestJsonBase(), RequestJsonSize());
 
-  // Prepare buffer to record the response
-  infer_response_buffer_.reset(new std::string());
+  PrepareResponse(prepared.Outputs());
 
   return Error::Success;
 }
 
+void
+HttpInferRequest::PrepareResponse(
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  // Prepare buffer to record the response, the buffer of a reused request
+  // keeps its capacity unless it has grown too large.
+  if ((infer_response_buffer_ == nullptr) ||
+      (infer_response_buffer_->capacity() > kMaxRetainedResponseByteSize)) {
+    infer_response_buffer_.reset(new std::string());
+  } else {
+    infer_response_buffer_->clear();
+  }
+  response_json_size_ = 0;
+  cancelled_ = false;
+
+  output_buffers_.clear();
+  for (const auto output : outputs) {
+    if (output->HasBuffer()) {
+      uint8_t* buf;
+      size_t byte_size;
+      output->BufferInfo(&buf, &byte_size);
+      output_buffers_.emplace(output->Name(), std::make_pair(buf, byte_size));
+    }
+  }
+
+  response_json_parsed_ = false;
+  response_status_ = Error::Success;
+  response_outputs_.clear();
+  next_response_output_ = 0;
+  response_output_received_ = 0;
+}
+
+void
+HttpInferRequest::ReceiveResponse(const char* buf, size_t byte_size)
+{
+  // Without caller provided buffers, or if the response has no separate
+  // JSON header (e.g. an error response), the whole body is accumulated.
+  if (output_buffers_.empty() || (response_json_size_ == 0)) {
+    infer_response_buffer_->append(buf, byte_size);
+    return;
+  }
+
+  if (!response_json_parsed_) {
+    const size_t header_byte_size = std::min(
+        response_json_size_ - infer_response_buffer_->size(), byte_size);
+    infer_response_buffer_->append(buf, header_byte_size);
+    buf += header_byte_size;
+    byte_size -= header_byte_size;
+    if (infer_response_buffer_->size() < response_json_size_) {
+      return;
+    }
+    ParseResponseHeader();
+  }
+
+  while (next_response_output_ < response_outputs_.size()) {
+    auto& output = response_outputs_[next_response_output_];
+    if (response_output_received_ == output.second) {
+      ++next_response_output_;
+      response_output_received_ = 0;
+      continue;
+    }
+    if (byte_size == 0) {
+      break;
+    }
+
+    const size_t output_byte_size =
+        std::min(output.second - response_output_received_, byte_size);
+    if (output.first != nullptr) {
+      memcpy(output.first + response_output_received_, buf, output_byte_size);
+    } else {
+      infer_response_buffer_->append(buf, output_byte_size);
+    }
+    response_output_received_ += output_byte_size;
+    buf += output_byte_size;
+    byte_size -= output_byte_size;
+  }
+
+  // Keep anything not described by the header, InferResultHttp ignores it
+  // the same as if no buffer was provided.
+  if (byte_size > 0) {
+    infer_response_buffer_->append(buf, byte_size);
+  }
+}
+
+void
+HttpInferRequest::ParseResponseHeader()
+{
+  response_json_parsed_ = true;
+
+  // The header of the previous response of a reused request is moved into
+  // its result.
+  response_json_ = triton::common::TritonJson::Value();
+
+  // If the header can't be parsed all outputs are accumulated and
+  // InferResultHttp reports the failure.
+  response_status_ = response_json_.Parse(
+      infer_response_buffer_->c_str(), response_json_size_);
+  if (!response_status_.IsOk()) {
+    return;
+  }
+
+  size_t staged_byte_size = 0;
+  triton::common::TritonJson::Value outputs_json;
+  if (response_json_.Find("outputs", &outputs_json)) {
+    for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
+      triton::common::TritonJson::Value output_json;
+      triton::common::TritonJson::Value param_json;
+      const char* name_str;
+      size_t name_strlen;
+      uint64_t data_size = 0;
+      if (!outputs_json.IndexAsObject(i, &output_json).IsOk() ||
+          !output_json.MemberAsString("name", &name_str, &name_strlen)
+               .IsOk() ||
+          !output_json.Find("parameters", &param_json) ||
+          !param_json.MemberAsUInt("binary_data_size", &data_size).IsOk()) {
+        // Keep the entries aligned with the outputs in the header.
+        response_outputs_.emplace_back(nullptr, 0);
+        continue;
+      }
+
+      uint8_t* buf = nullptr;
+      auto itr = output_buffers_.find(std::string(name_str, name_strlen));
+      if (itr != output_buffers_.end()) {
+        if (data_size > itr->second.second) {
+          response_status_ = Error(
+              "output '" + itr->first + "' has byte size " +
+              std::to_string(data_size) +
+              " which exceeds the byte size of its buffer " +
+              std::to_string(itr->second.second));
+        } else {
+          buf = itr->second.first;
+        }
+      }
+      if (buf == nullptr) {
+        staged_byte_size += data_size;
+      }
+      response_outputs_.emplace_back(buf, data_size);
+    }
+  }
+
+  infer_response_buffer_->reserve(response_json_size_ + staged_byte_size);
+}
+
 Error
 HttpInferRequest::PrepareRequestJson(
     const InferOptions& options, const std::vector<InferInput*>& inputs,
@@ -530,30 +1618,41 @@ HttpInferRequest::AddInput(uint8_t* buf, size_t byte_size)
 }
 
 Error
-HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
+HttpInferRequest::GetNextInput(
+    uint8_t* buf, size_t size, size_t* input_bytes, bool* pending)
 {
+  if (gzip_stream_ != nullptr) {
+    Error err = gzip_stream_->Read(buf, size, input_bytes, pending);
+    if (err.IsOk() && gzip_stream_->Done()) {
+      Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+    }
+    return err;
+  }
+
   *input_bytes = 0;
+  *pending = false;
 
-  while (!data_buffers_.empty() && size > 0) {
-    const size_t csz = std::min(data_buffers_.front().second, size);
+  while ((next_data_buffer_ < data_buffers_.size()) && size > 0) {
+    auto& data_buffer = data_buffers_[next_data_buffer_];
+    const size_t csz = std::min(data_buffer.second, size);
     if (csz > 0) {
-      const uint8_t* input_ptr = data_buffers_.front().first;
+      const uint8_t* input_ptr = data_buffer.first;
       std::copy(input_ptr, input_ptr + csz, buf);
       size -= csz;
       buf += csz;
       *input_bytes += csz;
 
 
-      data_buffers_.front().first += csz;
-      data_buffers_.front().second -= csz;
-      if (data_buffers_.front().second == 0) {
-        data_buffers_.pop_front();
-      }
+      data_buffer.first += csz;
+      data_buffer.second -= csz;
+    }
+    if (data_buffer.second == 0) {
+      ++next_data_buffer_;
     }
   }
 
   // Set end timestamp if all inputs have been sent.
-  if (data_buffers_.empty()) {
+  if (next_data_buffer_ == data_buffers_.size()) {
     Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   }
 
@@ -562,10 +1661,12 @@ HttpInferRequest::GetNextInput(uint8_t* buf, size_t size, size_t* input_bytes)
 
 Error
 HttpInferRequest::CompressInput(
-    const InferenceServerHttpClient::CompressionType type)
+    const InferenceServerHttpClient::CompressionType type, const int level,
+    HttpCompressionPool* pool, const size_t chunk_byte_size)
 {
   auto err = CompressData(
-      type, data_buffers_, total_input_byte_size_, &compressed_data_);
+      type, level, pool, chunk_byte_size, data_buffers_,
+      total_input_byte_size_, &compressed_data_);
   if (!err.IsOk()) {
     return err;
   }
@@ -579,6 +1680,244 @@ HttpInferRequest::CompressInput(
   return Error::Success;
 }
 
+void
+HttpInferRequest::StartGzipStream(
+    const int level, HttpCompressionPool* pool, const size_t chunk_byte_size)
+{
+  gzip_stream_.reset(new ParallelGzipStream(
+      level, chunk_byte_size, data_buffers_, total_input_byte_size_));
+  data_buffers_.clear();
+  ParallelGzipStream::Start(gzip_stream_, pool);
+}
+
+void
+HttpInferRequest::StopGzipStream()
+{
+  if (gzip_stream_ != nullptr) {
+    gzip_stream_->Stop();
+  }
+}
+
+struct curl_slist*
+HttpInferRequest::BuildHeaderList(
+    const Headers& headers, const char* content_encoding)
+{
+  // The lines are assigned in place so that their storage is reused
+  header_lines_.resize(1 + headers.size());
+  header_lines_[0].assign(kInferHeaderContentLengthHTTPHeader);
+  header_lines_[0].append(": ");
+  header_lines_[0].append(std::to_string(RequestJsonSize()));
+  size_t idx = 1;
+  for (const auto& pr : headers) {
+    std::string& line = header_lines_[idx++];
+    line.assign(pr.first);
+    line.append(": ");
+    line.append(pr.second);
+  }
+
+  // curl doesn't modify the lines, the constant ones are not copied
+  header_nodes_.resize(
+      header_lines_.size() + 2 + ((content_encoding != nullptr) ? 1 : 0));
+  idx = 0;
+  auto add_line = [this, &idx](const char* line) {
+    header_nodes_[idx].data = const_cast<char*>(line);
+    header_nodes_[idx].next =
+        (idx + 1 < header_nodes_.size()) ? &header_nodes_[idx + 1] : nullptr;
+    idx++;
+  };
+  add_line(header_lines_[0].c_str());
+  add_line("Expect:");
+  add_line("Content-Type: application/octet-stream");
+  for (size_t i = 1; i < header_lines_.size(); i++) {
+    add_line(header_lines_[i].c_str());
+  }
+  if (content_encoding != nullptr) {
+    add_line(content_encoding);
+  }
+  return &header_nodes_[0];
+}
+
+//==============================================================================
+
+// Lock-free queue for handing over values from any number of producer
+// threads to a single consumer thread.
+template <typename T>
+class SubmissionQueue {
+ public:
+  SubmissionQueue() : head_(nullptr) {}
+  ~SubmissionQueue()
+  {
+    std::vector<T> values;
+    PopAll(&values);
+  }
+
+  // Add 'value' to the queue. Return true if the queue was empty before the
+  // push, in which case the consumer should be notified.
+  bool Push(T&& value)
+  {
+    Node* node = new Node(std::move(value));
+    // The node may be taken by the consumer as soon as it is linked, so the
+    // previous head is kept aside instead of being read from the node.
+    Node* head = head_.load(std::memory_order_relaxed);
+    do {
+      node->next_ = head;
+    } while (!head_.compare_exchange_weak(
+        head, node, std::memory_order_release, std::memory_order_relaxed));
+    return (head == nullptr);
+  }
+
+  // Remove all values from the queue and append them to 'values' in the order
+  // they were pushed. Must only be called by the consumer.
+  void PopAll(std::vector<T>* values)
+  {
+    // The values are linked in the reverse order of pushing
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next_;
+      node->next_ = reversed;
+      reversed = node;
+      node = next;
+    }
+    while (reversed != nullptr) {
+      values->emplace_back(std::move(reversed->value_));
+      Node* next = reversed->next_;
+      delete reversed;
+      reversed = next;
+    }
+  }
+
+ private:
+  struct Node {
+    explicit Node(T&& value) : value_(std::move(value)), next_(nullptr) {}
+
+    // A node is created for every push, its memory is recycled.
+    static void* operator new(size_t size)
+    {
+      return RecycledMemory<Node>::Allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size)
+    {
+      RecycledMemory<Node>::Release(ptr, size);
+    }
+
+    T value_;
+    Node* next_;
+  };
+
+  std::atomic<Node*> head_;
+};
+
+//==============================================================================
+
+// Event loop processing asynchronous requests with a curl multi handle. Only
+// the loop thread operates on the multi handle. Requests are submitted through
+// a lock-free queue and the loop is woken up with curl_multi_wakeup(), so
+// submitting a request never waits on the network I/O of other requests.
+struct HttpTransferLoop {
+  using Submission = std::pair<CURL*, std::shared_ptr<HttpInferRequest>>;
+  // A request to cancel with the call it was issued for
+  using Cancellation = std::pair<std::weak_ptr<HttpInferRequest>, uint64_t>;
+
+  HttpTransferLoop() : multi_handle(curl_multi_init()), exiting(false) {}
+  ~HttpTransferLoop();
+
+  // Remove the ongoing request at 'index' from the multi handle and return
+  // it with its easy handle.
+  Submission TakeOngoingRequest(const size_t index);
+
+  CURLM* multi_handle;
+  std::thread worker;
+  // signal for the loop thread to stop
+  std::atomic<bool> exiting;
+  // requests submitted but not yet added to the multi handle
+  SubmissionQueue<Submission> submissions;
+  // ongoing asynchronous requests with their easy handle, only accessed by
+  // the loop thread. The index of each entry is stored as the private data
+  // of its easy handle.
+  std::vector<Submission> ongoing_async_requests;
+  // requests cancelled but not yet removed from the multi handle
+  SubmissionQueue<Cancellation> cancellations;
+  // requests whose transfer may have been paused waiting for the compression
+  // of their body, and can be resumed
+  SubmissionQueue<std::weak_ptr<HttpInferRequest>> resumptions;
+  // buffers reused by the loop thread for each iteration
+  std::vector<Submission> new_submissions;
+  std::vector<Cancellation> new_cancellations;
+  std::vector<std::weak_ptr<HttpInferRequest>> new_resumptions;
+  std::vector<std::shared_ptr<HttpInferRequest>> completed_requests;
+};
+
+// Cancels an asynchronous request by handing it to the event loop of the
+// request, as only the loop thread operates on the transfers.
+class HttpCancelHandle : public CancelHandle {
+ public:
+  HttpCancelHandle(
+      const std::shared_ptr<HttpTransferLoop>& loop,
+      const std::shared_ptr<HttpInferRequest>& request, const uint64_t call_id)
+      : loop_(loop), request_(request), call_id_(call_id)
+  {
+  }
+
+  Error Cancel() override;
+
+ private:
+  std::weak_ptr<HttpTransferLoop> loop_;
+  std::weak_ptr<HttpInferRequest> request_;
+  const uint64_t call_id_;
+};
+
+HttpTransferLoop::~HttpTransferLoop()
+{
+  // The loop thread must have been stopped, release the handles of the
+  // requests that are not completed.
+  std::vector<Submission> pending;
+  submissions.PopAll(&pending);
+  for (auto& submission : pending) {
+    curl_easy_cleanup(submission.first);
+  }
+
+  if (multi_handle != nullptr) {
+    for (auto& request : ongoing_async_requests) {
+      curl_multi_remove_handle(multi_handle, request.first);
+      curl_easy_cleanup(request.first);
+    }
+    curl_multi_cleanup(multi_handle);
+  }
+}
+
+HttpTransferLoop::Submission
+HttpTransferLoop::TakeOngoingRequest(const size_t index)
+{
+  Submission request = std::move(ongoing_async_requests[index]);
+  // Fill the slot with the last entry so that no entry is allocated or
+  // freed per request.
+  if (index != (ongoing_async_requests.size() - 1)) {
+    ongoing_async_requests[index] = std::move(ongoing_async_requests.back());
+    curl_easy_setopt(
+        ongoing_async_requests[index].first, CURLOPT_PRIVATE,
+        reinterpret_cast<void*>(index));
+  }
+  ongoing_async_requests.pop_back();
+  curl_multi_remove_handle(multi_handle, request.first);
+  return request;
+}
+
+Error
+HttpCancelHandle::Cancel()
+{
+  // The loop is released with the client
+  std::shared_ptr<HttpTransferLoop> loop = loop_.lock();
+  if (loop == nullptr) {
+    return Error::Success;
+  }
+  if (loop->cancellations.Push(
+          HttpTransferLoop::Cancellation(request_, call_id_))) {
+    curl_multi_wakeup(loop->multi_handle);
+  }
+  return Error::Success;
+}
+
 //==============================================================================
 
 class InferResultHttp : public InferResult {
@@ -604,15 +1943,35 @@ class InferResultHttp : public InferResult {
       const std::string& output_name,
       std::vector<std::string>* string_result) const override;
   std::string DebugString() const override;
+  Error IsFinalResponse(bool* is_final_response) const override;
+  Error IsNullResponse(bool* is_null_response) const override;
+
+  // A result is created for every response, its memory is recycled.
+  static void* operator new(size_t size)
+  {
+    return RecycledMemory<InferResultHttp>::Allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size)
+  {
+    RecycledMemory<InferResultHttp>::Release(ptr, size);
+  }
 
  private:
   InferResultHttp(std::shared_ptr<HttpInferRequest> infer_request);
   InferResultHttp(const Error err) : status_(err) {}
 
-  std::map<std::string, triton::common::TritonJson::Value>
-      output_name_to_result_map_;
-  std::map<std::string, std::pair<const uint8_t*, const size_t>>
-      output_name_to_buffer_map_;
+  // The JSON of an output and the location of its data if the response
+  // holds the data.
+  struct Output {
+    Output() : data(nullptr), byte_size(0), has_data(false) {}
+    triton::common::TritonJson::Value json;
+    const uint8_t* data;
+    size_t byte_size;
+    bool has_data;
+  };
+  // The outputs keyed by name. Each TritonJson value allocates its own
+  // rapidjson allocator, so the outputs are not worth keeping for reuse.
+  std::map<std::string, Output> outputs_;
 
   Error status_;
   triton::common::TritonJson::Value response_json_;
@@ -695,6 +2054,27 @@ InferResultHttp::Id(std::string* id) const
   return Error::Success;
 }
 
+Error
+InferResultHttp::IsFinalResponse(bool* is_final_response) const
+{
+  if (is_final_response == nullptr) {
+    return Error("is_final_response cannot be nullptr");
+  }
+  // HTTP does not support decoupled models, every response is final.
+  *is_final_response = true;
+  return Error::Success;
+}
+
+Error
+InferResultHttp::IsNullResponse(bool* is_null_response) const
+{
+  if (is_null_response == nullptr) {
+    return Error("is_null_response cannot be nullptr");
+  }
+  *is_null_response = false;
+  return Error::Success;
+}
+
 namespace {
 
 Error
@@ -734,13 +2114,13 @@ InferResultHttp::Shape(
   }
 
   shape->clear();
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
+  auto itr = outputs_.find(output_name);
+  if (itr == outputs_.end()) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
-  return ShapeHelper(output_name, itr->second, shape);
+  return ShapeHelper(output_name, itr->second.json, shape);
 }
 
 Error
@@ -750,15 +2130,16 @@ InferResultHttp::Datatype(
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_result_map_.find(output_name);
-  if (itr == output_name_to_result_map_.end()) {
+  auto itr = outputs_.find(output_name);
+  if (itr == outputs_.end()) {
     return Error(
         "The response does not contain results for output name " + output_name);
   }
 
   const char* dtype_str;
   size_t dtype_strlen;
-  Error err = itr->second.MemberAsString("datatype", &dtype_str, &dtype_strlen);
+  Error err =
+      itr->second.json.MemberAsString("datatype", &dtype_str, &dtype_strlen);
   if (!err.IsOk()) {
     return Error(
         "The response does not contain datatype for output name " +
@@ -777,10 +2158,10 @@ InferResultHttp::RawData(
   if (!status_.IsOk()) {
     return status_;
   }
-  auto itr = output_name_to_buffer_map_.find(output_name);
-  if (itr != output_name_to_buffer_map_.end()) {
-    *buf = itr->second.first;
-    *byte_size = itr->second.second;
+  auto itr = outputs_.find(output_name);
+  if ((itr != outputs_.end()) && itr->second.has_data) {
+    *buf = itr->second.data;
+    *byte_size = itr->second.byte_size;
   } else {
     return Error(
         "The response does not contain results for output name " + output_name);
@@ -853,7 +2234,9 @@ InferResultHttp::InferResultHttp(
     : infer_request_(infer_request)
 {
   size_t offset = infer_request->response_json_size_;
-  if (infer_request->http_code_ == 499) {
+  if (infer_request->cancelled_) {
+    status_ = Error("Cancelled");
+  } else if (infer_request->http_code_ == 499) {
     status_ = Error("Deadline Exceeded");
   } else {
     if (offset != 0) {
@@ -862,8 +2245,17 @@ InferResultHttp::InferResultHttp(
                   << infer_request->infer_response_buffer_->substr(0, offset)
                   << std::endl;
       }
-      status_ = response_json_.Parse(
-          (char*)infer_request->infer_response_buffer_.get()->c_str(), offset);
+      // The header is already parsed if outputs were written into caller
+      // provided buffers while the response was received.
+      if (infer_request->response_json_parsed_) {
+        response_json_ = std::move(infer_request->response_json_);
+        infer_request->response_json_parsed_ = false;
+        status_ = infer_request->response_status_;
+      } else {
+        status_ = response_json_.Parse(
+            (char*)infer_request->infer_response_buffer_.get()->c_str(),
+            offset);
+      }
     } else {
       if (infer_request->verbose_) {
         std::cout << "inference response: "
@@ -887,6 +2279,8 @@ InferResultHttp::InferResultHttp(
         status_ = Error(std::string(err_str, err_strlen));
       }
     } else {
+      // Outputs already written into caller provided buffers, if any.
+      const auto& routed_outputs = infer_request->response_outputs_;
       triton::common::TritonJson::Value outputs_json;
       if (response_json_.Find("outputs", &outputs_json)) {
         for (size_t i = 0; i < outputs_json.ArraySize(); i++) {
@@ -903,7 +2297,7 @@ InferResultHttp::InferResultHttp(
             break;
           }
 
-          std::string output_name(name_str, name_strlen);
+          Output& output = outputs_[std::string(name_str, name_strlen)];
 
           triton::common::TritonJson::Value param_json;
           if (output_json.Find("parameters", &param_json)) {
@@ -913,17 +2307,21 @@ InferResultHttp::InferResultHttp(
               break;
             }
 
-            output_name_to_buffer_map_.emplace(
-                output_name,
-                std::pair<const uint8_t*, const size_t>(
-                    (uint8_t*)(infer_request->infer_response_buffer_.get()
-                                   ->c_str()) +
-                        offset,
-                    data_size));
-            offset += data_size;
+            output.has_data = true;
+            output.byte_size = data_size;
+            if ((i < routed_outputs.size()) &&
+                (routed_outputs[i].first != nullptr)) {
+              output.data = routed_outputs[i].first;
+            } else {
+              output.data =
+                  (uint8_t*)(infer_request->infer_response_buffer_.get()
+                                 ->c_str()) +
+                  offset;
+              offset += data_size;
+            }
           }
 
-          output_name_to_result_map_[output_name] = std::move(output_json);
+          output.json = std::move(output_json);
         }
       }
     }
@@ -962,15 +2360,16 @@ InferenceServerHttpClient::GenerateRequestBody(
     }
   }
 
-  *header_length = infer_request->request_json_.Size();
+  *header_length = infer_request->RequestJsonSize();
   *request_body = std::vector<char>(infer_request->total_input_byte_size_);
   size_t remaining_bytes = infer_request->total_input_byte_size_;
   size_t actual_copied_bytes = 0;
+  bool pending;
   char* current_pos = request_body->data();
   while (true) {
     err = infer_request->GetNextInput(
         reinterpret_cast<uint8_t*>(current_pos), remaining_bytes,
-        &actual_copied_bytes);
+        &actual_copied_bytes, &pending);
     if (!err.IsOk()) {
       return err;
     }
@@ -1004,43 +2403,91 @@ Error
 InferenceServerHttpClient::Create(
     std::unique_ptr<InferenceServerHttpClient>* client,
     const std::string& server_url, bool verbose,
-    const HttpSslOptions& ssl_options)
+    const HttpSslOptions& ssl_options, const HttpClientOptions& client_options)
 {
-  client->reset(
-      new InferenceServerHttpClient(server_url, verbose, ssl_options));
+  client->reset(new InferenceServerHttpClient(
+      server_url, verbose, ssl_options, client_options));
+
+  if (client_options.enable_http2) {
+    const curl_version_info_data* curl_info =
+        curl_version_info(CURLVERSION_NOW);
+    if ((curl_info->features & CURL_VERSION_HTTP2) == 0) {
+      client->reset();
+      return Error("HTTP/2 is not supported by the libcurl in use");
+    }
+  }
+
+  // The handle for synchronous requests is configured once and only the
+  // request specific options are set on each request.
+  if ((*client)->easy_handle_ != nullptr) {
+    Error err = (*client)->ConfigureEasyHandle((*client)->easy_handle_);
+    if (!err.IsOk()) {
+      client->reset();
+      return err;
+    }
+  }
+
   return Error::Success;
 }
 
 InferenceServerHttpClient::InferenceServerHttpClient(
-    const std::string& url, bool verbose, const HttpSslOptions& ssl_options)
+    const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+    const HttpClientOptions& client_options)
     : InferenceServerClient(verbose), url_(url), ssl_options_(ssl_options),
+      client_options_(client_options),
       easy_handle_(reinterpret_cast<void*>(curl_easy_init())),
-      multi_handle_(curl_multi_init())
+      next_transfer_loop_(0)
 {
+  callback_executor_ = client_options_.callback_executor;
+  easy_handle_pool_.reserve(client_options_.easy_handle_pool_size);
+  if (client_options_.compression_threads > 1) {
+    compression_pool_.reset(
+        new HttpCompressionPool(client_options_.compression_threads));
+  }
+  const size_t loop_count =
+      client_options_.polling ? 1 : client_options_.async_transfer_threads;
+  for (size_t i = 0; i < loop_count; ++i) {
+    transfer_loops_.emplace_back(new HttpTransferLoop());
+    CURLM* multi_handle = transfer_loops_.back()->multi_handle;
+    if (multi_handle == nullptr) {
+      continue;
+    }
+    if (client_options_.enable_http2) {
+      curl_multi_setopt(multi_handle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+      if (client_options_.http2_max_streams_per_connection > 0) {
+        curl_multi_setopt(
+            multi_handle, CURLMOPT_MAX_CONCURRENT_STREAMS,
+            client_options_.http2_max_streams_per_connection);
+      }
+    }
+    if (client_options_.max_connections > 0) {
+      curl_multi_setopt(
+          multi_handle, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+          client_options_.max_connections);
+    }
+  }
 }
 
 InferenceServerHttpClient::~InferenceServerHttpClient()
 {
-  exiting_ = true;
-
-  // thread not joinable if AsyncInfer() is not called
-  // (it is default constructed thread before the first AsyncInfer() call)
-  if (worker_.joinable()) {
-    cv_.notify_all();
-    worker_.join();
+  // threads are not joinable if AsyncInfer() is not called or in polling mode
+  // (they are default constructed threads before the first AsyncInfer() call)
+  for (auto& loop : transfer_loops_) {
+    if (loop->worker.joinable()) {
+      loop->exiting = true;
+      curl_multi_wakeup(loop->multi_handle);
+      loop->worker.join();
+    }
   }
+  transfer_loops_.clear();
+  WaitForCallbacks();
 
   if (easy_handle_ != nullptr) {
     curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle_));
   }
 
-  if (multi_handle_ != nullptr) {
-    for (auto& request : ongoing_async_requests_) {
-      CURL* easy_handle = reinterpret_cast<CURL*>(request.first);
-      curl_multi_remove_handle(multi_handle_, easy_handle);
-      curl_easy_cleanup(easy_handle);
-    }
-    curl_multi_cleanup(multi_handle_);
+  for (auto easy_handle : easy_handle_pool_) {
+    curl_easy_cleanup(reinterpret_cast<CURL*>(easy_handle));
   }
 }
 
@@ -1426,45 +2873,112 @@ InferenceServerHttpClient::Infer(
     const CompressionType request_compression_algorithm,
     const CompressionType response_compression_algorithm)
 {
-  Error err;
-
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
   if (!options.model_version_.empty()) {
     request_uri = request_uri + "/versions/" + options.model_version_;
   }
   request_uri = request_uri + "/infer";
 
-  std::shared_ptr<HttpInferRequest> sync_request(
-      new HttpInferRequest(nullptr /* callback */, verbose_));
+  return DoInfer(
+      result, request_uri, options, inputs, outputs, nullptr /* prepared */,
+      headers, query_params, request_compression_algorithm,
+      response_compression_algorithm);
+}
+
+Error
+InferenceServerHttpClient::Infer(
+    InferResult** result, PreparedInferRequest* request,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  HttpPreparedInferRequest* prepared;
+  Error err = ValidatePreparedRequest(request, &prepared);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return DoInfer(
+      result, prepared->RequestUri(), prepared->Options(), prepared->Inputs(),
+      prepared->Outputs(), prepared, headers, query_params,
+      request_compression_algorithm, response_compression_algorithm);
+}
+
+Error
+InferenceServerHttpClient::DoInfer(
+    InferResult** result, const std::string& request_uri,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const HttpPreparedInferRequest* prepared, const Headers& headers,
+    const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  Error err;
 
-  sync_request->Timer().Reset();
+  // The request state is taken from the pool so that concurrent calls from
+  // different threads don't share it.
+  bool reused;
+  std::shared_ptr<HttpInferRequest> sync_request = request_pool_.Acquire(
+      [this]() { return new HttpInferRequest(nullptr, verbose_); }, &reused);
+  UpdateRequestPoolStat(reused);
+  sync_request->Reuse(nullptr);
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
 
   if (!CurlGlobal::Get().Status().IsOk()) {
     return CurlGlobal::Get().Status();
   }
 
+  // The dedicated handle is used unless another thread is running a
+  // synchronous request on it, in which case a pooled handle is used.
+  struct PooledHandle {
+    ~PooledHandle()
+    {
+      if (handle != nullptr) {
+        client->ReleaseEasyHandle(handle);
+      }
+    }
+    InferenceServerHttpClient* client;
+    void* handle;
+  } pooled_handle{this, nullptr};
+  std::unique_lock<std::mutex> easy_handle_lock(
+      easy_handle_mutex_, std::try_to_lock);
+  void* easy_handle = easy_handle_;
+  if (!easy_handle_lock.owns_lock()) {
+    err = AcquireEasyHandle(&pooled_handle.handle);
+    if (!err.IsOk()) {
+      return err;
+    }
+    easy_handle = pooled_handle.handle;
+  }
+
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
   err = PreRunProcessing(
-      easy_handle_, request_uri, options, inputs, outputs, headers,
+      easy_handle, request_uri, options, inputs, outputs, prepared, headers,
       query_params, request_compression_algorithm,
       response_compression_algorithm, sync_request);
   if (!err.IsOk()) {
     return err;
   }
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_START);
 
   // Set SEND_END when content length is 0 (because
   // CURLOPT_READFUNCTION will not be called). In that case, we can't
   // measure SEND_END properly (send ends after sending request
   // header).
   if (sync_request->total_input_byte_size_ == 0) {
+    sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_END);
     sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
   }
 
-  // During this call SEND_END (except in above case), RECV_START, and
-  // RECV_END will be set.
-  auto curl_status = curl_easy_perform(easy_handle_);
+  // During this call ENQUEUE_END and SEND_END (except in above case),
+  // RECV_START, and RECV_END will be set.
+  auto curl_status = curl_easy_perform(easy_handle);
+  sync_request->StopGzipStream();
   if (curl_status == CURLE_OPERATION_TIMEDOUT) {
     return Error(
         "HTTP client failed (Deadline Exceeded): " +
@@ -1474,13 +2988,23 @@ InferenceServerHttpClient::Infer(
         "HTTP client failed: " + std::string(curl_easy_strerror(curl_status)));
   } else {  // Success
     curl_easy_getinfo(
-        easy_handle_, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
+        easy_handle, CURLINFO_RESPONSE_CODE, &sync_request->http_code_);
   }
 
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_START);
   InferResultHttp::Create(result, sync_request);
+  sync_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::DESERIALIZE_END);
 
   sync_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
 
+  if (sync_request->auto_compression_) {
+    compression_advisor_.RecordTransfer(
+        sync_request->total_input_byte_size_,
+        sync_request->Timer().Duration(
+            RequestTimers::Kind::SEND_START, RequestTimers::Kind::SEND_END));
+  }
   err = UpdateInferStat(sync_request->Timer());
   if (!err.IsOk()) {
     std::cerr << "Failed to update context stat: " << err << std::endl;
@@ -1500,62 +3024,146 @@ InferenceServerHttpClient::AsyncInfer(
     const CompressionType request_compression_algorithm,
     const CompressionType response_compression_algorithm)
 {
-  if (callback == nullptr) {
-    return Error(
-        "Callback function must be provided along with AsyncInfer() call.");
-  }
-
-  std::shared_ptr<HttpInferRequest> async_request;
-  if (!multi_handle_) {
-    return Error("failed to start HTTP asynchronous client");
-  } else if (!worker_.joinable()) {
-    worker_ = std::thread(&InferenceServerHttpClient::AsyncTransfer, this);
-  }
+  return AsyncInfer(
+      nullptr /* cancel_handle */, std::move(callback), options, inputs,
+      outputs, headers, query_params, request_compression_algorithm,
+      response_compression_algorithm);
+}
 
+Error
+InferenceServerHttpClient::AsyncInfer(
+    std::shared_ptr<CancelHandle>* cancel_handle, OnCompleteFn callback,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
   std::string request_uri(url_ + "/v2/models/" + options.model_name_);
   if (!options.model_version_.empty()) {
     request_uri = request_uri + "/versions/" + options.model_version_;
   }
-  request_uri = request_uri + "/infer";
+  request_uri = request_uri + "/infer";
+
+  return DoAsyncInfer(
+      std::move(callback), request_uri, options, inputs, outputs,
+      nullptr /* prepared */, headers, query_params,
+      request_compression_algorithm, response_compression_algorithm,
+      cancel_handle);
+}
+
+Error
+InferenceServerHttpClient::AsyncInfer(
+    OnCompleteFn callback, PreparedInferRequest* request,
+    const Headers& headers, const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm)
+{
+  HttpPreparedInferRequest* prepared;
+  Error err = ValidatePreparedRequest(request, &prepared);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  return DoAsyncInfer(
+      std::move(callback), prepared->RequestUri(), prepared->Options(),
+      prepared->Inputs(), prepared->Outputs(), prepared, headers,
+      query_params, request_compression_algorithm,
+      response_compression_algorithm, nullptr /* cancel_handle */);
+}
+
+Error
+InferenceServerHttpClient::DoAsyncInfer(
+    OnCompleteFn callback, const std::string& request_uri,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs,
+    const HttpPreparedInferRequest* prepared, const Headers& headers,
+    const Parameters& query_params,
+    const CompressionType request_compression_algorithm,
+    const CompressionType response_compression_algorithm,
+    std::shared_ptr<CancelHandle>* cancel_handle)
+{
+  if (callback == nullptr) {
+    return Error(
+        "Callback function must be provided along with AsyncInfer() call.");
+  }
+
+  Error err = StartTransferLoops();
+  if (!err.IsOk()) {
+    return err;
+  }
 
-  HttpInferRequest* raw_async_request =
-      new HttpInferRequest(std::move(callback), verbose_);
-  async_request.reset(raw_async_request);
+  bool reused;
+  std::shared_ptr<HttpInferRequest> async_request = request_pool_.Acquire(
+      [this]() { return new HttpInferRequest(nullptr, verbose_); }, &reused);
+  UpdateRequestPoolStat(reused);
+  async_request->Reuse(std::move(callback));
 
   async_request->Timer().CaptureTimestamp(RequestTimers::Kind::REQUEST_START);
 
-  CURL* multi_easy_handle = curl_easy_init();
-  Error err = PreRunProcessing(
-      reinterpret_cast<void*>(multi_easy_handle), request_uri, options, inputs,
-      outputs, headers, query_params, request_compression_algorithm,
+  void* vcurl = nullptr;
+  err = AcquireEasyHandle(&vcurl);
+  if (!err.IsOk()) {
+    return err;
+  }
+  CURL* multi_easy_handle = reinterpret_cast<CURL*>(vcurl);
+  async_request->Timer().CaptureTimestamp(
+      RequestTimers::Kind::SERIALIZE_START);
+  err = PreRunProcessing(
+      vcurl, request_uri, options, inputs, outputs, prepared, headers,
+      query_params, request_compression_algorithm,
       response_compression_algorithm, async_request);
   if (!err.IsOk()) {
-    curl_easy_cleanup(multi_easy_handle);
+    ReleaseEasyHandle(vcurl);
     return err;
   }
-
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto insert_result = ongoing_async_requests_.emplace(std::make_pair(
-        reinterpret_cast<uintptr_t>(multi_easy_handle), async_request));
-    if (!insert_result.second) {
-      curl_easy_cleanup(multi_easy_handle);
-      return Error("Failed to insert new asynchronous request context.");
-    }
-
-    async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
-    if (async_request->total_input_byte_size_ == 0) {
-      // Set SEND_END here because CURLOPT_READFUNCTION will not be called if
-      // content length is 0. In that case, we can't measure SEND_END properly
-      // (send ends after sending request header).
-      async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
-    }
-
-    curl_multi_add_handle(multi_handle_, multi_easy_handle);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SERIALIZE_END);
+
+  // The timestamps must be captured before the submission as the request
+  // may be processed by the loop thread as soon as it is submitted.
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_START);
+  async_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_START);
+  if (async_request->total_input_byte_size_ == 0) {
+    // Set SEND_END here because CURLOPT_READFUNCTION will not be called if
+    // content length is 0. In that case, we can't measure SEND_END properly
+    // (send ends after sending request header).
+    async_request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_END);
+    async_request->Timer().CaptureTimestamp(RequestTimers::Kind::SEND_END);
+  }
+
+  const std::shared_ptr<HttpTransferLoop>& loop =
+      transfer_loops_[next_transfer_loop_++ % transfer_loops_.size()];
+  // The handle is created before the submission since the request may be
+  // reused for another call as soon as it is submitted.
+  async_request->call_id_++;
+  if (cancel_handle != nullptr) {
+    cancel_handle->reset(
+        new HttpCancelHandle(loop, async_request, async_request->call_id_));
+  }
+  // The transfer is paused while the next chunk of the body is compressed,
+  // the loop resumes it once a chunk is ready. Resuming a transfer that is
+  // not paused has no effect.
+  if (async_request->gzip_stream_ != nullptr) {
+    std::weak_ptr<HttpTransferLoop> weak_loop(loop);
+    std::weak_ptr<HttpInferRequest> weak_request(async_request);
+    async_request->gzip_stream_->SetChunkCallback([weak_loop, weak_request] {
+      std::shared_ptr<HttpTransferLoop> loop = weak_loop.lock();
+      if (loop == nullptr) {
+        return;
+      }
+      std::weak_ptr<HttpInferRequest> request(weak_request);
+      if (loop->resumptions.Push(std::move(request))) {
+        curl_multi_wakeup(loop->multi_handle);
+      }
+    });
+  }
+  // Only wake up the loop if the queue was empty, otherwise a wake up is
+  // already pending and the loop will pick up all queued requests at once.
+  if (loop->submissions.Push(
+          HttpTransferLoop::Submission(multi_easy_handle, async_request))) {
+    curl_multi_wakeup(loop->multi_handle);
   }
 
-  cv_.notify_all();
   return Error::Success;
 }
 
@@ -1569,8 +3177,6 @@ InferenceServerHttpClient::InferMulti(
     const CompressionType request_compression_algorithm,
     const CompressionType response_compression_algorithm)
 {
-  Error err;
-
   // Sanity check
   if ((inputs.size() != options.size()) && (options.size() != 1)) {
     return Error(
@@ -1582,26 +3188,44 @@ InferenceServerHttpClient::InferMulti(
         "'outputs' must either contain 0/1 element or match size of 'inputs'");
   }
 
-  int64_t max_option_idx = options.size() - 1;
-  // value of '-1' means no output is specified
-  int64_t max_output_idx = outputs.size() - 1;
-  static std::vector<const InferRequestedOutput*> empty_outputs{};
-  for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
-    const auto& request_options = options[std::min(max_option_idx, i)];
-    const auto& request_output = (max_output_idx == -1)
-                                     ? empty_outputs
-                                     : outputs[std::min(max_output_idx, i)];
-
-    results->emplace_back();
-    err = Infer(
-        &results->back(), request_options, inputs[i], request_output, headers,
-        query_params, request_compression_algorithm,
-        response_compression_algorithm);
-    if (!err.IsOk()) {
-      return err;
+  if (inputs.empty()) {
+    return Error::Success;
+  }
+
+  // In polling mode nothing drives the asynchronous requests while this
+  // call waits, so the requests are sent one after another instead.
+  if (client_options_.polling) {
+    int64_t max_option_idx = options.size() - 1;
+    // value of '-1' means no output is specified
+    int64_t max_output_idx = outputs.size() - 1;
+    static std::vector<const InferRequestedOutput*> empty_outputs{};
+    for (int64_t i = 0; i < (int64_t)inputs.size(); ++i) {
+      const auto& request_options = options[std::min(max_option_idx, i)];
+      const auto& request_output = (max_output_idx == -1)
+                                       ? empty_outputs
+                                       : outputs[std::min(max_output_idx, i)];
+
+      results->emplace_back();
+      Error err = Infer(
+          &results->back(), request_options, inputs[i], request_output,
+          headers, query_params, request_compression_algorithm,
+          response_compression_algorithm);
+      if (!err.IsOk()) {
+        return err;
+      }
     }
-  }
-  return Error::Success;
+    return Error::Success;
+  }
+
+  // Send all the requests through the multi handle at once instead of one
+  // round trip after another, and wait for the last response.
+  return WaitInferMulti(
+      [&](OnMultiCompleteFn callback) {
+        return AsyncInferMulti(
+            callback, options, inputs, outputs, headers, query_params,
+            request_compression_algorithm, response_compression_algorithm);
+      },
+      results);
 }
 
 Error
@@ -1677,14 +3301,27 @@ InferenceServerHttpClient::InferRequestProvider(
 {
   HttpInferRequest* request = reinterpret_cast<HttpInferRequest*>(userp);
 
+  // The request leaves the transport queue once libcurl asks for its body
+  if (request->Timer().Timestamp(RequestTimers::Kind::ENQUEUE_END) == 0) {
+    request->Timer().CaptureTimestamp(RequestTimers::Kind::ENQUEUE_END);
+  }
+
   size_t input_bytes = 0;
+  bool pending;
   Error err = request->GetNextInput(
-      reinterpret_cast<uint8_t*>(contents), size * nmemb, &input_bytes);
+      reinterpret_cast<uint8_t*>(contents), size * nmemb, &input_bytes,
+      &pending);
   if (!err.IsOk()) {
     std::cerr << "RequestProvider: " << err << std::endl;
     return CURL_READFUNC_ABORT;
   }
 
+  // The transfer is resumed by the transfer loop once the next compressed
+  // chunk is ready, see DoAsyncInfer().
+  if (pending) {
+    return CURL_READFUNC_PAUSE;
+  }
+
   return input_bytes;
 }
 
@@ -1716,7 +3353,9 @@ InferenceServerHttpClient::InferResponseHeaderHandler(
       ++length_idx;
     }
 
-    if (length_idx < byte_size) {
+    // Outputs written into caller provided buffers are not accumulated,
+    // the reservation is made once the JSON header is parsed instead.
+    if ((length_idx < byte_size) && request->output_buffers_.empty()) {
       std::string hdr(buf + length_idx + 1, byte_size - length_idx - 1);
       request->infer_response_buffer_->reserve(std::stoi(hdr));
     }
@@ -1737,7 +3376,7 @@ InferenceServerHttpClient::InferResponseHandler(
 
   char* buf = reinterpret_cast<char*>(contents);
   size_t result_bytes = size * nmemb;
-  request->infer_response_buffer_->append(buf, result_bytes);
+  request->ReceiveResponse(buf, result_bytes);
 
   // InferResponseHandler may be called multiple times so we overwrite
   // RECV_END so that we always have the time of the last.
@@ -1746,20 +3385,63 @@ InferenceServerHttpClient::InferResponseHandler(
   return result_bytes;
 }
 
+Error
+InferenceServerHttpClient::PrepareInferRequest(
+    std::unique_ptr<PreparedInferRequest>* request,
+    const InferOptions& options, const std::vector<InferInput*>& inputs,
+    const std::vector<const InferRequestedOutput*>& outputs)
+{
+  std::string request_uri(url_ + "/v2/models/" + options.model_name_);
+  if (!options.model_version_.empty()) {
+    request_uri = request_uri + "/versions/" + options.model_version_;
+  }
+  request_uri = request_uri + "/infer";
+
+  std::unique_ptr<HttpPreparedInferRequest> prepared(
+      new HttpPreparedInferRequest(
+          this, request_uri, options, inputs, outputs));
+  Error err = prepared->Init();
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  request->reset(prepared.release());
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::ValidatePreparedRequest(
+    PreparedInferRequest* request, HttpPreparedInferRequest** prepared)
+{
+  *prepared = dynamic_cast<HttpPreparedInferRequest*>(request);
+  if ((*prepared == nullptr) || ((*prepared)->Client() != this)) {
+    return Error("The request was not prepared by this client.");
+  }
+  return Error::Success;
+}
+
 Error
 InferenceServerHttpClient::PreRunProcessing(
-    void* vcurl, std::string& request_uri, const InferOptions& options,
+    void* vcurl, const std::string& request_uri, const InferOptions& options,
     const std::vector<InferInput*>& inputs,
     const std::vector<const InferRequestedOutput*>& outputs,
-    const Headers& headers, const Parameters& query_params,
+    const HttpPreparedInferRequest* prepared, const Headers& headers,
+    const Parameters& query_params,
     const CompressionType request_compression_algorithm,
     const CompressionType response_compression_algorithm,
     std::shared_ptr<HttpInferRequest>& http_request)
 {
   CURL* curl = reinterpret_cast<CURL*>(vcurl);
 
+  // There is no standard content coding for LZ4 that libcurl can decode
+  if (response_compression_algorithm == CompressionType::LZ4) {
+    return Error("LZ4 is only supported for request compression");
+  }
+
   // Prepare the request object to provide the data for inference.
-  Error err = http_request->InitializeRequest(options, inputs, outputs);
+  Error err = (prepared != nullptr)
+                  ? http_request->InitializeRequest(*prepared)
+                  : http_request->InitializeRequest(options, inputs, outputs);
   if (!err.IsOk()) {
     return err;
   }
@@ -1781,30 +3463,162 @@ InferenceServerHttpClient::PreRunProcessing(
   }
 
   // Compress data if requested
-  switch (request_compression_algorithm) {
+  CompressionType request_compression;
+  err = CompressRequest(
+      request_compression_algorithm, http_request.get(), &request_compression);
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  // Prepare curl, the URI is kept in the request whose string storage is
+  // reused by the next call.
+  http_request->request_uri_.assign(request_uri);
+  if (!query_params.empty()) {
+    http_request->request_uri_.push_back('?');
+    http_request->request_uri_.append(GetQueryString(query_params));
+  }
+
+  // The options shared by all requests are set by ConfigureEasyHandle(), only
+  // set the options that vary per request. The handle may have been used by
+  // an earlier request so every such option must be set explicitly.
+  curl_easy_setopt(curl, CURLOPT_URL, http_request->request_uri_.c_str());
+
+  const long timeout_ms = options.client_timeout_ / 1000;
+  curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+
+  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
+
+  // The size of a body compressed while it is sent is not known, such a
+  // body is sent with chunked transfer encoding.
+  const curl_off_t post_byte_size =
+      (http_request->gzip_stream_ != nullptr)
+          ? -1
+          : static_cast<curl_off_t>(http_request->total_input_byte_size_);
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
+
+  // Compress data if requested
+  const char* content_encoding = nullptr;
+  switch (request_compression) {
+    case CompressionType::NONE:
+    case CompressionType::AUTO:
+      break;
+    case CompressionType::DEFLATE:
+      content_encoding = "Content-Encoding: deflate";
+      break;
+    case CompressionType::GZIP:
+      content_encoding = "Content-Encoding: gzip";
+      break;
+    case CompressionType::ZSTD:
+      content_encoding = "Content-Encoding: zstd";
+      break;
+    case CompressionType::LZ4:
+      content_encoding = "Content-Encoding: lz4";
+      break;
+  }
+  switch (response_compression_algorithm) {
     case CompressionType::NONE:
+      curl_easy_setopt(
+          curl, CURLOPT_ACCEPT_ENCODING, static_cast<char*>(nullptr));
       break;
     case CompressionType::DEFLATE:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
+      break;
     case CompressionType::GZIP:
-      http_request->CompressInput(request_compression_algorithm);
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
+      break;
+    case CompressionType::ZSTD:
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "zstd");
+      break;
+    case CompressionType::LZ4:
+      break;
+    case CompressionType::AUTO:
+      // Accept all the encodings that libcurl can decode
+      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
       break;
   }
+  // The list is owned by the request and rebuilt when the request is reused
+  curl_easy_setopt(
+      curl, CURLOPT_HTTPHEADER,
+      http_request->BuildHeaderList(headers, content_encoding));
 
-  // Prepare curl
-  if (!query_params.empty()) {
-    request_uri = request_uri + "?" + GetQueryString(query_params);
+  if (verbose_) {
+    std::cout << "inference request: "
+              << std::string(
+                     http_request->RequestJsonBase(),
+                     http_request->RequestJsonSize())
+              << std::endl;
   }
 
-  curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::CompressRequest(
+    const CompressionType type, HttpInferRequest* http_request,
+    CompressionType* applied_type)
+{
+  http_request->auto_compression_ = (type == CompressionType::AUTO);
+  *applied_type = type;
+  if (type == CompressionType::NONE) {
+    return Error::Success;
+  }
+  if (type != CompressionType::AUTO) {
+    // A large gzip body is sent while its later chunks are still compressed
+    if ((type == CompressionType::GZIP) && (compression_pool_ != nullptr) &&
+        (client_options_.compression_chunk_byte_size > 0) &&
+        (http_request->total_input_byte_size_ >
+         client_options_.compression_chunk_byte_size)) {
+      http_request->StartGzipStream(
+          client_options_.compression_level, compression_pool_.get(),
+          client_options_.compression_chunk_byte_size);
+      return Error::Success;
+    }
+    return http_request->CompressInput(
+        type, client_options_.compression_level, compression_pool_.get(),
+        client_options_.compression_chunk_byte_size);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const size_t input_byte_size = http_request->total_input_byte_size_;
+  const CompressionAdvisor::Buffers buffers(
+      http_request->data_buffers_.begin(), http_request->data_buffers_.end());
+  const bool compress =
+      compression_advisor_.ShouldCompress(buffers, input_byte_size);
+  *applied_type = compress ? CompressionType::GZIP : CompressionType::NONE;
+  if (compress) {
+    const auto compression_start = std::chrono::steady_clock::now();
+    Error err = http_request->CompressInput(
+        CompressionType::GZIP, client_options_.compression_level,
+        compression_pool_.get(), client_options_.compression_chunk_byte_size);
+    if (!err.IsOk()) {
+      return err;
+    }
+    compression_advisor_.RecordCompression(
+        input_byte_size,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - compression_start)
+            .count());
+  }
+  const uint64_t time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  UpdateAutoCompressionStat(
+      compress, time_ns, input_byte_size, http_request->total_input_byte_size_);
+  return Error::Success;
+}
+
+Error
+InferenceServerHttpClient::ConfigureEasyHandle(void* vcurl)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_POST, 1L);
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
 
-  if (options.client_timeout_ != 0) {
-    uint64_t timeout_ms = (options.client_timeout_ / 1000);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
-  }
-
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
   }
@@ -1815,156 +3629,342 @@ InferenceServerHttpClient::PreRunProcessing(
 
   // request data provided by InferRequestProvider()
   curl_easy_setopt(curl, CURLOPT_READFUNCTION, InferRequestProvider);
-  curl_easy_setopt(curl, CURLOPT_READDATA, http_request.get());
 
   // response headers handled by InferResponseHeaderHandler()
   curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, InferResponseHeaderHandler);
-  curl_easy_setopt(curl, CURLOPT_HEADERDATA, http_request.get());
 
   // response data handled by InferResponseHandler()
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, InferResponseHandler);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, http_request.get());
 
-  const curl_off_t post_byte_size = http_request->total_input_byte_size_;
-  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, post_byte_size);
+  SetHttpVersionCurlOptions(curl);
+
+  return SetSSLCurlOptions(&curl, ssl_options_);
+}
+
+void
+InferenceServerHttpClient::SetHttpVersionCurlOptions(void* vcurl)
+{
+  if (!client_options_.enable_http2) {
+    return;
+  }
+
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
+  // Negotiate HTTP/2 with ALPN for TLS connections, cleartext connections
+  // can't negotiate so HTTP/2 is used with prior knowledge.
+  if (url_.compare(0, 8, "https://") == 0) {
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+  } else {
+    curl_easy_setopt(
+        curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+  }
+  // Prefer waiting for a connection that can be multiplexed over opening a
+  // new connection.
+  curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+}
+
+Error
+InferenceServerHttpClient::AcquireEasyHandle(void** curl)
+{
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (!easy_handle_pool_.empty()) {
+      *curl = easy_handle_pool_.back();
+      easy_handle_pool_.pop_back();
+      std::lock_guard<std::mutex> stat_lock(stat_mutex_);
+      infer_stat_.handle_pool_reuse_count++;
+      return Error::Success;
+    }
+    if (client_options_.easy_handle_pool_size != 0) {
+      std::lock_guard<std::mutex> stat_lock(stat_mutex_);
+      infer_stat_.handle_pool_exhausted_count++;
+    }
+  }
 
-  err = SetSSLCurlOptions(&curl, ssl_options_);
+  CURL* new_curl = curl_easy_init();
+  if (new_curl == nullptr) {
+    return Error("failed to initialize HTTP client");
+  }
+  Error err = ConfigureEasyHandle(new_curl);
   if (!err.IsOk()) {
+    curl_easy_cleanup(new_curl);
     return err;
   }
 
-  struct curl_slist* list = nullptr;
+  *curl = new_curl;
+  return Error::Success;
+}
+
+void
+InferenceServerHttpClient::ReleaseEasyHandle(void* vcurl)
+{
+  CURL* curl = reinterpret_cast<CURL*>(vcurl);
 
-  std::string infer_hdr{std::string(kInferHeaderContentLengthHTTPHeader) +
-                        ": " +
-                        std::to_string(http_request->request_json_.Size())};
-  list = curl_slist_append(list, infer_hdr.c_str());
-  list = curl_slist_append(list, "Expect:");
-  list = curl_slist_append(list, "Content-Type: application/octet-stream");
-  for (const auto& pr : headers) {
-    std::string hdr = pr.first + ": " + pr.second;
-    list = curl_slist_append(list, hdr.c_str());
+  // The header list is owned by the request and released along with it
+  curl_easy_setopt(
+      curl, CURLOPT_HTTPHEADER, static_cast<struct curl_slist*>(nullptr));
+  {
+    std::lock_guard<std::mutex> lock(easy_handle_pool_mutex_);
+    if (easy_handle_pool_.size() < client_options_.easy_handle_pool_size) {
+      easy_handle_pool_.push_back(vcurl);
+      return;
+    }
   }
+  curl_easy_cleanup(curl);
+}
 
-  // Compress data if requested
-  switch (request_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      list = curl_slist_append(list, "Content-Encoding: deflate");
-      break;
-    case CompressionType::GZIP:
-      list = curl_slist_append(list, "Content-Encoding: gzip");
-      break;
+Error
+InferenceServerHttpClient::StartTransferLoops()
+{
+  std::call_once(transfer_loops_started_, [this] {
+    if (transfer_loops_.empty()) {
+      transfer_loops_status_ =
+          Error("at least one asynchronous transfer thread must be enabled");
+      return;
+    }
+    for (const auto& loop : transfer_loops_) {
+      if (loop->multi_handle == nullptr) {
+        transfer_loops_status_ =
+            Error("failed to start HTTP asynchronous client");
+        return;
+      }
+    }
+    if (client_options_.polling) {
+      return;
+    }
+    for (auto& loop : transfer_loops_) {
+      loop->worker = std::thread(
+          &InferenceServerHttpClient::AsyncTransfer, this, loop.get());
+    }
+  });
+
+  return transfer_loops_status_;
+}
+
+Error
+InferenceServerHttpClient::StartPolling()
+{
+  if (!client_options_.polling) {
+    return Error(
+        "the client must be created with the 'polling' option to process "
+        "its requests");
   }
-  switch (response_compression_algorithm) {
-    case CompressionType::NONE:
-      break;
-    case CompressionType::DEFLATE:
-      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "deflate");
-      break;
-    case CompressionType::GZIP:
-      curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "gzip");
-      break;
+  return StartTransferLoops();
+}
+
+Error
+InferenceServerHttpClient::Poll(
+    const uint64_t timeout_us, size_t* completed_count)
+{
+  Error err = StartPolling();
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  std::lock_guard<std::mutex> lk(poll_mutex_);
+  HttpTransferLoop* loop = transfer_loops_.front().get();
+  size_t count = ProcessTransfers(loop, SIZE_MAX);
+  if ((count == 0) && (timeout_us != 0)) {
+    // curl_multi_poll() is interrupted by the submission of a request, the
+    // timeout is rounded up to whole milliseconds.
+    const int timeout_ms = static_cast<int>(
+        std::min<uint64_t>((timeout_us + 999) / 1000, INT_MAX));
+    int numfds;
+    CURLMcode mc =
+        curl_multi_poll(loop->multi_handle, NULL, 0, timeout_ms, &numfds);
+    if (mc != CURLM_OK) {
+      return Error(
+          "HTTP client failed: " + std::string(curl_multi_strerror(mc)));
+    }
+    count = ProcessTransfers(loop, SIZE_MAX);
+  }
+  if (completed_count != nullptr) {
+    *completed_count = count;
   }
-  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
 
-  // The list will be freed when the request is destructed
-  http_request->header_list_ = list;
+  return Error::Success;
+}
 
-  if (verbose_) {
-    std::cout << "inference request: " << http_request->request_json_.Contents()
-              << std::endl;
+Error
+InferenceServerHttpClient::ProcessCompletions(
+    const size_t max_count, size_t* completed_count)
+{
+  Error err = StartPolling();
+  if (!err.IsOk()) {
+    return err;
+  }
+
+  std::lock_guard<std::mutex> lk(poll_mutex_);
+  const size_t count =
+      ProcessTransfers(transfer_loops_.front().get(), max_count);
+  if (completed_count != nullptr) {
+    *completed_count = count;
   }
 
   return Error::Success;
 }
 
 void
-InferenceServerHttpClient::AsyncTransfer()
+InferenceServerHttpClient::AsyncTransfer(HttpTransferLoop* loop)
+{
+  // With busy polling the connections are only checked, without waiting
+  const int timeout_ms = client_options_.busy_poll ? 0 : INT_MAX;
+  while (!loop->exiting) {
+    ProcessTransfers(loop, SIZE_MAX);
+
+    // Wait for activity on the transfers, a new submission or exit. Unlike
+    // curl_multi_wait(), curl_multi_poll() keeps waiting when there is no
+    // transfer in progress and can be interrupted by curl_multi_wakeup().
+    int numfds;
+    CURLMcode mc =
+        curl_multi_poll(loop->multi_handle, NULL, 0, timeout_ms, &numfds);
+    if (mc != CURLM_OK) {
+      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+                << std::endl;
+    }
+  }
+}
+
+size_t
+InferenceServerHttpClient::ProcessTransfers(
+    HttpTransferLoop* loop, const size_t max_count)
 {
   int place_holder = 0;
   CURLMsg* msg = nullptr;
-  do {
-    std::vector<std::shared_ptr<HttpInferRequest>> request_list;
-
-    // sleep if no work is available
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] {
-      if (this->exiting_) {
-        return true;
+  std::vector<HttpTransferLoop::Submission>& submissions =
+      loop->new_submissions;
+  std::vector<HttpTransferLoop::Cancellation>& cancellations =
+      loop->new_cancellations;
+  std::vector<std::shared_ptr<HttpInferRequest>>& request_list =
+      loop->completed_requests;
+  // The cancellations are taken first, so that the request of each of them
+  // has been submitted.
+  loop->cancellations.PopAll(&cancellations);
+  // Hand the newly submitted requests to the multi handle
+  loop->submissions.PopAll(&submissions);
+  for (auto& submission : submissions) {
+    curl_easy_setopt(
+        submission.first, CURLOPT_PRIVATE,
+        reinterpret_cast<void*>(loop->ongoing_async_requests.size()));
+    curl_multi_add_handle(loop->multi_handle, submission.first);
+    loop->ongoing_async_requests.emplace_back(std::move(submission));
+  }
+  submissions.clear();
+
+  // Abandon the transfers of the cancelled requests that are still ongoing
+  // for the cancelled call, the requests complete as cancelled.
+  auto& ongoing_requests = loop->ongoing_async_requests;
+  for (const auto& cancellation : cancellations) {
+    std::shared_ptr<HttpInferRequest> request = cancellation.first.lock();
+    if (request == nullptr) {
+      continue;
+    }
+    for (size_t index = 0; index < ongoing_requests.size(); ++index) {
+      if ((ongoing_requests[index].second == request) &&
+          (request->call_id_ == cancellation.second)) {
+        HttpTransferLoop::Submission cancelled =
+            loop->TakeOngoingRequest(index);
+        ReleaseEasyHandle(cancelled.first);
+        cancelled.second->cancelled_ = true;
+        request_list.emplace_back(std::move(cancelled.second));
+        break;
       }
-      // wake up if an async request has been generated
-      return !this->ongoing_async_requests_.empty();
-    });
+    }
+  }
+  cancellations.clear();
 
-    CURLMcode mc = curl_multi_perform(multi_handle_, &place_holder);
-    int numfds;
-    if (mc == CURLM_OK) {
-      // Wait for activity. If there are no descripters in the multi_handle_
-      // then curl_multi_wait will return immediately
-      mc = curl_multi_wait(multi_handle_, NULL, 0, INT_MAX, &numfds);
-      if (mc == CURLM_OK) {
-        while ((msg = curl_multi_info_read(multi_handle_, &place_holder))) {
-          uintptr_t identifier = reinterpret_cast<uintptr_t>(msg->easy_handle);
-          auto itr = ongoing_async_requests_.find(identifier);
-          // This shouldn't happen
-          if (itr == ongoing_async_requests_.end()) {
-            std::cerr
-                << "Unexpected error: received completed request that is not "
-                   "in the list of asynchronous requests"
+  // Resume the transfers that may be waiting for a compressed chunk
+  loop->resumptions.PopAll(&loop->new_resumptions);
+  for (const auto& resumption : loop->new_resumptions) {
+    std::shared_ptr<HttpInferRequest> request = resumption.lock();
+    if (request == nullptr) {
+      continue;
+    }
+    for (const auto& ongoing_request : ongoing_requests) {
+      if (ongoing_request.second == request) {
+        curl_easy_pause(ongoing_request.first, CURLPAUSE_CONT);
+        break;
+      }
+    }
+  }
+  loop->new_resumptions.clear();
+
+  CURLMcode mc = curl_multi_perform(loop->multi_handle, &place_holder);
+  if (mc != CURLM_OK) {
+    std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+              << std::endl;
+  }
+
+  // The messages that are not read stay queued in the multi handle for the
+  // next call.
+  while ((request_list.size() < max_count) &&
+         (msg = curl_multi_info_read(loop->multi_handle, &place_holder))) {
+    char* private_data = nullptr;
+    curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &private_data);
+    const size_t index = reinterpret_cast<uintptr_t>(private_data);
+    // This shouldn't happen
+    if ((index >= ongoing_requests.size()) ||
+        (ongoing_requests[index].first != msg->easy_handle)) {
+      std::cerr << "Unexpected error: received completed request that is "
+                   "not in the list of asynchronous requests"
                 << std::endl;
-            curl_multi_remove_handle(multi_handle_, msg->easy_handle);
-            curl_easy_cleanup(msg->easy_handle);
-            continue;
-          }
+      curl_multi_remove_handle(loop->multi_handle, msg->easy_handle);
+      curl_easy_cleanup(msg->easy_handle);
+      continue;
+    }
 
-          long http_code = 400;
-          if (msg->data.result == CURLE_OK) {
-            curl_easy_getinfo(
-                msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
-          } else if (msg->data.result == CURLE_OPERATION_TIMEDOUT) {
-            http_code = 499;
-          }
+    long http_code = 400;
+    if (msg->data.result == CURLE_OK) {
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
+    } else if (msg->data.result == CURLE_OPERATION_TIMEDOUT) {
+      http_code = 499;
+    }
 
-          request_list.emplace_back(itr->second);
-          ongoing_async_requests_.erase(itr);
-          curl_multi_remove_handle(multi_handle_, msg->easy_handle);
-          curl_easy_cleanup(msg->easy_handle);
-
-          std::shared_ptr<HttpInferRequest> async_request = request_list.back();
-          async_request->http_code_ = http_code;
-
-          if (msg->msg != CURLMSG_DONE) {
-            // Something wrong happened.
-            std::cerr << "Unexpected error: received CURLMsg=" << msg->msg
-                      << std::endl;
-          } else {
-            async_request->Timer().CaptureTimestamp(
-                RequestTimers::Kind::REQUEST_END);
-            Error err = UpdateInferStat(async_request->Timer());
-            if (!err.IsOk()) {
-              std::cerr << "Failed to update context stat: " << err
-                        << std::endl;
-            }
-          }
-        }
-      } else {
-        std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
-                  << std::endl;
-      }
-    } else {
-      std::cerr << "Unexpected error: curl_multi failed. Code:" << mc
+    HttpTransferLoop::Submission completed = loop->TakeOngoingRequest(index);
+    ReleaseEasyHandle(completed.first);
+    request_list.emplace_back(std::move(completed.second));
+
+    std::shared_ptr<HttpInferRequest>& async_request = request_list.back();
+    async_request->http_code_ = http_code;
+
+    if (msg->msg != CURLMSG_DONE) {
+      // Something wrong happened.
+      std::cerr << "Unexpected error: received CURLMsg=" << msg->msg
                 << std::endl;
+    } else if (async_request->auto_compression_) {
+      compression_advisor_.RecordTransfer(
+          async_request->total_input_byte_size_,
+          async_request->Timer().Duration(
+              RequestTimers::Kind::SEND_START, RequestTimers::Kind::SEND_END));
     }
-    lock.unlock();
+  }
 
-    for (auto& this_request : request_list) {
-      InferResult* result;
-      InferResultHttp::Create(&result, this_request);
-      this_request->callback_(result);
+  for (auto& this_request : request_list) {
+    // The callback may release the inputs that are still being compressed
+    // if the transfer ended early.
+    this_request->StopGzipStream();
+    // Only the result references the request from here so that the
+    // request can be reused as soon as the result is released. The
+    // request stays valid until the callback releases the result.
+    auto callback = std::move(this_request->callback_);
+    const bool cancelled = this_request->cancelled_;
+    RequestTimers& timer = this_request->Timer();
+    timer.CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_START);
+    InferResult* result;
+    InferResultHttp::Create(&result, std::move(this_request));
+    timer.CaptureTimestamp(RequestTimers::Kind::DESERIALIZE_END);
+    timer.CaptureTimestamp(RequestTimers::Kind::REQUEST_END);
+    // The timers of a cancelled request may not be complete
+    if (!cancelled) {
+      Error err = UpdateInferStat(timer);
+      if (!err.IsOk()) {
+        std::cerr << "Failed to update context stat: " << err << std::endl;
+      }
     }
-  } while (!exiting_);
+    RunCallback(std::move(callback), result);
+  }
+  const size_t completed_count = request_list.size();
+  request_list.clear();
+  return completed_count;
 }
 
 size_t
@@ -2021,6 +4021,7 @@ InferenceServerHttpClient::Get(
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  SetHttpVersionCurlOptions(curl);
   if (verbose_) {
     curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
   }
@@ -2097,6 +4098,7 @@ InferenceServerHttpClient::Post(
   curl_easy_setopt(curl, CURLOPT_URL, request_uri.c_str());
   curl_easy_setopt(curl, CURLOPT_USERAGENT, "libcurl-agent/1.0");
   curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+  SetHttpVersionCurlOptions(curl);
   curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.size());
   curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.c_str());
   if (verbose_) {
@@ -27,6 +27,7 @@
 
 /// \file
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include "common.h"
@@ -35,6 +36,9 @@
 namespace triton { namespace client {
 
 class HttpInferRequest;
+class HttpPreparedInferRequest;
+struct HttpTransferLoop;
+class HttpCompressionPool;
 
 /// The key-value map type to be included in the request
 /// as custom headers.
@@ -86,13 +90,98 @@ struct HttpSslOptions {
   std::string key;
 };
 
+// The options for tuning the transport used by InferenceServerHttpClient.
+struct HttpClientOptions {
+  explicit HttpClientOptions()
+      : easy_handle_pool_size(64), async_transfer_threads(1),
+        enable_http2(false), http2_max_streams_per_connection(0),
+        max_connections(0), compression_level(-1), compression_threads(1),
+        compression_chunk_byte_size(1024 * 1024), polling(false),
+        busy_poll(false)
+  {
+  }
+  // The maximum number of idle curl easy handles kept by the client for
+  // asynchronous requests. The handles are configured once with the options
+  // that do not change between requests and are reused, so that only the
+  // request specific options need to be set per request. When the pool is
+  // exhausted a new handle is created, and a handle returned to a full pool
+  // is released. A value of 0 disables the pool. Default value is 64.
+  size_t easy_handle_pool_size;
+  // The number of threads running the event loops that process asynchronous
+  // requests. Each loop drives its own curl multi handle and the requests are
+  // distributed across the loops in round-robin order. Must be at least 1.
+  // Default value is 1.
+  size_t async_transfer_threads;
+  // Whether to use HTTP/2 for inference requests. For `https://` URLs the
+  // protocol is negotiated with ALPN and the client falls back to HTTP/1.1 if
+  // the server does not support HTTP/2. Otherwise HTTP/2 is used with prior
+  // knowledge (h2c), so the server must accept HTTP/2 over cleartext. With
+  // HTTP/2 the concurrent asynchronous requests are multiplexed as streams
+  // over a few connections instead of requiring one connection per request.
+  // Requires libcurl built with HTTP/2 support. Default value is false.
+  bool enable_http2;
+  // The maximum number of concurrent HTTP/2 streams on a connection, a new
+  // connection is opened when the existing connections have reached this
+  // limit. A value of 0 means the libcurl default, which is 100. Only used
+  // when 'enable_http2' is true. See here for more details:
+  // https://curl.se/libcurl/c/CURLMOPT_MAX_CONCURRENT_STREAMS.html
+  long http2_max_streams_per_connection;
+  // The maximum number of connections used by each asynchronous transfer
+  // thread, requests are queued when the limit is reached. A value of 0 means
+  // no limit. See here for more details:
+  // https://curl.se/libcurl/c/CURLMOPT_MAX_TOTAL_CONNECTIONS.html
+  long max_connections;
+  // The level used to compress request bodies, higher levels compress better
+  // but slower. The range depends on the algorithm: 0-9 for DEFLATE and GZIP,
+  // 1-22 for ZSTD and 0-12 for LZ4. A value of -1 selects the default level
+  // of the algorithm. Default value is -1.
+  int compression_level;
+  // The number of threads compressing GZIP request bodies in parallel. When
+  // greater than 1, a body larger than 'compression_chunk_byte_size' is split
+  // into chunks that are compressed concurrently and joined into a single
+  // gzip stream, so the server sees the same format as from a serial
+  // compression. The chunks are sent as soon as they and the chunks before
+  // them are compressed, with chunked transfer encoding as the compressed
+  // size is not known up front. AUTO compression still compresses the whole
+  // body before sending it. Otherwise the body is compressed on the calling
+  // thread. Default value is 1.
+  size_t compression_threads;
+  // The size of the chunks of a request body compressed in parallel, see
+  // 'compression_threads'. Smaller chunks spread the work over more threads
+  // at a small cost in compression ratio. Default value is 1 MB.
+  size_t compression_chunk_byte_size;
+  // The executor running the callbacks of the asynchronous requests, see
+  // CallbackExecutor. When not set the callbacks run on the transfer
+  // threads and a slow callback delays the other requests of its thread.
+  // The executor may be shared with other clients. Default value is null.
+  std::shared_ptr<CallbackExecutor> callback_executor;
+  // Whether the asynchronous requests are processed by the application
+  // calling Poll() or ProcessCompletions() instead of by transfer threads
+  // owned by the client. A single event loop is used whatever the value of
+  // 'async_transfer_threads', and the callbacks run on the polling thread
+  // unless 'callback_executor' is set. The requests still in progress when
+  // the client is destroyed are dropped without running their callbacks.
+  // InferMulti() then sends its requests one after another since nothing
+  // drives them while it waits. Default value is false.
+  bool polling;
+  // Whether the transfer threads poll the connections without waiting
+  // instead of sleeping until there is activity. This avoids the latency of
+  // waking up the thread for each response at the cost of keeping a core
+  // busy per transfer thread. Not used in polling mode. Default value is
+  // false.
+  bool busy_poll;
+};
+
 //==============================================================================
 /// An InferenceServerHttpClient object is used to perform any kind of
-/// communication with the InferenceServer using HTTP protocol. None
-/// of the methods of InferenceServerHttpClient are thread safe. The
-/// class is intended to be used by a single thread and simultaneously
-/// calling different methods with different threads is not supported
-/// and will cause undefined behavior.
+/// communication with the InferenceServer using HTTP protocol. The
+/// inference methods (Infer, AsyncInfer, InferMulti and AsyncInferMulti)
+/// and ClientInferStat can be called from any number of threads at once,
+/// each call uses its own request state and connection handle. A
+/// PreparedInferRequest must not be used by different threads at the same
+/// time. The other methods are not thread safe and simultaneously calling
+/// them with different threads is not supported and will cause undefined
+/// behavior.
 ///
 /// \code
 ///   std::unique_ptr<InferenceServerHttpClient> client;
@@ -105,7 +194,18 @@ struct HttpSslOptions {
 ///
 class InferenceServerHttpClient : public InferenceServerClient {
  public:
-  enum class CompressionType { NONE, DEFLATE, GZIP };
+  /// The compression algorithms of the request and response bodies. ZSTD is
+  /// only available if the client is built with TRITON_ENABLE_ZSTD and LZ4
+  /// only if it is built with TRITON_ENABLE_LZ4, otherwise the request fails.
+  /// LZ4 has no standard HTTP content coding, it is sent as the 'lz4' coding
+  /// holding an LZ4 frame and can only be used for requests. With AUTO the
+  /// client decides for each request whether to compress it with GZIP or to
+  /// send it uncompressed, from the size of the request, an estimate of its
+  /// compressibility from samples of the data, and the compression and
+  /// transfer throughput observed for the recent requests. The decisions are
+  /// reported in InferStat. For the response, AUTO accepts every encoding
+  /// supported by libcurl.
+  enum class CompressionType { NONE, DEFLATE, GZIP, ZSTD, LZ4, AUTO };
   ~InferenceServerHttpClient();
 
   /// Generate a request body for inference using the supplied 'inputs' and
@@ -150,11 +250,14 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// The use of SSL/TLS depends entirely on the server endpoint.
   /// These options will be ignored if the server_url does not
   /// expose `https://` scheme.
+  /// \param client_options Specifies the settings for tuning the
+  /// transport used by the client.
   /// \return Error object indicating success or failure.
   static Error Create(
       std::unique_ptr<InferenceServerHttpClient>* client,
       const std::string& server_url, bool verbose = false,
-      const HttpSslOptions& ssl_options = HttpSslOptions());
+      const HttpSslOptions& ssl_options = HttpSslOptions(),
+      const HttpClientOptions& client_options = HttpClientOptions());
 
   /// Contact the inference server and get its liveness.
   /// \param live Returns whether the server is live or not.
@@ -454,12 +557,12 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
   /// request.
   Error Infer(
@@ -498,12 +601,12 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInfer(
@@ -518,8 +621,112 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType response_compression_algorithm =
           CompressionType::NONE);
 
-  /// Run multiple synchronous inferences on server.
-  /// \param results Returns the results of the inferences.
+  /// Run asynchronous inference on server and return a handle to cancel the
+  /// request, see CancelHandle. A cancelled request releases its easy handle
+  /// and connection right away and is not recorded in the statistics. See
+  /// the other AsyncInfer() for the other parameters.
+  /// \param cancel_handle Returns the handle to cancel the request.
+  /// \return Error object indicating success or failure of the request.
+  Error AsyncInfer(
+      std::shared_ptr<CancelHandle>* cancel_handle, OnCompleteFn callback,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>(),
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Prepare an inference request that can be issued repeatedly with
+  /// Infer() or AsyncInfer(). The request JSON is serialized once, only
+  /// the parts that may change between requests are written when the
+  /// request is issued. See PreparedInferRequest for the changes allowed
+  /// between requests.
+  /// \param request Returns the prepared request.
+  /// \param options The options for inference request.
+  /// \param inputs The vector of InferInput describing the model inputs.
+  /// \param outputs The vector of InferRequestedOutput describing how the
+  /// output must be returned. If not provided then all the outputs in the
+  /// model config will be returned as default settings.
+  /// \return Error object indicating success or failure.
+  Error PrepareInferRequest(
+      std::unique_ptr<PreparedInferRequest>* request,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs =
+          std::vector<const InferRequestedOutput*>());
+
+  /// Run synchronous inference on server using a prepared request.
+  /// \param result Returns the result of inference.
+  /// \param request The request prepared by PrepareInferRequest() of this
+  /// client.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in request.
+  /// \param query_params Optional map specifying parameters that must be
+  /// included with URL query.
+  /// \param request_compression_algorithm Optional HTTP compression algorithm
+  /// to use for the request body on client side. Currently supports DEFLATE,
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
+  /// \param response_compression_algorithm Optional HTTP compression algorithm
+  /// to request for the response body. Note that the response may not be
+  /// compressed if the server does not support the specified algorithm.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error Infer(
+      InferResult** result, PreparedInferRequest* request,
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Run asynchronous inference on server using a prepared request. See
+  /// the other AsyncInfer() for the handling of the callback and the input
+  /// buffers. Once as many calls have completed as are in flight at the same
+  /// time, the request state, connection handle, URI, header list and the
+  /// memory of the result are reused, so neither this call nor the deletion
+  /// of its result allocates with operator new on the calling thread if the
+  /// request has no query parameters, no output with a buffer provided by
+  /// the caller and is not compressed. The allocations
+  /// that remain happen elsewhere: libcurl allocates with malloc, and the
+  /// response JSON is parsed into TritonJson values, which allocate, on the
+  /// thread that completes the request.
+  /// \param callback The callback function to be invoked on request completion.
+  /// \param request The request prepared by PrepareInferRequest() of this
+  /// client.
+  /// \param headers Optional map specifying additional HTTP headers to include
+  /// in request.
+  /// \param query_params Optional map specifying parameters that must be
+  /// included with URL query.
+  /// \param request_compression_algorithm Optional HTTP compression algorithm
+  /// to use for the request body on client side. Currently supports DEFLATE,
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
+  /// \param response_compression_algorithm Optional HTTP compression algorithm
+  /// to request for the response body. Note that the response may not be
+  /// compressed if the server does not support the specified algorithm.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
+  /// \return Error object indicating success or failure of the
+  /// request.
+  Error AsyncInfer(
+      OnCompleteFn callback, PreparedInferRequest* request,
+      const Headers& headers = Headers(),
+      const Parameters& query_params = Parameters(),
+      const CompressionType request_compression_algorithm =
+          CompressionType::NONE,
+      const CompressionType response_compression_algorithm =
+          CompressionType::NONE);
+
+  /// Run multiple synchronous inferences on server. All the requests are
+  /// sent concurrently and the call blocks until every response is received,
+  /// so the function must not be called from within a callback of this
+  /// client. In 'polling' mode the requests are sent one after another.
+  /// \param results Returns the results of the inferences, one per request
+  /// in the order of 'inputs', including the results of failed requests.
   /// \param options The options for each inference request, one set of
   /// options may be provided and it will be used for all inference requests.
   /// \param inputs The vector of InferInput objects describing the model inputs
@@ -534,14 +741,14 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success or failure of the
-  /// request.
+  /// requests, the error of the first failed request is returned.
   Error InferMulti(
       std::vector<InferResult*>* results,
       const std::vector<InferOptions>& options,
@@ -583,12 +790,12 @@ class InferenceServerHttpClient : public InferenceServerClient {
   /// included with URL query.
   /// \param request_compression_algorithm Optional HTTP compression algorithm
   /// to use for the request body on client side. Currently supports DEFLATE,
-  /// GZIP and NONE. By default, no compression is used.
+  /// GZIP, ZSTD, LZ4, AUTO and NONE. By default, no compression is used.
   /// \param response_compression_algorithm Optional HTTP compression algorithm
   /// to request for the response body. Note that the response may not be
   /// compressed if the server does not support the specified algorithm.
-  /// Currently supports DEFLATE, GZIP and NONE. By default, no compression
-  /// is used.
+  /// Currently supports DEFLATE, GZIP, ZSTD, AUTO and NONE. By default, no
+  /// compression is used.
   /// \return Error object indicating success
   /// or failure of the request.
   Error AsyncInferMulti(
@@ -603,19 +810,97 @@ class InferenceServerHttpClient : public InferenceServerClient {
       const CompressionType response_compression_algorithm =
           CompressionType::NONE);
 
+  /// Process the asynchronous requests of a client created with the
+  /// 'polling' option, waiting up to 'timeout_us' for activity if no
+  /// request is completed right away. The transfers are driven and the
+  /// callbacks of the completed requests are run, on the calling thread
+  /// unless a callback executor is set. The calls are serialized, so only
+  /// one thread processes the requests at a time, and must not be made from
+  /// the callbacks.
+  /// \param timeout_us The maximum time to wait, in microseconds. A value of
+  /// 0 returns without waiting. The call may return before the timeout when
+  /// there is activity on the transfers even if no request is completed.
+  /// \param completed_count Optional, returns the number of completed
+  /// requests whose callback was run.
+  /// \return Error object indicating success or failure.
+  Error Poll(const uint64_t timeout_us, size_t* completed_count = nullptr);
+
+  /// Process the asynchronous requests of a client created with the
+  /// 'polling' option without waiting, completing at most 'max_count'
+  /// requests. The remaining completed requests are returned by the next
+  /// call. The requests cancelled since the last call are completed in
+  /// addition. See Poll() for how the requests are processed.
+  /// \param max_count The maximum number of requests to complete.
+  /// \param completed_count Optional, returns the number of completed
+  /// requests whose callback was run.
+  /// \return Error object indicating success or failure.
+  Error ProcessCompletions(
+      const size_t max_count, size_t* completed_count = nullptr);
+
  private:
   InferenceServerHttpClient(
-      const std::string& url, bool verbose, const HttpSslOptions& ssl_options);
+      const std::string& url, bool verbose, const HttpSslOptions& ssl_options,
+      const HttpClientOptions& client_options);
+
+  // Set the curl options that are the same for all inference requests.
+  Error ConfigureEasyHandle(void* curl);
+  // Set the curl options for the protocol version selected by the client
+  // options.
+  void SetHttpVersionCurlOptions(void* curl);
+  // Get a configured easy handle from the pool, a new handle is created
+  // if the pool is empty.
+  Error AcquireEasyHandle(void** curl);
+  // Return the easy handle to the pool, the handle is released if the pool
+  // is full.
+  void ReleaseEasyHandle(void* curl);
+
+  // Run the inference, the request JSON is written from 'prepared' if
+  // provided, otherwise it is serialized from 'options', 'inputs' and
+  // 'outputs'.
+  Error DoInfer(
+      InferResult** result, const std::string& request_uri,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const HttpPreparedInferRequest* prepared, const Headers& headers,
+      const Parameters& query_params,
+      const CompressionType request_compression_algorithm,
+      const CompressionType response_compression_algorithm);
+  Error DoAsyncInfer(
+      OnCompleteFn callback, const std::string& request_uri,
+      const InferOptions& options, const std::vector<InferInput*>& inputs,
+      const std::vector<const InferRequestedOutput*>& outputs,
+      const HttpPreparedInferRequest* prepared, const Headers& headers,
+      const Parameters& query_params,
+      const CompressionType request_compression_algorithm,
+      const CompressionType response_compression_algorithm,
+      std::shared_ptr<CancelHandle>* cancel_handle);
+  // Check that 'request' was prepared by this client.
+  Error ValidatePreparedRequest(
+      PreparedInferRequest* request, HttpPreparedInferRequest** prepared);
 
   Error PreRunProcessing(
-      void* curl, std::string& request_uri, const InferOptions& options,
+      void* curl, const std::string& request_uri, const InferOptions& options,
       const std::vector<InferInput*>& inputs,
       const std::vector<const InferRequestedOutput*>& outputs,
-      const Headers& headers, const Parameters& query_params,
+      const HttpPreparedInferRequest* prepared, const Headers& headers,
+      const Parameters& query_params,
       const CompressionType request_compression_algorithm,
       const CompressionType response_compression_algorithm,
       std::shared_ptr<HttpInferRequest>& request);
-  void AsyncTransfer();
+  // Compress the input data of 'http_request' with 'type', AUTO is resolved
+  // to GZIP or NONE. 'applied_type' returns the compression used.
+  Error CompressRequest(
+      const CompressionType type, HttpInferRequest* http_request,
+      CompressionType* applied_type);
+  // Start the event loop threads if they are not started yet, no thread is
+  // started in polling mode.
+  Error StartTransferLoops();
+  void AsyncTransfer(HttpTransferLoop* loop);
+  // Drive the transfers of 'loop' without waiting and complete at most
+  // 'max_count' requests. Return the number of completed requests.
+  size_t ProcessTransfers(HttpTransferLoop* loop, const size_t max_count);
+  // Check that the client is in polling mode and start its event loop.
+  Error StartPolling();
   Error Get(
       std::string& request_uri, const Headers& headers,
       const Parameters& query_params, std::string* response,
@@ -638,15 +923,38 @@ class InferenceServerHttpClient : public InferenceServerClient {
   const std::string url_;
   // The options for authorizing and authenticating SSL/TLS connections
   HttpSslOptions ssl_options_;
+  // The options for tuning the transport
+  HttpClientOptions client_options_;
 
-  using AsyncReqMap = std::map<uintptr_t, std::shared_ptr<HttpInferRequest>>;
-  // curl easy handle shared for all synchronous requests
+  // curl easy handle shared for all synchronous requests, a synchronous
+  // request that finds it in use by another thread takes a handle from
+  // 'easy_handle_pool_' instead
   void* easy_handle_;
-  // curl multi handle for processing asynchronous requests
-  void* multi_handle_;
-  // map to record ongoing asynchronous requests with pointer to easy handle
-  // or tag id as key
-  AsyncReqMap ongoing_async_requests_;
+  std::mutex easy_handle_mutex_;
+  // event loops for processing asynchronous requests, the loop threads are
+  // started on the first asynchronous request. The loops are shared with
+  // the cancel handles of their requests.
+  std::vector<std::shared_ptr<HttpTransferLoop>> transfer_loops_;
+  std::once_flag transfer_loops_started_;
+  Error transfer_loops_status_;
+  // Serializes Poll() and ProcessCompletions() in polling mode, which act as
+  // the loop thread.
+  std::mutex poll_mutex_;
+  // index used for distributing requests across 'transfer_loops_'
+  std::atomic<size_t> next_transfer_loop_;
+  // idle easy handles that can be reused by asynchronous requests
+  std::vector<void*> easy_handle_pool_;
+  // Guards 'easy_handle_pool_' which is accessed by the submitting threads
+  // and the event loop threads.
+  std::mutex easy_handle_pool_mutex_;
+  // state of completed requests that can be reused once their results are
+  // released
+  SharedObjectPool<HttpInferRequest> request_pool_;
+  // threads compressing request bodies in parallel, only created if more
+  // than one compression thread is requested
+  std::unique_ptr<HttpCompressionPool> compression_pool_;
+  // decides the compression of the requests with AUTO compression
+  CompressionAdvisor compression_advisor_;
 };
 
 }}  // namespace triton::client
@@ -0,0 +1,169 @@
+// Copyright 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+/// \file
+/// Awaitable inference for C++20 coroutines, over the AsyncInfer() of
+/// InferenceServerHttpClient and InferenceServerGrpcClient. The header is
+/// optional and only defines the API when compiled with coroutine
+/// support, the client libraries themselves only require C++11.
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define TRITON_CLIENT_ENABLE_COROUTINES
+#endif
+#endif
+
+#ifdef TRITON_CLIENT_ENABLE_COROUTINES
+
+#include <coroutine>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common.h"
+
+namespace triton { namespace client {
+
+typedef std::map<std::string, std::string> Headers;
+
+//==============================================================================
+/// An asynchronous inference awaited by a coroutine, see InferAsync(). The
+/// request is sent when the coroutine suspends, and the coroutine is
+/// resumed by the completion callback of the request. So it resumes on the
+/// thread completing the request, or on the callback executor of the
+/// client if one is set. No future is involved, the awaiter keeps a copy
+/// of the outputs and headers, which only allocates if they are not empty.
+/// The options and inputs are referenced and must stay valid until the
+/// co_await of the awaiter returns.
+///
+template <typename Client>
+class InferAwaiter {
+ public:
+  InferAwaiter(
+      Client* client, InferResult** result, const InferOptions& options,
+      const std::vector<InferInput*>& inputs,
+      std::vector<const InferRequestedOutput*> outputs, Headers headers)
+      : client_(client), result_(result), options_(options), inputs_(inputs),
+        outputs_(std::move(outputs)), headers_(std::move(headers)),
+        completed_result_(nullptr)
+  {
+  }
+
+  InferAwaiter(const InferAwaiter&) = delete;
+  InferAwaiter& operator=(const InferAwaiter&) = delete;
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    // The request may complete and resume the coroutine before AsyncInfer()
+    // returns, after which the awaiter may be destroyed. So it is only
+    // accessed again if the request failed to be sent.
+    Error err = client_->AsyncInfer(
+        [this, handle](InferResult* result) {
+          completed_result_ = result;
+          handle.resume();
+        },
+        options_, inputs_, outputs_, headers_);
+    if (!err.IsOk()) {
+      err_ = err;
+      return false;
+    }
+    return true;
+  }
+
+  /// \return The error of sending the request, or else the status of the
+  /// request like the return value of Infer().
+  Error await_resume()
+  {
+    if (!err_.IsOk()) {
+      return err_;
+    }
+    *result_ = completed_result_;
+    return completed_result_->RequestStatus();
+  }
+
+ private:
+  Client* client_;
+  InferResult** result_;
+  // The options and inputs are referenced, the caller keeps them valid
+  // until the co_await returns. The outputs and headers are copied since
+  // their defaults are temporaries of the InferAsync() call, which are
+  // destroyed before the awaiter is awaited when it is stored first.
+  const InferOptions& options_;
+  const std::vector<InferInput*>& inputs_;
+  const std::vector<const InferRequestedOutput*> outputs_;
+  const Headers headers_;
+  InferResult* completed_result_;
+  Error err_;
+};
+
+/// Run an asynchronous inference from a coroutine, the awaitable version of
+/// Infer():
+///
+///   InferResult* result;
+///   Error err = co_await InferAsync(client, &result, options, inputs);
+///
+/// \param client The InferenceServerHttpClient or InferenceServerGrpcClient
+/// to send the request with.
+/// \param result Returns the result of inference, owned by the caller. Only
+/// set if the request could be sent.
+/// The awaitable may also be stored and awaited later, the options and
+/// inputs must then stay valid until its co_await returns:
+///
+///   auto infer = InferAsync(client, &result, options, inputs);
+///   Error err = co_await infer;
+///
+/// \param options The options for the inference request, referenced by
+/// the awaitable.
+/// \param inputs The vector of InferInput describing the model inputs,
+/// referenced by the awaitable.
+/// \param outputs Optional vector of InferRequestedOutput describing how
+/// the output must be returned. If not provided then all the outputs in
+/// the model config will be returned as default settings. Copied by the
+/// awaitable.
+/// \param headers Optional map specifying additional HTTP headers to
+/// include in the request. Copied by the awaitable.
+/// \return An awaitable whose co_await returns an Error object indicating
+/// success or failure of the request.
+template <typename Client>
+InferAwaiter<Client>
+InferAsync(
+    Client* client, InferResult** result, const InferOptions& options,
+    const std::vector<InferInput*>& inputs,
+    std::vector<const InferRequestedOutput*> outputs =
+        std::vector<const InferRequestedOutput*>(),
+    Headers headers = Headers())
+{
+  return InferAwaiter<Client>(
+      client, result, options, inputs, std::move(outputs),
+      std::move(headers));
+}
+
+}}  // namespace triton::client
+
+#endif  // TRITON_CLIENT_ENABLE_COROUTINES
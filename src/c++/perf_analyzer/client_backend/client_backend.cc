@@ -114,6 +114,7 @@ Error
 ClientBackendFactory::Create(
     const BackendKind kind, const std::string& url, const ProtocolType protocol,
     const SslOptionsBase& ssl_options,
+    const TransportOptionsBase& transport_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const GrpcCompressionAlgorithm compression_algorithm,
     std::shared_ptr<Headers> http_headers,
@@ -123,9 +124,9 @@ ClientBackendFactory::Create(
     std::shared_ptr<ClientBackendFactory>* factory)
 {
   factory->reset(new ClientBackendFactory(
-      kind, url, protocol, ssl_options, trace_options, compression_algorithm,
-      http_headers, triton_server_path, model_repository_path, verbose,
-      metrics_url));
+      kind, url, protocol, ssl_options, transport_options, trace_options,
+      compression_algorithm, http_headers, triton_server_path,
+      model_repository_path, verbose, metrics_url));
   return Error::Success;
 }
 
@@ -134,7 +135,7 @@ ClientBackendFactory::CreateClientBackend(
     std::unique_ptr<ClientBackend>* client_backend)
 {
   RETURN_IF_CB_ERROR(ClientBackend::Create(
-      kind_, url_, protocol_, ssl_options_, trace_options_,
+      kind_, url_, protocol_, ssl_options_, transport_options_, trace_options_,
       compression_algorithm_, http_headers_, verbose_, triton_server_path,
       model_repository_path_, metrics_url_, client_backend));
   return Error::Success;
@@ -146,6 +147,12 @@ ClientBackendFactory::Kind()
   return kind_;
 }
 
+const TransportOptionsBase&
+ClientBackendFactory::TransportOptions() const
+{
+  return transport_options_;
+}
+
 //
 // ClientBackend
 //
@@ -153,6 +160,7 @@ Error
 ClientBackend::Create(
     const BackendKind kind, const std::string& url, const ProtocolType protocol,
     const SslOptionsBase& ssl_options,
+    const TransportOptionsBase& transport_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const GrpcCompressionAlgorithm compression_algorithm,
     std::shared_ptr<Headers> http_headers, const bool verbose,
@@ -163,7 +171,7 @@ ClientBackend::Create(
   std::unique_ptr<ClientBackend> local_backend;
   if (kind == TRITON) {
     RETURN_IF_CB_ERROR(tritonremote::TritonClientBackend::Create(
-        url, protocol, ssl_options, trace_options,
+        url, protocol, ssl_options, transport_options, trace_options,
         BackendToGrpcType(compression_algorithm), http_headers, verbose,
         metrics_url, &local_backend));
   }
@@ -163,10 +163,19 @@ struct InferStat {
   /// response is completely received.
   uint64_t cumulative_receive_time_ns;
 
+  /// The phases of the client library overhead, only reported by the
+  /// Triton client library.
+  uint64_t cumulative_serialize_time_ns;
+  uint64_t cumulative_enqueue_time_ns;
+  uint64_t cumulative_deserialize_time_ns;
+  uint64_t cumulative_callback_time_ns;
+
   /// Create a new InferStat object with zero-ed statistics.
   InferStat()
       : completed_request_count(0), cumulative_total_request_time_ns(0),
-        cumulative_send_time_ns(0), cumulative_receive_time_ns(0)
+        cumulative_send_time_ns(0), cumulative_receive_time_ns(0),
+        cumulative_serialize_time_ns(0), cumulative_enqueue_time_ns(0),
+        cumulative_deserialize_time_ns(0), cumulative_callback_time_ns(0)
   {
   }
 };
@@ -198,7 +207,7 @@ struct InferOptions {
   explicit InferOptions(const std::string& model_name)
       : model_name_(model_name), model_version_(""), request_id_(""),
         sequence_id_(0), sequence_id_str_(""), sequence_start_(false),
-        sequence_end_(false)
+        sequence_end_(false), triton_enable_empty_final_response_(false)
   {
   }
   /// The name of the model to run inference.
@@ -227,6 +236,10 @@ struct InferOptions {
   /// sequence. Default value is False. This argument is ignored if
   /// 'sequence_id' is 0.
   bool sequence_end_;
+  /// Whether the server sends an empty final response when a decoupled
+  /// model completes a request without a response. Only used by the Triton
+  /// backend. Default value is False.
+  bool triton_enable_empty_final_response_;
 };
 
 struct SslOptionsBase {
@@ -243,6 +256,23 @@ struct SslOptionsBase {
   std::string ssl_https_private_key_type = "";
 };
 
+struct TransportOptionsBase {
+  // Use HTTP/2 instead of HTTP/1.1 for the HTTP protocol
+  bool http_use_http2 = false;
+  // The number of completion queues, each served by its own thread, used by
+  // the gRPC client for asynchronous requests
+  size_t grpc_completion_queue_count = 1;
+  // The number of channels, each with its own connection, used by the gRPC
+  // client for inference requests
+  size_t grpc_channel_count = 1;
+  // Whether the gRPC client sends each inference request over the channel
+  // with the fewest outstanding requests instead of round robin
+  bool grpc_channel_least_outstanding = false;
+  // Whether the completions of asynchronous requests are busy polled
+  // instead of waited for, by the client threads and the worker threads
+  bool busy_poll = false;
+};
+
 //
 // The object factory to create client backends to communicate with the
 // inference service
@@ -254,6 +284,8 @@ class ClientBackendFactory {
   /// \param url The inference server url and port.
   /// \param protocol The protocol type used.
   /// \param ssl_options The SSL options used with client backend.
+  /// \param transport_options The options for tuning the transport used
+  /// with client backend.
   /// \param compression_algorithm The compression algorithm to be used
   /// on the grpc requests.
   /// \param http_headers Map of HTTP headers. The map key/value
@@ -271,6 +303,7 @@ class ClientBackendFactory {
   static Error Create(
       const BackendKind kind, const std::string& url,
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
+      const TransportOptionsBase& transport_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
       std::shared_ptr<Headers> http_headers,
@@ -281,6 +314,9 @@ class ClientBackendFactory {
 
   const BackendKind& Kind();
 
+  /// Get the options for tuning the transport of the client backends.
+  const TransportOptionsBase& TransportOptions() const;
+
   /// Create a ClientBackend.
   /// \param backend Returns a new Client backend object.
   virtual Error CreateClientBackend(std::unique_ptr<ClientBackend>* backend);
@@ -289,6 +325,7 @@ class ClientBackendFactory {
   ClientBackendFactory(
       const BackendKind kind, const std::string& url,
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
+      const TransportOptionsBase& transport_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
       const std::shared_ptr<Headers> http_headers,
@@ -296,7 +333,7 @@ class ClientBackendFactory {
       const std::string& model_repository_path, const bool verbose,
       const std::string& metrics_url)
       : kind_(kind), url_(url), protocol_(protocol), ssl_options_(ssl_options),
-        trace_options_(trace_options),
+        transport_options_(transport_options), trace_options_(trace_options),
         compression_algorithm_(compression_algorithm),
         http_headers_(http_headers), triton_server_path(triton_server_path),
         model_repository_path_(model_repository_path), verbose_(verbose),
@@ -308,6 +345,7 @@ class ClientBackendFactory {
   const std::string url_;
   const ProtocolType protocol_;
   const SslOptionsBase& ssl_options_;
+  const TransportOptionsBase transport_options_;
   const std::map<std::string, std::vector<std::string>> trace_options_;
   const GrpcCompressionAlgorithm compression_algorithm_;
   std::shared_ptr<Headers> http_headers_;
@@ -322,6 +360,7 @@ class ClientBackendFactory {
   ClientBackendFactory()
       : kind_(BackendKind()), url_(""), protocol_(ProtocolType()),
         ssl_options_(SslOptionsBase()),
+        transport_options_(TransportOptionsBase()),
         trace_options_(std::map<std::string, std::vector<std::string>>()),
         compression_algorithm_(GrpcCompressionAlgorithm()), verbose_(false)
   {
@@ -337,6 +376,7 @@ class ClientBackend {
   static Error Create(
       const BackendKind kind, const std::string& url,
       const ProtocolType protocol, const SslOptionsBase& ssl_options,
+      const TransportOptionsBase& transport_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const GrpcCompressionAlgorithm compression_algorithm,
       std::shared_ptr<Headers> http_headers, const bool verbose,
@@ -603,6 +643,26 @@ class InferResult {
   virtual Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const = 0;
+
+  /// Get whether this is the final response of its request. Only decoupled
+  /// models send more than one response per request.
+  /// \param is_final_response Returns true if this is the final response.
+  /// \return Error object indicating success or failure.
+  virtual Error IsFinalResponse(bool* is_final_response) const
+  {
+    *is_final_response = true;
+    return Error::Success;
+  }
+
+  /// Get whether this is an empty response that only flags the completion
+  /// of its request.
+  /// \param is_null_response Returns true if the response is empty.
+  /// \return Error object indicating success or failure.
+  virtual Error IsNullResponse(bool* is_null_response) const
+  {
+    *is_null_response = false;
+    return Error::Success;
+  }
 };
 
 }}}  // namespace triton::perfanalyzer::clientbackend
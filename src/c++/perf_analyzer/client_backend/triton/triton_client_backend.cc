@@ -64,6 +64,34 @@ ParseHttpSslOptions(
   return http_ssl_options;
 }
 
+triton::client::HttpClientOptions
+ParseHttpClientOptions(
+    const triton::perfanalyzer::clientbackend::TransportOptionsBase&
+        transport_options)
+{
+  triton::client::HttpClientOptions http_client_options;
+  http_client_options.enable_http2 = transport_options.http_use_http2;
+  http_client_options.busy_poll = transport_options.busy_poll;
+  return http_client_options;
+}
+
+triton::client::GrpcClientOptions
+ParseGrpcClientOptions(
+    const triton::perfanalyzer::clientbackend::TransportOptionsBase&
+        transport_options)
+{
+  triton::client::GrpcClientOptions grpc_client_options;
+  grpc_client_options.completion_queue_count =
+      transport_options.grpc_completion_queue_count;
+  grpc_client_options.channel_count = transport_options.grpc_channel_count;
+  if (transport_options.grpc_channel_least_outstanding) {
+    grpc_client_options.channel_selection = triton::client::
+        GrpcClientOptions::ChannelSelection::LEAST_OUTSTANDING;
+  }
+  grpc_client_options.busy_poll = transport_options.busy_poll;
+  return grpc_client_options;
+}
+
 std::pair<bool, triton::client::SslOptions>
 ParseGrpcSslOptions(
     const triton::perfanalyzer::clientbackend::SslOptionsBase& ssl_options)
@@ -90,6 +118,7 @@ Error
 TritonClientBackend::Create(
     const std::string& url, const ProtocolType protocol,
     const SslOptionsBase& ssl_options,
+    const TransportOptionsBase& transport_options,
     const std::map<std::string, std::vector<std::string>> trace_options,
     const grpc_compression_algorithm compression_algorithm,
     std::shared_ptr<Headers> http_headers, const bool verbose,
@@ -102,9 +131,11 @@ TritonClientBackend::Create(
   if (protocol == ProtocolType::HTTP) {
     triton::client::HttpSslOptions http_ssl_options =
         ParseHttpSslOptions(ssl_options);
+    triton::client::HttpClientOptions http_client_options =
+        ParseHttpClientOptions(transport_options);
     RETURN_IF_TRITON_ERROR(tc::InferenceServerHttpClient::Create(
         &(triton_client_backend->client_.http_client_), url, verbose,
-        http_ssl_options));
+        http_ssl_options, http_client_options));
     if (!trace_options.empty()) {
       std::string response;
       RETURN_IF_TRITON_ERROR(
@@ -116,9 +147,12 @@ TritonClientBackend::Create(
         ParseGrpcSslOptions(ssl_options);
     bool use_ssl = grpc_ssl_options_pair.first;
     triton::client::SslOptions grpc_ssl_options = grpc_ssl_options_pair.second;
+    triton::client::GrpcClientOptions grpc_client_options =
+        ParseGrpcClientOptions(transport_options);
     RETURN_IF_TRITON_ERROR(tc::InferenceServerGrpcClient::Create(
         &(triton_client_backend->client_.grpc_client_), url, verbose, use_ssl,
-        grpc_ssl_options));
+        grpc_ssl_options, tc::KeepAliveOptions(),
+        true /* use_cached_channel */, grpc_client_options));
     if (!trace_options.empty()) {
       inference::TraceSettingResponse response;
       RETURN_IF_TRITON_ERROR(
@@ -295,9 +329,14 @@ TritonClientBackend::StartStream(OnCompleteFn callback, bool enable_stats)
   };
 
   if (protocol_ == ProtocolType::GRPC) {
-    RETURN_IF_TRITON_ERROR(client_.grpc_client_->StartStream(
-        wrapped_callback, enable_stats, 0 /* stream_timeout */, *http_headers_,
-        compression_algorithm_));
+    // The requests are written by the client so that a stalled stream
+    // doesn't block the worker issuing the requests.
+    tc::GrpcStreamOptions stream_options;
+    stream_options.enable_stats = enable_stats;
+    stream_options.headers = *http_headers_;
+    stream_options.compression_algorithm = compression_algorithm_;
+    RETURN_IF_TRITON_ERROR(client_.grpc_client_->CreateStream(
+        &grpc_stream_, wrapped_callback, stream_options));
   } else {
     return Error("HTTP does not support starting streams", pa::GENERIC_ERROR);
   }
@@ -320,7 +359,10 @@ TritonClientBackend::AsyncStreamInfer(
   ParseInferOptionsToTriton(options, &triton_options);
 
   if (protocol_ == ProtocolType::GRPC) {
-    RETURN_IF_TRITON_ERROR(client_.grpc_client_->AsyncStreamInfer(
+    if (grpc_stream_ == nullptr) {
+      return Error("The stream is not started", pa::GENERIC_ERROR);
+    }
+    RETURN_IF_TRITON_ERROR(grpc_stream_->AsyncStreamInfer(
         triton_options, triton_inputs, triton_outputs));
   } else {
     return Error(
@@ -580,6 +622,8 @@ TritonClientBackend::ParseInferOptionsToTriton(
     triton_options->sequence_start_ = options.sequence_start_;
     triton_options->sequence_end_ = options.sequence_end_;
   }
+  triton_options->enable_empty_final_response_ =
+      options.triton_enable_empty_final_response_;
 }
 
 
@@ -683,6 +727,14 @@ TritonClientBackend::ParseInferStat(
       triton_infer_stat.cumulative_send_time_ns;
   infer_stat->cumulative_receive_time_ns =
       triton_infer_stat.cumulative_receive_time_ns;
+  infer_stat->cumulative_serialize_time_ns =
+      triton_infer_stat.cumulative_serialize_time_ns;
+  infer_stat->cumulative_enqueue_time_ns =
+      triton_infer_stat.cumulative_enqueue_time_ns;
+  infer_stat->cumulative_deserialize_time_ns =
+      triton_infer_stat.cumulative_deserialize_time_ns;
+  infer_stat->cumulative_callback_time_ns =
+      triton_infer_stat.cumulative_callback_time_ns;
 }
 
 //==============================================================================
@@ -810,6 +862,20 @@ TritonInferResult::RawData(
   return Error::Success;
 }
 
+Error
+TritonInferResult::IsFinalResponse(bool* is_final_response) const
+{
+  RETURN_IF_TRITON_ERROR(result_->IsFinalResponse(is_final_response));
+  return Error::Success;
+}
+
+Error
+TritonInferResult::IsNullResponse(bool* is_null_response) const
+{
+  RETURN_IF_TRITON_ERROR(result_->IsNullResponse(is_null_response));
+  return Error::Success;
+}
+
 //==============================================================================
 
 }}}}  // namespace triton::perfanalyzer::clientbackend::tritonremote
@@ -75,6 +75,8 @@ class TritonClientBackend : public ClientBackend {
   /// \param url The inference server url and port.
   /// \param protocol The protocol type used.
   /// \param ssl_options The SSL options used with client backend.
+  /// \param transport_options The options for tuning the transport used
+  /// with client backend.
   /// \param http_headers Map of HTTP headers. The map key/value indicates
   /// the header name/value.
   /// \param verbose Enables the verbose mode.
@@ -84,6 +86,7 @@ class TritonClientBackend : public ClientBackend {
   static Error Create(
       const std::string& url, const ProtocolType protocol,
       const SslOptionsBase& ssl_options,
+      const TransportOptionsBase& transport_options,
       const std::map<std::string, std::vector<std::string>> trace_options,
       const grpc_compression_algorithm compression_algorithm,
       std::shared_ptr<tc::Headers> http_headers, const bool verbose,
@@ -234,6 +237,8 @@ class TritonClientBackend : public ClientBackend {
     std::unique_ptr<tc::InferenceServerHttpClient> http_client_;
     std::unique_ptr<tc::InferenceServerGrpcClient> grpc_client_;
   } client_;
+  // The stream of StartStream(), only used with the GRPC protocol
+  std::unique_ptr<tc::GrpcInferStream> grpc_stream_;
 
   const ProtocolType protocol_{UNKNOWN};
   const grpc_compression_algorithm compression_algorithm_{GRPC_COMPRESS_NONE};
@@ -316,6 +321,10 @@ class TritonInferResult : public InferResult {
   Error RawData(
       const std::string& output_name, const uint8_t** buf,
       size_t* byte_size) const override;
+  /// See InferResult::IsFinalResponse()
+  Error IsFinalResponse(bool* is_final_response) const override;
+  /// See InferResult::IsNullResponse()
+  Error IsNullResponse(bool* is_null_response) const override;
 
  private:
   std::unique_ptr<tc::InferResult> result_;
@@ -105,6 +105,9 @@ CLParser::Usage(const std::string& msg)
                "profiling>"
             << std::endl;
   std::cerr << "\t--percentile <percentile>" << std::endl;
+  std::cerr
+      << "\t--stabilizing-latency <request|first_response|inter_response>"
+      << std::endl;
   std::cerr << "\tDEPRECATED OPTIONS" << std::endl;
   std::cerr << "\t-t <number of concurrent requests>" << std::endl;
   std::cerr << "\t-c <maximum concurrency>" << std::endl;
@@ -147,6 +150,11 @@ CLParser::Usage(const std::string& msg)
   std::cerr << "\t--streaming" << std::endl;
   std::cerr << "\t--grpc-compression-algorithm <compression_algorithm>"
             << std::endl;
+  std::cerr << "\t--grpc-completion-queues <n>" << std::endl;
+  std::cerr << "\t--grpc-channels <n>" << std::endl;
+  std::cerr << "\t--grpc-channel-selection <round_robin|least_outstanding>"
+            << std::endl;
+  std::cerr << "\t--busy-poll" << std::endl;
   std::cerr << "\t--trace-file" << std::endl;
   std::cerr << "\t--trace-level" << std::endl;
   std::cerr << "\t--trace-rate" << std::endl;
@@ -373,6 +381,19 @@ CLParser::Usage(const std::string& msg)
              "that the average latency is used to determine stability",
              18)
       << std::endl;
+  std::cerr
+      << FormatMessage(
+             " --stabilizing-latency: The latency used to determine if a "
+             "measurement is stable and compared against the latency "
+             "threshold. The supported values are request, the latency of "
+             "the whole request, first_response, the latency until the first "
+             "response of a request, and inter_response, the latency between "
+             "consecutive responses of a request. The response latencies are "
+             "useful for decoupled models that send multiple responses per "
+             "request, inter_response requires --streaming. Default value is "
+             "request.",
+             18)
+      << std::endl;
   std::cerr << std::endl;
   std::cerr << "II. INPUT DATA OPTIONS: " << std::endl;
   std::cerr << std::setw(9) << std::left
@@ -495,7 +516,9 @@ CLParser::Usage(const std::string& msg)
   std::cerr << std::setw(38) << std::left << " -i: "
             << FormatMessage(
                    "The communication protocol to use. The available protocols "
-                   "are gRPC and HTTP. Default is HTTP.",
+                   "are gRPC, HTTP and HTTP2. HTTP2 uses the HTTP protocol "
+                   "over multiplexed HTTP/2 connections (h2c for plaintext, "
+                   "ALPN negotiated for https). Default is HTTP.",
                    38)
             << std::endl;
   std::cerr << std::setw(38) << std::left << " --ssl-grpc-use-ssl: "
@@ -602,6 +625,41 @@ CLParser::Usage(const std::string& msg)
                    "none, gzip, and deflate. Default value is none.",
                    18)
             << std::endl;
+  std::cerr << FormatMessage(
+                   " --grpc-completion-queues: The number of completion "
+                   "queues used by the gRPC client to process the responses "
+                   "of asynchronous requests. Each queue is served by its own "
+                   "thread. Only supported when grpc protocol is being used "
+                   "with service-kind=triton. Default value is 1.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --grpc-channels: The number of channels, each with its "
+                   "own connection to the server, that the gRPC client sends "
+                   "the inference requests over. Only supported when grpc "
+                   "protocol is being used with service-kind=triton. Default "
+                   "value is 1.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --grpc-channel-selection: The policy for picking the "
+                   "channel of each inference request when --grpc-channels "
+                   "is more than 1. The supported values are round_robin and "
+                   "least_outstanding, which picks the channel with the "
+                   "fewest requests waiting for their response. Default value "
+                   "is round_robin.",
+                   18)
+            << std::endl;
+  std::cerr << FormatMessage(
+                   " --busy-poll: Enables busy polling for the completion of "
+                   "asynchronous requests. The client threads and the worker "
+                   "threads spin instead of sleeping until a response "
+                   "arrives, which removes the wake-up jitter from the "
+                   "measured latencies at the cost of keeping cores busy. "
+                   "Only supported with service-kind=triton. By default, it "
+                   "is set false.",
+                   18)
+            << std::endl;
 
   std::cerr
       << FormatMessage(
@@ -757,6 +815,11 @@ CLParser::ParseCommandLine(int argc, char** argv)
       {"metrics-interval", required_argument, 0, 51},
       {"sequence-length-variation", required_argument, 0, 52},
       {"bls-composing-models", required_argument, 0, 53},
+      {"grpc-completion-queues", required_argument, 0, 54},
+      {"grpc-channels", required_argument, 0, 55},
+      {"grpc-channel-selection", required_argument, 0, 56},
+      {"stabilizing-latency", required_argument, 0, 57},
+      {"busy-poll", no_argument, 0, 58},
       {0, 0, 0, 0}};
 
   // Parse commandline...
@@ -1232,6 +1295,55 @@ CLParser::ParseCommandLine(int argc, char** argv)
         }
         break;
       }
+      case 54: {
+        int64_t completion_queue_count = std::stoll(optarg);
+        if (completion_queue_count < 1) {
+          Usage("--grpc-completion-queues must be at least 1.");
+        }
+        params_->transport_options.grpc_completion_queue_count =
+            completion_queue_count;
+        break;
+      }
+      case 55: {
+        int64_t channel_count = std::stoll(optarg);
+        if (channel_count < 1) {
+          Usage("--grpc-channels must be at least 1.");
+        }
+        params_->transport_options.grpc_channel_count = channel_count;
+        break;
+      }
+      case 56: {
+        std::string arg = optarg;
+        if (arg.compare("round_robin") == 0) {
+          params_->transport_options.grpc_channel_least_outstanding = false;
+        } else if (arg.compare("least_outstanding") == 0) {
+          params_->transport_options.grpc_channel_least_outstanding = true;
+        } else {
+          Usage(
+              "Unsupported --grpc-channel-selection specified. Must be "
+              "round_robin or least_outstanding.");
+        }
+        break;
+      }
+      case 57: {
+        std::string arg = optarg;
+        if (arg.compare("request") == 0) {
+          params_->stabilizing_latency = REQUEST_LATENCY;
+        } else if (arg.compare("first_response") == 0) {
+          params_->stabilizing_latency = FIRST_RESPONSE_LATENCY;
+        } else if (arg.compare("inter_response") == 0) {
+          params_->stabilizing_latency = INTER_RESPONSE_LATENCY;
+        } else {
+          Usage(
+              "Unsupported --stabilizing-latency specified. Must be request, "
+              "first_response or inter_response.");
+        }
+        break;
+      }
+      case 58: {
+        params_->transport_options.busy_poll = true;
+        break;
+      }
       case 'v':
         params_->extra_verbose = params_->verbose;
         params_->verbose = true;
@@ -1264,9 +1376,20 @@ CLParser::ParseCommandLine(int argc, char** argv)
       case 'p':
         params_->measurement_window_ms = std::atoi(optarg);
         break;
-      case 'i':
-        params_->protocol = ParseProtocol(optarg);
+      case 'i': {
+        std::string protocol_str{optarg};
+        std::transform(
+            protocol_str.begin(), protocol_str.end(), protocol_str.begin(),
+            ::tolower);
+        if (protocol_str == "http2") {
+          params_->protocol = cb::ProtocolType::HTTP;
+          params_->transport_options.http_use_http2 = true;
+        } else {
+          params_->protocol = ParseProtocol(optarg);
+          params_->transport_options.http_use_http2 = false;
+        }
         break;
+      }
       case 'H': {
         std::string arg = optarg;
         std::string header = arg.substr(0, arg.find(":"));
@@ -1376,6 +1499,10 @@ CLParser::VerifyOptions()
       (params_->percentile > 99 || params_->percentile < 1)) {
     Usage("percentile must be -1 for not reporting or in range (0, 100)");
   }
+  if (params_->stabilizing_latency == INTER_RESPONSE_LATENCY &&
+      !params_->streaming) {
+    Usage("--stabilizing-latency=inter_response requires --streaming.");
+  }
   if (params_->zero_input && !params_->user_data.empty()) {
     Usage("zero input can't be set when data directory is provided");
   }
@@ -1496,6 +1623,32 @@ CLParser::VerifyOptions()
     params_->protocol = cb::ProtocolType::UNKNOWN;
   }
 
+  if (params_->transport_options.http_use_http2 &&
+      params_->kind != cb::BackendKind::TRITON) {
+    Usage("HTTP2 protocol is only supported with service-kind=triton.");
+  }
+
+  if (params_->transport_options.grpc_completion_queue_count != 1 &&
+      (params_->protocol != cb::ProtocolType::GRPC ||
+       params_->kind != cb::BackendKind::TRITON)) {
+    Usage(
+        "--grpc-completion-queues is only supported with gRPC protocol and "
+        "service-kind=triton.");
+  }
+
+  if (params_->transport_options.grpc_channel_count != 1 &&
+      (params_->protocol != cb::ProtocolType::GRPC ||
+       params_->kind != cb::BackendKind::TRITON)) {
+    Usage(
+        "--grpc-channels is only supported with gRPC protocol and "
+        "service-kind=triton.");
+  }
+
+  if (params_->transport_options.busy_poll &&
+      params_->kind != cb::BackendKind::TRITON) {
+    Usage("--busy-poll is only supported with service-kind=triton.");
+  }
+
   if (params_->should_collect_metrics &&
       params_->kind != cb::BackendKind::TRITON) {
     Usage(
@@ -51,6 +51,7 @@ struct PerfAnalyzerParameters {
   bool sequence_length_specified = false;
   double sequence_length_variation = 20.0;
   int32_t percentile = -1;
+  StabilizingLatency stabilizing_latency = REQUEST_LATENCY;
   std::vector<std::string> user_data;
   std::unordered_map<std::string, std::vector<int64_t>> input_shapes;
   std::vector<cb::ModelIdentifier> bls_composing_models;
@@ -86,6 +87,7 @@ struct PerfAnalyzerParameters {
   uint64_t start_sequence_id = 1;
   uint64_t sequence_id_range = UINT32_MAX;
   clientbackend::SslOptionsBase ssl_options;  // gRPC and HTTP SSL options
+  clientbackend::TransportOptionsBase transport_options;
 
   // Verbose csv option for including additional information
   bool verbose_csv = false;
@@ -25,6 +25,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
+#include <thread>
 
 #include "client_backend/client_backend.h"
 #include "concurrency_worker.h"
@@ -32,6 +33,25 @@
 
 namespace triton { namespace perfanalyzer {
 
+namespace {
+
+// The number of busy polling iterations that only relax the CPU, about a few
+// microseconds, before the polling thread yields the core on each iteration.
+constexpr size_t SPIN_COUNT_BEFORE_YIELD = 1000;
+
+// Hint to the CPU that the thread is spinning
+inline void
+CpuRelax()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+}  // namespace
+
 // Function for worker threads.
 // If the model is non-sequence model, each worker uses only one context
 // to maintain concurrency assigned to worker.
@@ -173,7 +193,20 @@ ConcurrencyWorker::RestoreFreeCtxId(uint32_t ctx_id)
 void
 ConcurrencyWorker::WaitForResponses()
 {
-  if (async_) {
+  if (async_ && busy_poll_) {
+    // Spin until signaled by a callback to avoid the wake-up latency of the
+    // condition variable, backing off to yielding the core when the
+    // responses take longer.
+    thread_stat_->idle_timer.Start();
+    for (size_t spin_count = 0; !notified_.exchange(false); ++spin_count) {
+      if (spin_count < SPIN_COUNT_BEFORE_YIELD) {
+        CpuRelax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    thread_stat_->idle_timer.Stop();
+  } else if (async_) {
     {
       // If async, then wait for signal from callback.
       std::unique_lock<std::mutex> lk(cb_mtx_);
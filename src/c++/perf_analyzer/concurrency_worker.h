@@ -85,7 +85,8 @@ class ConcurrencyWorker : public LoadWorker {
             async, streaming, batch_size, using_json_data, wake_signal,
             wake_mutex, execute, infer_data_manager, sequence_manager),
         thread_config_(thread_config), max_concurrency_(max_concurrency),
-        threads_config_(threads_config), active_threads_(active_threads)
+        threads_config_(threads_config), active_threads_(active_threads),
+        busy_poll_(factory->TransportOptions().busy_poll)
   {
   }
 
@@ -104,9 +105,11 @@ class ConcurrencyWorker : public LoadWorker {
   std::shared_ptr<ThreadConfig> thread_config_;
 
   // Variables used to signal async request completion
-  bool notified_ = false;
+  std::atomic<bool> notified_{false};
   std::mutex cb_mtx_;
   std::condition_variable cb_cv_;
+  // Whether to spin on 'notified_' instead of waiting on 'cb_cv_'
+  const bool busy_poll_;
 
   void AsyncCallbackFinalize(uint32_t ctx_id);
 
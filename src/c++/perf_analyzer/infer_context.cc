@@ -37,9 +37,10 @@ InferContext::Init()
   }
 
   if (streaming_) {
-    // Decoupled models should not collect client side statistics
-    thread_stat_->status_ = infer_backend_->StartStream(
-        async_callback_func_, (!parser_->IsDecoupled()));
+    // The stream matches the responses to their requests by id, so the client
+    // side statistics are collected for decoupled models as well
+    thread_stat_->status_ =
+        infer_backend_->StartStream(async_callback_func_, true);
     if (!thread_stat_->status_.IsOk()) {
       return;
     }
@@ -161,7 +162,9 @@ InferContext::SendRequest(const uint64_t request_id, const bool delayed)
       auto total = end_time_sync - start_time_sync;
       thread_stat_->request_timestamps_.emplace_back(std::make_tuple(
           start_time_sync, end_time_sync, infer_data_.options_->sequence_end_,
-          delayed));
+          delayed,
+          std::vector<std::chrono::time_point<std::chrono::system_clock>>{
+              end_time_sync}));
       thread_stat_->status_ =
           infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
       if (!thread_stat_->status_.IsOk()) {
@@ -230,6 +233,7 @@ void
 InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
 {
   std::shared_ptr<cb::InferResult> result_ptr(result);
+  bool is_final_response{true};
   if (thread_stat_->cb_status_.IsOk()) {
     // Add the request timestamp to thread Timestamp vector with
     // proper locking
@@ -242,20 +246,36 @@ InferContext::AsyncCallbackFuncImpl(cb::InferResult* result)
       thread_stat_->cb_status_ = result_ptr->Id(&request_id);
       const auto& it = async_req_map_.find(request_id);
       if (it != async_req_map_.end()) {
-        thread_stat_->request_timestamps_.emplace_back(std::make_tuple(
-            it->second.start_time_, end_time_async, it->second.sequence_end_,
-            it->second.delayed_));
-        infer_backend_->ClientInferStat(&(thread_stat_->contexts_stat_[id_]));
-        thread_stat_->cb_status_ = ValidateOutputs(result);
-        async_req_map_.erase(request_id);
+        bool is_null_response{false};
+        thread_stat_->cb_status_ =
+            result_ptr->IsFinalResponse(&is_final_response);
+        if (thread_stat_->cb_status_.IsOk()) {
+          thread_stat_->cb_status_ =
+              result_ptr->IsNullResponse(&is_null_response);
+        }
+        if (thread_stat_->cb_status_.IsOk() && !is_null_response) {
+          it->second.response_times_.push_back(end_time_async);
+          thread_stat_->cb_status_ = ValidateOutputs(result);
+        }
+        if (is_final_response) {
+          thread_stat_->request_timestamps_.emplace_back(std::make_tuple(
+              it->second.start_time_, end_time_async, it->second.sequence_end_,
+              it->second.delayed_, std::move(it->second.response_times_)));
+          infer_backend_->ClientInferStat(
+              &(thread_stat_->contexts_stat_[id_]));
+          async_req_map_.erase(request_id);
+        }
       }
     }
   }
 
-  total_ongoing_requests_--;
+  // A request to a decoupled model is outstanding until its final response
+  if (is_final_response) {
+    total_ongoing_requests_--;
 
-  if (async_callback_finalize_func_ != nullptr) {
-    async_callback_finalize_func_(id_);
+    if (async_callback_finalize_func_ != nullptr) {
+      async_callback_finalize_func_(id_);
+    }
   }
 }
 
@@ -54,7 +54,7 @@ struct ThreadStat {
   // Tracks the amount of time this thread spent sleeping or waiting
   IdleTimer idle_timer;
 
-  // A vector of request timestamps <start_time, end_time>
+  // A vector of request timestamps <start_time, end_time, ...>
   // Request latency will be end_time - start_time
   TimestampVector request_timestamps_;
   // A lock to protect thread data
@@ -73,6 +73,9 @@ struct AsyncRequestProperties {
   bool sequence_end_;
   // Whether or not the request is delayed as per schedule.
   bool delayed_;
+  // The timestamps of the responses received so far.
+  std::vector<std::chrono::time_point<std::chrono::system_clock>>
+      response_times_;
 };
 
 #ifndef DOCTEST_CONFIG_DISABLE
@@ -104,6 +107,10 @@ class InferContext {
     infer_data_.options_.reset(new cb::InferOptions(parser_->ModelName()));
     infer_data_.options_->model_version_ = parser_->ModelVersion();
     infer_data_.options_->model_signature_name_ = parser_->ModelSignatureName();
+    // The completion of a request to a decoupled model is only known from
+    // the response flagged as final, which may carry no output.
+    infer_data_.options_->triton_enable_empty_final_response_ =
+        streaming_ && parser_->IsDecoupled();
 
     thread_stat_->contexts_stat_.emplace_back();
   }
@@ -100,6 +100,16 @@ AverageDurationInUs(const uint64_t total_time_in_ns, const uint64_t cnt)
   return total_time_in_ns / (cnt * 1000);
 }
 
+inline uint64_t
+AverageLatency(const std::vector<uint64_t>& latencies)
+{
+  if (latencies.empty()) {
+    return 0;
+  }
+  return std::accumulate(latencies.begin(), latencies.end(), 0ULL) /
+         latencies.size();
+}
+
 EnsembleDurations
 GetTotalEnsembleDurations(const ServerSideStats& stats)
 {
@@ -327,7 +337,8 @@ ReportClientSideStats(
     const ClientSideStats& stats, const int64_t percentile,
     const cb::ProtocolType protocol, const bool verbose,
     const bool on_sequence_model, const bool include_lib_stats,
-    const double overhead_pct, const double send_request_rate)
+    const double overhead_pct, const double send_request_rate,
+    const bool include_response_stats)
 {
   const uint64_t avg_latency_us = stats.avg_latency_ns / 1000;
   const uint64_t std_us = stats.std_us;
@@ -410,7 +421,33 @@ ReportClientSideStats(
               << std::endl;
   }
 
+  if (include_response_stats) {
+    std::cout << "    Response count: " << stats.response_count << " ("
+              << stats.responses_per_sec << " response/sec)" << std::endl;
+    std::cout << "    Avg first response latency: "
+              << (stats.avg_first_response_latency_ns / 1000) << " usec"
+              << std::endl;
+    for (const auto& percentile : stats.percentile_first_response_latency_ns) {
+      std::cout << "    p" << percentile.first << " first response latency: "
+                << (percentile.second / 1000) << " usec" << std::endl;
+    }
+    std::cout << "    Avg inter-response latency: "
+              << (stats.avg_inter_response_latency_ns / 1000) << " usec"
+              << std::endl;
+    for (const auto& percentile : stats.percentile_inter_response_latency_ns) {
+      std::cout << "    p" << percentile.first << " inter-response latency: "
+                << (percentile.second / 1000) << " usec" << std::endl;
+    }
+  }
+
   std::cout << client_library_detail << std::endl;
+  if (include_lib_stats && verbose) {
+    std::cout << "    Avg client library overhead: serialize "
+              << (stats.avg_serialize_time_ns / 1000) << " usec + enqueue "
+              << (stats.avg_enqueue_time_ns / 1000) << " usec + deserialize "
+              << (stats.avg_deserialize_time_ns / 1000) << " usec + callback "
+              << (stats.avg_callback_time_ns / 1000) << " usec" << std::endl;
+  }
 
   return cb::Error::Success;
 }
@@ -427,7 +464,7 @@ Report(
   ReportClientSideStats(
       summary.client_stats, percentile, protocol, verbose,
       summary.on_sequence_model, include_lib_stats, summary.overhead_pct,
-      summary.send_request_rate);
+      summary.send_request_rate, parser->IsDecoupled());
 
   if (include_server_stats) {
     std::cout << "  Server: " << std::endl;
@@ -460,14 +497,15 @@ InferenceProfiler::Create(
     std::unique_ptr<InferenceProfiler>* profiler,
     uint64_t measurement_request_count, MeasurementMode measurement_mode,
     std::shared_ptr<MPIDriver> mpi_driver, const uint64_t metrics_interval_ms,
-    const bool should_collect_metrics, const double overhead_pct_threshold)
+    const bool should_collect_metrics, const double overhead_pct_threshold,
+    const StabilizingLatency stabilizing_latency)
 {
   std::unique_ptr<InferenceProfiler> local_profiler(new InferenceProfiler(
       verbose, stability_threshold, measurement_window_ms, max_trials,
       (percentile != -1), percentile, latency_threshold_ms_, protocol, parser,
       profile_backend, std::move(manager), measurement_request_count,
       measurement_mode, mpi_driver, metrics_interval_ms, should_collect_metrics,
-      overhead_pct_threshold));
+      overhead_pct_threshold, stabilizing_latency));
 
   *profiler = std::move(local_profiler);
   return cb::Error::Success;
@@ -483,11 +521,13 @@ InferenceProfiler::InferenceProfiler(
     std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
     MeasurementMode measurement_mode, std::shared_ptr<MPIDriver> mpi_driver,
     const uint64_t metrics_interval_ms, const bool should_collect_metrics,
-    const double overhead_pct_threshold)
+    const double overhead_pct_threshold,
+    const StabilizingLatency stabilizing_latency)
     : verbose_(verbose), measurement_window_ms_(measurement_window_ms),
       max_trials_(max_trials), extra_percentile_(extra_percentile),
       percentile_(percentile), latency_threshold_ms_(latency_threshold_ms_),
-      protocol_(protocol), parser_(parser), profile_backend_(profile_backend),
+      stabilizing_latency_(stabilizing_latency), protocol_(protocol),
+      parser_(parser), profile_backend_(profile_backend),
       manager_(std::move(manager)),
       measurement_request_count_(measurement_request_count),
       measurement_mode_(measurement_mode), mpi_driver_(mpi_driver),
@@ -498,9 +538,12 @@ InferenceProfiler::InferenceProfiler(
   load_parameters_.stability_window = 3;
   if (profile_backend_->Kind() == cb::BackendKind::TRITON ||
       profile_backend_->Kind() == cb::BackendKind::TRITON_C_API) {
-    // Measure and report client library stats only when the model
-    // is not decoupled.
-    include_lib_stats_ = (!parser_->IsDecoupled());
+    // Measure and report client library stats. For a decoupled model the
+    // gRPC stream of the Triton backend records the stats of a request
+    // with its final response, the C API backend doesn't collect them.
+    include_lib_stats_ =
+        ((profile_backend_->Kind() == cb::BackendKind::TRITON) ||
+         (!parser_->IsDecoupled()));
     // Measure and report server statistics only when the server
     // supports the statistics extension.
     std::set<std::string> extensions;
@@ -991,9 +1034,16 @@ InferenceProfiler::MergePerfStatusReports(
   experiment_perf_status.client_stats.avg_request_time_ns = 0;
   experiment_perf_status.client_stats.avg_send_time_ns = 0;
   experiment_perf_status.client_stats.avg_receive_time_ns = 0;
+  experiment_perf_status.client_stats.avg_serialize_time_ns = 0;
+  experiment_perf_status.client_stats.avg_enqueue_time_ns = 0;
+  experiment_perf_status.client_stats.avg_deserialize_time_ns = 0;
+  experiment_perf_status.client_stats.avg_callback_time_ns = 0;
   experiment_perf_status.client_stats.infer_per_sec = 0;
   experiment_perf_status.client_stats.sequence_per_sec = 0;
   experiment_perf_status.client_stats.completed_count = 0;
+  experiment_perf_status.client_stats.response_count = 0;
+  experiment_perf_status.client_stats.first_response_latencies.clear();
+  experiment_perf_status.client_stats.inter_response_latencies.clear();
   experiment_perf_status.stabilizing_latency_ns = 0;
 
   std::vector<ServerSideStats> server_side_stats;
@@ -1014,6 +1064,16 @@ InferenceProfiler::MergePerfStatusReports(
         experiment_perf_status.client_stats.latencies.end(),
         perf_status.client_stats.latencies.begin(),
         perf_status.client_stats.latencies.end());
+    experiment_perf_status.client_stats.response_count +=
+        perf_status.client_stats.response_count;
+    experiment_perf_status.client_stats.first_response_latencies.insert(
+        experiment_perf_status.client_stats.first_response_latencies.end(),
+        perf_status.client_stats.first_response_latencies.begin(),
+        perf_status.client_stats.first_response_latencies.end());
+    experiment_perf_status.client_stats.inter_response_latencies.insert(
+        experiment_perf_status.client_stats.inter_response_latencies.end(),
+        perf_status.client_stats.inter_response_latencies.begin(),
+        perf_status.client_stats.inter_response_latencies.end());
     // Accumulate the overhead percentage and send rate here to remove extra
     // traversals over the perf_status_reports
     experiment_perf_status.overhead_pct += perf_status.overhead_pct;
@@ -1040,6 +1100,22 @@ InferenceProfiler::MergePerfStatusReports(
       experiment_perf_status.client_stats.avg_receive_time_ns +=
           perf_status.client_stats.avg_receive_time_ns *
           perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_serialize_time_ns +=
+          perf_status.client_stats.avg_serialize_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_enqueue_time_ns +=
+          perf_status.client_stats.avg_enqueue_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_deserialize_time_ns +=
+          perf_status.client_stats.avg_deserialize_time_ns *
+          perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_callback_time_ns +=
+          perf_status.client_stats.avg_callback_time_ns *
+          perf_status.client_stats.completed_count;
     }
 
     if (experiment_perf_status.client_stats.completed_count != 0) {
@@ -1054,6 +1130,22 @@ InferenceProfiler::MergePerfStatusReports(
       experiment_perf_status.client_stats.avg_receive_time_ns =
           experiment_perf_status.client_stats.avg_receive_time_ns /
           experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_serialize_time_ns =
+          experiment_perf_status.client_stats.avg_serialize_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_enqueue_time_ns =
+          experiment_perf_status.client_stats.avg_enqueue_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_deserialize_time_ns =
+          experiment_perf_status.client_stats.avg_deserialize_time_ns /
+          experiment_perf_status.client_stats.completed_count;
+
+      experiment_perf_status.client_stats.avg_callback_time_ns =
+          experiment_perf_status.client_stats.avg_callback_time_ns /
+          experiment_perf_status.client_stats.completed_count;
     }
   }
 
@@ -1063,6 +1155,12 @@ InferenceProfiler::MergePerfStatusReports(
   std::sort(
       experiment_perf_status.client_stats.latencies.begin(),
       experiment_perf_status.client_stats.latencies.end());
+  std::sort(
+      experiment_perf_status.client_stats.first_response_latencies.begin(),
+      experiment_perf_status.client_stats.first_response_latencies.end());
+  std::sort(
+      experiment_perf_status.client_stats.inter_response_latencies.begin(),
+      experiment_perf_status.client_stats.inter_response_latencies.end());
 
   float client_duration_sec =
       (float)experiment_perf_status.client_stats.duration_ns / NANOS_PER_SECOND;
@@ -1074,6 +1172,7 @@ InferenceProfiler::MergePerfStatusReports(
       client_duration_sec;
   RETURN_IF_ERROR(SummarizeLatency(
       experiment_perf_status.client_stats.latencies, experiment_perf_status));
+  RETURN_IF_ERROR(SummarizeResponseLatency(experiment_perf_status));
 
   if (should_collect_metrics_) {
     // Put all Metric objects in a flat vector so they're easier to merge
@@ -1209,14 +1308,24 @@ InferenceProfiler::Summarize(
   std::pair<uint64_t, uint64_t> valid_range{window_start_ns, window_end_ns};
   uint64_t window_duration_ns = valid_range.second - valid_range.first;
   std::vector<uint64_t> latencies;
+  size_t response_count = 0;
+  std::vector<uint64_t> first_response_latencies;
+  std::vector<uint64_t> inter_response_latencies;
   ValidLatencyMeasurement(
-      valid_range, valid_sequence_count, delayed_request_count, &latencies);
+      valid_range, valid_sequence_count, delayed_request_count, &latencies,
+      response_count, &first_response_latencies, &inter_response_latencies);
 
   RETURN_IF_ERROR(SummarizeLatency(latencies, summary));
   RETURN_IF_ERROR(SummarizeClientStat(
       start_stat, end_stat, window_duration_ns, latencies.size(),
       valid_sequence_count, delayed_request_count, summary));
   summary.client_stats.latencies = std::move(latencies);
+  summary.client_stats.response_count = response_count;
+  summary.client_stats.first_response_latencies =
+      std::move(first_response_latencies);
+  summary.client_stats.inter_response_latencies =
+      std::move(inter_response_latencies);
+  RETURN_IF_ERROR(SummarizeResponseLatency(summary));
 
   SummarizeOverhead(window_duration_ns, manager_->GetIdleTime(), summary);
 
@@ -1238,10 +1347,15 @@ void
 InferenceProfiler::ValidLatencyMeasurement(
     const std::pair<uint64_t, uint64_t>& valid_range,
     size_t& valid_sequence_count, size_t& delayed_request_count,
-    std::vector<uint64_t>* valid_latencies)
+    std::vector<uint64_t>* valid_latencies, size_t& response_count,
+    std::vector<uint64_t>* first_response_latencies,
+    std::vector<uint64_t>* inter_response_latencies)
 {
   valid_latencies->clear();
   valid_sequence_count = 0;
+  response_count = 0;
+  first_response_latencies->clear();
+  inter_response_latencies->clear();
   std::vector<size_t> erase_indices{};
   for (size_t i = 0; i < all_timestamps_.size(); i++) {
     const auto& timestamp = all_timestamps_[i];
@@ -1261,6 +1375,17 @@ InferenceProfiler::ValidLatencyMeasurement(
         if (std::get<3>(timestamp)) {
           delayed_request_count++;
         }
+        const auto& response_times = std::get<4>(timestamp);
+        response_count += response_times.size();
+        if (!response_times.empty()) {
+          first_response_latencies->push_back(
+              CHRONO_TO_NANOS(response_times.front()) - request_start_ns);
+        }
+        for (size_t j = 1; j < response_times.size(); j++) {
+          inter_response_latencies->push_back(
+              CHRONO_TO_NANOS(response_times[j]) -
+              CHRONO_TO_NANOS(response_times[j - 1]));
+        }
       }
     }
   }
@@ -1274,6 +1399,10 @@ InferenceProfiler::ValidLatencyMeasurement(
 
   // Always sort measured latencies as percentile will be reported as default
   std::sort(valid_latencies->begin(), valid_latencies->end());
+  std::sort(
+      first_response_latencies->begin(), first_response_latencies->end());
+  std::sort(
+      inter_response_latencies->begin(), inter_response_latencies->end());
 }
 
 cb::Error
@@ -1291,17 +1420,7 @@ InferenceProfiler::SummarizeLatency(
       GetMeanAndStdDev(latencies);
 
   // retrieve other interesting percentile
-  summary.client_stats.percentile_latency_ns.clear();
-  std::set<size_t> percentiles{50, 90, 95, 99};
-  if (extra_percentile_) {
-    percentiles.emplace(percentile_);
-  }
-
-  for (const auto percentile : percentiles) {
-    size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
-    summary.client_stats.percentile_latency_ns.emplace(
-        percentile, latencies[index]);
-  }
+  GetPercentiles(latencies, summary.client_stats.percentile_latency_ns);
 
   if (extra_percentile_) {
     summary.stabilizing_latency_ns =
@@ -1313,6 +1432,78 @@ InferenceProfiler::SummarizeLatency(
   return cb::Error::Success;
 }
 
+cb::Error
+InferenceProfiler::SummarizeResponseLatency(PerfStatus& summary)
+{
+  ClientSideStats& stats = summary.client_stats;
+  const double client_duration_sec =
+      static_cast<double>(stats.duration_ns) / NANOS_PER_SECOND;
+  stats.responses_per_sec = stats.response_count / client_duration_sec;
+
+  stats.avg_first_response_latency_ns =
+      AverageLatency(stats.first_response_latencies);
+  GetPercentiles(
+      stats.first_response_latencies,
+      stats.percentile_first_response_latency_ns);
+  stats.avg_inter_response_latency_ns =
+      AverageLatency(stats.inter_response_latencies);
+  GetPercentiles(
+      stats.inter_response_latencies,
+      stats.percentile_inter_response_latency_ns);
+
+  if (stabilizing_latency_ == FIRST_RESPONSE_LATENCY) {
+    if (stats.first_response_latencies.empty()) {
+      return cb::Error(
+          "No responses recorded within time interval."
+          " Please use a larger time window.",
+          pa::OPTION_ERROR);
+    }
+    if (extra_percentile_) {
+      summary.stabilizing_latency_ns =
+          stats.percentile_first_response_latency_ns.find(percentile_)->second;
+    } else {
+      summary.stabilizing_latency_ns = stats.avg_first_response_latency_ns;
+    }
+  } else if (stabilizing_latency_ == INTER_RESPONSE_LATENCY) {
+    if (stats.inter_response_latencies.empty()) {
+      return cb::Error(
+          "No request with multiple responses recorded within time interval."
+          " Inter-response latency requires a decoupled model that sends "
+          "multiple responses per request.",
+          pa::OPTION_ERROR);
+    }
+    if (extra_percentile_) {
+      summary.stabilizing_latency_ns =
+          stats.percentile_inter_response_latency_ns.find(percentile_)->second;
+    } else {
+      summary.stabilizing_latency_ns = stats.avg_inter_response_latency_ns;
+    }
+  }
+
+  return cb::Error::Success;
+}
+
+void
+InferenceProfiler::GetPercentiles(
+    const std::vector<uint64_t>& latencies,
+    std::map<size_t, uint64_t>& percentile_latency_ns)
+{
+  percentile_latency_ns.clear();
+  std::set<size_t> percentiles{50, 90, 95, 99};
+  if (extra_percentile_) {
+    percentiles.emplace(percentile_);
+  }
+
+  for (const auto percentile : percentiles) {
+    uint64_t latency = 0;
+    if (!latencies.empty()) {
+      size_t index = (percentile / 100.0) * (latencies.size() - 1) + 0.5;
+      latency = latencies[index];
+    }
+    percentile_latency_ns.emplace(percentile, latency);
+  }
+}
+
 std::tuple<uint64_t, uint64_t>
 InferenceProfiler::GetMeanAndStdDev(const std::vector<uint64_t>& latencies)
 {
@@ -1378,12 +1569,28 @@ InferenceProfiler::SummarizeClientStat(
         end_stat.cumulative_send_time_ns - start_stat.cumulative_send_time_ns;
     uint64_t receive_time_ns = end_stat.cumulative_receive_time_ns -
                                start_stat.cumulative_receive_time_ns;
+    uint64_t serialize_time_ns = end_stat.cumulative_serialize_time_ns -
+                                 start_stat.cumulative_serialize_time_ns;
+    uint64_t enqueue_time_ns = end_stat.cumulative_enqueue_time_ns -
+                               start_stat.cumulative_enqueue_time_ns;
+    uint64_t deserialize_time_ns = end_stat.cumulative_deserialize_time_ns -
+                                   start_stat.cumulative_deserialize_time_ns;
+    uint64_t callback_time_ns = end_stat.cumulative_callback_time_ns -
+                                start_stat.cumulative_callback_time_ns;
     if (completed_count != 0) {
       summary.client_stats.avg_request_time_ns =
           request_time_ns / completed_count;
       summary.client_stats.avg_send_time_ns = send_time_ns / completed_count;
       summary.client_stats.avg_receive_time_ns =
           receive_time_ns / completed_count;
+      summary.client_stats.avg_serialize_time_ns =
+          serialize_time_ns / completed_count;
+      summary.client_stats.avg_enqueue_time_ns =
+          enqueue_time_ns / completed_count;
+      summary.client_stats.avg_deserialize_time_ns =
+          deserialize_time_ns / completed_count;
+      summary.client_stats.avg_callback_time_ns =
+          callback_time_ns / completed_count;
     }
   }
 
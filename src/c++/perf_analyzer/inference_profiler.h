@@ -136,12 +136,30 @@ struct ClientSideStats {
   uint64_t avg_request_time_ns;
   uint64_t avg_send_time_ns;
   uint64_t avg_receive_time_ns;
+  // Breakdown of the client library overhead
+  uint64_t avg_serialize_time_ns{0};
+  uint64_t avg_enqueue_time_ns{0};
+  uint64_t avg_deserialize_time_ns{0};
+  uint64_t avg_callback_time_ns{0};
   // Per sec stat
   double infer_per_sec;
   double sequence_per_sec;
 
   // Completed request count reported by the client library
   uint64_t completed_count;
+
+  // The number of responses received for the valid requests. A request to a
+  // decoupled model can receive any number of responses.
+  uint64_t response_count{0};
+  double responses_per_sec{0.0};
+  // Latency from the start of a request until its first response
+  uint64_t avg_first_response_latency_ns{0};
+  std::map<size_t, uint64_t> percentile_first_response_latency_ns;
+  std::vector<uint64_t> first_response_latencies;
+  // Latency between consecutive responses of the same request
+  uint64_t avg_inter_response_latency_ns{0};
+  std::map<size_t, uint64_t> percentile_inter_response_latency_ns;
+  std::vector<uint64_t> inter_response_latencies;
 };
 
 /// The entire statistics record.
@@ -198,6 +216,9 @@ class InferenceProfiler {
   /// if it is a valid percentile value, the percentile latency will reported
   /// and used as stable criteria instead of average latency. If it is -1,
   /// average latency will be reported and used as stable criteria.
+  /// \param stabilizing_latency The latency used as stable criteria and
+  /// compared against the latency threshold, either the request latency or
+  /// the first response or inter-response latency of the requests.
   /// \param latency_threshold_ms The threshold on the latency measurements in
   /// microseconds.
   /// \param parser The ModelParse object which holds all the details about the
@@ -227,7 +248,8 @@ class InferenceProfiler {
       std::unique_ptr<InferenceProfiler>* profiler,
       uint64_t measurement_request_count, MeasurementMode measurement_mode,
       std::shared_ptr<MPIDriver> mpi_driver, const uint64_t metrics_interval_ms,
-      const bool should_collect_metrics, const double overhead_pct_threshold);
+      const bool should_collect_metrics, const double overhead_pct_threshold,
+      const StabilizingLatency stabilizing_latency);
 
   /// Performs the profiling on the given range with the given search algorithm.
   /// For profiling using request rate invoke template with double, otherwise
@@ -309,7 +331,8 @@ class InferenceProfiler {
       std::unique_ptr<LoadManager> manager, uint64_t measurement_request_count,
       MeasurementMode measurement_mode, std::shared_ptr<MPIDriver> mpi_driver,
       const uint64_t metrics_interval_ms, const bool should_collect_metrics,
-      const double overhead_pct_threshold);
+      const double overhead_pct_threshold,
+      const StabilizingLatency stabilizing_latency);
 
   /// Actively measure throughput in every 'measurement_window' msec until the
   /// throughput is stable. Once the throughput is stable, it adds the
@@ -439,10 +462,18 @@ class InferenceProfiler {
   /// sequence model.
   /// \param latencies Returns the vector of request latencies where the
   /// requests are completed within the measurement window.
+  /// \param response_count Returns the number of responses received by the
+  /// requests completed within the measurement window.
+  /// \param first_response_latencies Returns the vector of latencies from
+  /// the start of those requests until their first response.
+  /// \param inter_response_latencies Returns the vector of latencies between
+  /// the consecutive responses of those requests.
   void ValidLatencyMeasurement(
       const std::pair<uint64_t, uint64_t>& valid_range,
       size_t& valid_sequence_count, size_t& delayed_request_count,
-      std::vector<uint64_t>* latencies);
+      std::vector<uint64_t>* latencies, size_t& response_count,
+      std::vector<uint64_t>* first_response_latencies,
+      std::vector<uint64_t>* inter_response_latencies);
 
   /// \param latencies The vector of request latencies collected.
   /// \param summary Returns the summary that the latency related fields are
@@ -451,6 +482,20 @@ class InferenceProfiler {
   cb::Error SummarizeLatency(
       const std::vector<uint64_t>& latencies, PerfStatus& summary);
 
+  /// Summarize the response count and the sorted response latencies in the
+  /// client side statistics of 'summary'. If the stabilizing latency is a
+  /// response latency, the stabilizing latency of 'summary' is set as well.
+  /// \param summary The summary with the response related fields to be set.
+  /// \return cb::Error object indicating success or failure.
+  cb::Error SummarizeResponseLatency(PerfStatus& summary);
+
+  /// \param latencies The sorted vector of latencies.
+  /// \param percentile_latency_ns Returns the reported percentiles of the
+  /// latencies, which are 0 if there is no latency.
+  void GetPercentiles(
+      const std::vector<uint64_t>& latencies,
+      std::map<size_t, uint64_t>& percentile_latency_ns);
+
   /// \param latencies The vector of request latencies collected.
   /// \return std::tuple object containing:
   ///   * mean of latencies in nanoseconds
@@ -657,6 +702,7 @@ class InferenceProfiler {
   bool extra_percentile_;
   size_t percentile_;
   uint64_t latency_threshold_ms_;
+  StabilizingLatency stabilizing_latency_{REQUEST_LATENCY};
 
   cb::ProtocolType protocol_;
   std::string model_name_;
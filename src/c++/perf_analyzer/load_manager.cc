@@ -95,6 +95,10 @@ LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
   contexts_stat->cumulative_receive_time_ns = 0;
   contexts_stat->cumulative_send_time_ns = 0;
   contexts_stat->cumulative_total_request_time_ns = 0;
+  contexts_stat->cumulative_serialize_time_ns = 0;
+  contexts_stat->cumulative_enqueue_time_ns = 0;
+  contexts_stat->cumulative_deserialize_time_ns = 0;
+  contexts_stat->cumulative_callback_time_ns = 0;
 
   for (auto& thread_stat : threads_stat_) {
     std::lock_guard<std::mutex> lock(thread_stat->mu_);
@@ -107,6 +111,14 @@ LoadManager::GetAccumulatedClientStat(cb::InferStat* contexts_stat)
           context_stat.cumulative_send_time_ns;
       contexts_stat->cumulative_receive_time_ns +=
           context_stat.cumulative_receive_time_ns;
+      contexts_stat->cumulative_serialize_time_ns +=
+          context_stat.cumulative_serialize_time_ns;
+      contexts_stat->cumulative_enqueue_time_ns +=
+          context_stat.cumulative_enqueue_time_ns;
+      contexts_stat->cumulative_deserialize_time_ns +=
+          context_stat.cumulative_deserialize_time_ns;
+      contexts_stat->cumulative_callback_time_ns +=
+          context_stat.cumulative_callback_time_ns;
     }
   }
   return cb::Error::Success;
@@ -76,10 +76,10 @@ PerfAnalyzer::CreateAnalyzerObjects()
   FAIL_IF_ERR(
       cb::ClientBackendFactory::Create(
           params_->kind, params_->url, params_->protocol, params_->ssl_options,
-          params_->trace_options, params_->compression_algorithm,
-          params_->http_headers, params_->triton_server_path,
-          params_->model_repository_path, params_->extra_verbose,
-          params_->metrics_url, &factory),
+          params_->transport_options, params_->trace_options,
+          params_->compression_algorithm, params_->http_headers,
+          params_->triton_server_path, params_->model_repository_path,
+          params_->extra_verbose, params_->metrics_url, &factory),
       "failed to create client factory");
 
   FAIL_IF_ERR(
@@ -258,7 +258,8 @@ PerfAnalyzer::CreateAnalyzerObjects()
           parser_, std::move(backend_), std::move(manager), &profiler_,
           params_->measurement_request_count, params_->measurement_mode,
           params_->mpi_driver, params_->metrics_interval_ms,
-          params_->should_collect_metrics, params_->overhead_pct_threshold),
+          params_->should_collect_metrics, params_->overhead_pct_threshold,
+          params_->stabilizing_latency),
       "failed to create profiler");
 }
 
@@ -333,16 +334,22 @@ PerfAnalyzer::PrerunReport()
     std::cout << "  Using synchronous calls for inference" << std::endl;
   }
   if (parser_->IsDecoupled()) {
-    std::cout << "  Detected decoupled model, using the first response for "
+    std::cout << "  Detected decoupled model, using the final response for "
                  "measuring latency"
               << std::endl;
   }
 
+  std::string latency_name{"latency"};
+  if (params_->stabilizing_latency == pa::FIRST_RESPONSE_LATENCY) {
+    latency_name = "first response latency";
+  } else if (params_->stabilizing_latency == pa::INTER_RESPONSE_LATENCY) {
+    latency_name = "inter-response latency";
+  }
   if (params_->percentile == -1) {
-    std::cout << "  Stabilizing using average latency" << std::endl;
+    std::cout << "  Stabilizing using average " << latency_name << std::endl;
   } else {
-    std::cout << "  Stabilizing using p" << params_->percentile << " latency"
-              << std::endl;
+    std::cout << "  Stabilizing using p" << params_->percentile << " "
+              << latency_name << std::endl;
   }
   std::cout << std::endl;
 }
@@ -53,9 +53,13 @@ constexpr uint64_t NANOS_PER_MILLIS = 1000000;
 #define CHRONO_TO_MILLIS(TS) (CHRONO_TO_NANOS(TS) / pa::NANOS_PER_MILLIS)
 
 //==============================================================================
+// The <start_time, end_time, sequence_end, delayed, response_times> of each
+// request. The response times record the arrival of every response of the
+// request, a request to a decoupled model can receive any number of them.
 using TimestampVector = std::vector<std::tuple<
     std::chrono::time_point<std::chrono::system_clock>,
-    std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool>>;
+    std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool,
+    std::vector<std::chrono::time_point<std::chrono::system_clock>>>>;
 
 // Will use the characters specified here to construct random strings
 std::string const character_set =
@@ -71,6 +75,11 @@ enum SharedMemoryType {
   CUDA_SHARED_MEMORY = 1,
   NO_SHARED_MEMORY = 2
 };
+enum StabilizingLatency {
+  REQUEST_LATENCY = 0,
+  FIRST_RESPONSE_LATENCY = 1,
+  INTER_RESPONSE_LATENCY = 2
+};
 
 constexpr uint64_t NO_LIMIT = 0;
 
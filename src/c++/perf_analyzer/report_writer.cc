@@ -91,6 +91,9 @@ ReportWriter::GenerateReport()
          summary_[0].client_stats.percentile_latency_ns) {
       ofs << ",p" << percentile.first << " latency";
     }
+    if (parser_->IsDecoupled()) {
+      WriteResponseStatsHeader(ofs, summary_[0].client_stats);
+    }
     if (verbose_csv_) {
       ofs << ",";
       if (percentile_ == -1) {
@@ -201,6 +204,9 @@ ReportWriter::GenerateReport()
       for (const auto& percentile : status.client_stats.percentile_latency_ns) {
         ofs << "," << (percentile.second / 1000);
       }
+      if (parser_->IsDecoupled()) {
+        WriteResponseStats(ofs, status.client_stats);
+      }
       if (verbose_csv_) {
         const uint64_t avg_latency_us =
             status.client_stats.avg_latency_ns / 1000;
@@ -380,4 +386,33 @@ ReportWriter::WriteGpuMetrics(std::ostream& ofs, const Metrics& metric)
   ofs << ",";
 }
 
+void
+ReportWriter::WriteResponseStatsHeader(
+    std::ostream& ofs, const ClientSideStats& stats)
+{
+  ofs << ",Responses/Second,Avg first response latency";
+  for (const auto& percentile : stats.percentile_first_response_latency_ns) {
+    ofs << ",p" << percentile.first << " first response latency";
+  }
+  ofs << ",Avg inter-response latency";
+  for (const auto& percentile : stats.percentile_inter_response_latency_ns) {
+    ofs << ",p" << percentile.first << " inter-response latency";
+  }
+}
+
+void
+ReportWriter::WriteResponseStats(
+    std::ostream& ofs, const ClientSideStats& stats)
+{
+  ofs << "," << stats.responses_per_sec << ","
+      << (stats.avg_first_response_latency_ns / 1000);
+  for (const auto& percentile : stats.percentile_first_response_latency_ns) {
+    ofs << "," << (percentile.second / 1000);
+  }
+  ofs << "," << (stats.avg_inter_response_latency_ns / 1000);
+  for (const auto& percentile : stats.percentile_inter_response_latency_ns) {
+    ofs << "," << (percentile.second / 1000);
+  }
+}
+
 }}  // namespace triton::perfanalyzer
@@ -78,6 +78,19 @@ class ReportWriter {
   /// rate
   void WriteGpuMetrics(std::ostream& ofs, const Metrics& metric);
 
+  /// Output the column names of the response statistics to a stream
+  /// \param ofs A stream to output the csv header
+  /// \param stats The client side statistics that decide the reported
+  /// percentiles
+  void WriteResponseStatsHeader(
+      std::ostream& ofs, const ClientSideStats& stats);
+
+  /// Output the response statistics of decoupled models to a stream
+  /// \param ofs A stream to output the csv data
+  /// \param stats The client side statistics for a particular concurrency or
+  /// request rate
+  void WriteResponseStats(std::ostream& ofs, const ClientSideStats& stats);
+
  private:
   ReportWriter(
       const std::string& filename, const bool target_concurrency,
@@ -61,6 +61,7 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->max_threads_specified == exp->max_threads_specified);
   CHECK(act->sequence_length == exp->sequence_length);
   CHECK(act->percentile == exp->percentile);
+  CHECK(act->stabilizing_latency == exp->stabilizing_latency);
   REQUIRE(act->user_data.size() == exp->user_data.size());
   for (size_t i = 0; i < act->user_data.size(); i++) {
     CHECK_STRING(act->user_data[i], exp->user_data[i]);
@@ -162,6 +163,19 @@ CHECK_PARAMS(PAParamsPtr act, PAParamsPtr exp)
   CHECK(act->using_batch_size == exp->using_batch_size);
   CHECK(act->concurrent_request_count == exp->concurrent_request_count);
   CHECK(act->protocol == exp->protocol);
+  CHECK(
+      act->transport_options.http_use_http2 ==
+      exp->transport_options.http_use_http2);
+  CHECK(
+      act->transport_options.grpc_completion_queue_count ==
+      exp->transport_options.grpc_completion_queue_count);
+  CHECK(
+      act->transport_options.grpc_channel_count ==
+      exp->transport_options.grpc_channel_count);
+  CHECK(
+      act->transport_options.grpc_channel_least_outstanding ==
+      exp->transport_options.grpc_channel_least_outstanding);
+  CHECK(act->transport_options.busy_poll == exp->transport_options.busy_poll);
   CHECK(act->http_headers->size() == exp->http_headers->size());
   CHECK(act->max_concurrency == exp->max_concurrency);
   CHECK_STRING(act->filename, act->filename);
@@ -241,6 +255,7 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->max_threads_specified == false);
   CHECK(params->sequence_length == 20);
   CHECK(params->percentile == -1);
+  CHECK(params->stabilizing_latency == REQUEST_LATENCY);
   CHECK(params->user_data.size() == 0);
   CHECK(params->input_shapes.size() == 0);
   CHECK(params->measurement_window_ms == 5000);
@@ -321,6 +336,10 @@ TEST_CASE("Testing PerfAnalyzerParameters")
   CHECK(params->using_batch_size == false);
   CHECK(params->concurrent_request_count == 1);
   CHECK(params->protocol == clientbackend::ProtocolType::HTTP);
+  CHECK(params->transport_options.http_use_http2 == false);
+  CHECK(params->transport_options.grpc_completion_queue_count == 1);
+  CHECK(params->transport_options.grpc_channel_count == 1);
+  CHECK(params->transport_options.grpc_channel_least_outstanding == false);
   CHECK(params->http_headers->size() == 0);
   CHECK(params->max_concurrency == 0);
   CHECK_STRING("filename", params->filename, "");
@@ -435,6 +454,175 @@ TEST_CASE("Testing Command Line Parser")
     }
   }
 
+  SUBCASE("Option : -i")
+  {
+    SUBCASE("set to http2")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "-i", "http2"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::HTTP;
+      exp->transport_options.http_use_http2 = true;
+    }
+
+    SUBCASE("set to http2 then grpc")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "-i",
+                          "HTTP2",  "-i", "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+    }
+  }
+
+  SUBCASE("Option : --grpc-completion-queues")
+  {
+    SUBCASE("set with grpc protocol")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "-i",
+                          "grpc",   "--grpc-completion-queues", "4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+      exp->transport_options.grpc_completion_queue_count = 4;
+    }
+
+    SUBCASE("set to zero")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "-i",
+                          "grpc",   "--grpc-completion-queues", "0"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--grpc-completion-queues must be at least 1.");
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+      exp->transport_options.grpc_completion_queue_count = 0;
+    }
+
+    SUBCASE("set with http protocol")
+    {
+      int argc = 5;
+      char* argv[argc] = {
+          app_name, "-m", model_name, "--grpc-completion-queues", "4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--grpc-completion-queues is only supported with gRPC protocol and "
+          "service-kind=triton.");
+
+      exp->transport_options.grpc_completion_queue_count = 4;
+    }
+  }
+
+  SUBCASE("Option : --grpc-channels")
+  {
+    SUBCASE("set with grpc protocol")
+    {
+      int argc = 9;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "-i",
+                          "grpc",
+                          "--grpc-channels",
+                          "4",
+                          "--grpc-channel-selection",
+                          "least_outstanding"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+      exp->transport_options.grpc_channel_count = 4;
+      exp->transport_options.grpc_channel_least_outstanding = true;
+    }
+
+    SUBCASE("set with http protocol")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--grpc-channels", "4"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--grpc-channels is only supported with gRPC protocol and "
+          "service-kind=triton.");
+
+      exp->transport_options.grpc_channel_count = 4;
+    }
+
+    SUBCASE("unsupported selection")
+    {
+      int argc = 7;
+      char* argv[argc] = {app_name, "-m", model_name, "-i", "grpc",
+                          "--grpc-channel-selection", "random"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Unsupported --grpc-channel-selection specified. Must be "
+          "round_robin or least_outstanding.");
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+    }
+  }
+
+  SUBCASE("Option : --busy-poll")
+  {
+    SUBCASE("set with triton")
+    {
+      int argc = 4;
+      char* argv[argc] = {app_name, "-m", model_name, "--busy-poll"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(!parser.UsageCalled());
+
+      exp->transport_options.busy_poll = true;
+    }
+
+    SUBCASE("with --service-kind != triton")
+    {
+      int argc = 8;
+      char* argv[argc] = {
+          app_name,         "-m",        model_name, "--busy-poll",
+          "--service-kind", "tfserving", "-i",       "grpc"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      REQUIRE(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--busy-poll is only supported with service-kind=triton.");
+
+      exp->kind = cb::BackendKind::TENSORFLOW_SERVING;
+      exp->url = "localhost:8500";
+      exp->batch_size = 0;
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->transport_options.busy_poll = true;
+    }
+  }
+
   SUBCASE("Option : --max-threads")
   {
     SUBCASE("set to 1")
@@ -593,6 +781,71 @@ TEST_CASE("Testing Command Line Parser")
     }
   }
 
+  SUBCASE("Option : --stabilizing-latency")
+  {
+    SUBCASE("set to first_response")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--stabilizing-latency",
+                          "first_response"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->stabilizing_latency = FIRST_RESPONSE_LATENCY;
+    }
+
+    SUBCASE("set to inter_response with streaming")
+    {
+      int argc = 8;
+      char* argv[argc] = {app_name,
+                          "-m",
+                          model_name,
+                          "-i",
+                          "grpc",
+                          "--streaming",
+                          "--stabilizing-latency",
+                          "inter_response"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(!parser.UsageCalled());
+
+      exp->protocol = cb::ProtocolType::GRPC;
+      exp->url = "localhost:8001";
+      exp->streaming = true;
+      exp->stabilizing_latency = INTER_RESPONSE_LATENCY;
+    }
+
+    SUBCASE("set to inter_response without streaming")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--stabilizing-latency",
+                          "inter_response"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "--stabilizing-latency=inter_response requires --streaming.");
+
+      exp->stabilizing_latency = INTER_RESPONSE_LATENCY;
+    }
+
+    SUBCASE("unsupported latency")
+    {
+      int argc = 5;
+      char* argv[argc] = {app_name, "-m", model_name, "--stabilizing-latency",
+                          "last_response"};
+
+      REQUIRE_NOTHROW(act = parser.Parse(argc, argv));
+      CHECK(parser.UsageCalled());
+      CHECK_STRING(
+          "Usage Message", parser.GetUsageMessage(),
+          "Unsupported --stabilizing-latency specified. Must be request, "
+          "first_response or inter_response.");
+    }
+  }
+
   SUBCASE("Option : --data-directory")
   {
     SUBCASE("set to `/usr/data`")
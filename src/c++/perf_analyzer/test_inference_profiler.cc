@@ -35,12 +35,16 @@ class TestInferenceProfiler : public InferenceProfiler {
   static void ValidLatencyMeasurement(
       const std::pair<uint64_t, uint64_t>& valid_range,
       size_t& valid_sequence_count, size_t& delayed_request_count,
-      std::vector<uint64_t>* latencies, TimestampVector& all_timestamps)
+      std::vector<uint64_t>* latencies, size_t& response_count,
+      std::vector<uint64_t>* first_response_latencies,
+      std::vector<uint64_t>* inter_response_latencies,
+      TimestampVector& all_timestamps)
   {
     InferenceProfiler inference_profiler{};
     inference_profiler.all_timestamps_ = all_timestamps;
     inference_profiler.ValidLatencyMeasurement(
-        valid_range, valid_sequence_count, delayed_request_count, latencies);
+        valid_range, valid_sequence_count, delayed_request_count, latencies,
+        response_count, first_response_latencies, inter_response_latencies);
   }
 
   static std::tuple<uint64_t, uint64_t> GetMeanAndStdDev(
@@ -162,6 +166,9 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
   size_t valid_sequence_count{};
   size_t delayed_request_count{};
   std::vector<uint64_t> latencies{};
+  size_t response_count{};
+  std::vector<uint64_t> first_response_latencies{};
+  std::vector<uint64_t> inter_response_latencies{};
 
   const std::pair<uint64_t, uint64_t> window{4, 17};
   using time_point = std::chrono::time_point<std::chrono::system_clock>;
@@ -170,32 +177,44 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
       // request ends before window starts, this should not be possible to exist
       // in the vector of requests, but if it is, we exclude it: not included in
       // current window
-      std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false),
+      std::make_tuple(
+          time_point(ns(1)), time_point(ns(2)), 0, false,
+          std::vector<time_point>{time_point(ns(2))}),
 
       // request starts before window starts and ends inside window: included in
       // current window
-      std::make_tuple(time_point(ns(3)), time_point(ns(5)), 0, false),
-
-      // requests start and end inside window: included in current window
-      std::make_tuple(time_point(ns(6)), time_point(ns(9)), 0, false),
-      std::make_tuple(time_point(ns(10)), time_point(ns(14)), 0, false),
+      std::make_tuple(
+          time_point(ns(3)), time_point(ns(5)), 0, false,
+          std::vector<time_point>{time_point(ns(5))}),
+
+      // requests start and end inside window: included in current window. The
+      // first request only receives the empty final response and the second
+      // request receives two responses
+      std::make_tuple(
+          time_point(ns(6)), time_point(ns(9)), 0, false,
+          std::vector<time_point>{}),
+      std::make_tuple(
+          time_point(ns(10)), time_point(ns(14)), 0, false,
+          std::vector<time_point>{time_point(ns(11)), time_point(ns(14))}),
 
       // request starts before window ends and ends after window ends: not
       // included in current window
-      std::make_tuple(time_point(ns(15)), time_point(ns(20)), 0, false),
+      std::make_tuple(
+          time_point(ns(15)), time_point(ns(20)), 0, false,
+          std::vector<time_point>{time_point(ns(20))}),
 
       // request starts after window ends: not included in current window
-      std::make_tuple(time_point(ns(21)), time_point(ns(27)), 0, false)};
+      std::make_tuple(
+          time_point(ns(21)), time_point(ns(27)), 0, false,
+          std::vector<time_point>{time_point(ns(27))})};
 
   TestInferenceProfiler::ValidLatencyMeasurement(
       window, valid_sequence_count, delayed_request_count, &latencies,
+      response_count, &first_response_latencies, &inter_response_latencies,
       all_timestamps);
 
   const auto& convert_timestamp_to_latency{
-      [](std::tuple<
-          std::chrono::time_point<std::chrono::system_clock>,
-          std::chrono::time_point<std::chrono::system_clock>, uint32_t, bool>
-             t) {
+      [](const TimestampVector::value_type& t) {
         return CHRONO_TO_NANOS(std::get<1>(t)) -
                CHRONO_TO_NANOS(std::get<0>(t));
       }};
@@ -204,6 +223,13 @@ TEST_CASE("testing the ValidLatencyMeasurement function")
   CHECK(latencies[0] == convert_timestamp_to_latency(all_timestamps[1]));
   CHECK(latencies[1] == convert_timestamp_to_latency(all_timestamps[2]));
   CHECK(latencies[2] == convert_timestamp_to_latency(all_timestamps[3]));
+
+  CHECK(response_count == 3);
+  REQUIRE(first_response_latencies.size() == 2);
+  CHECK(first_response_latencies[0] == 1);
+  CHECK(first_response_latencies[1] == 2);
+  REQUIRE(inter_response_latencies.size() == 1);
+  CHECK(inter_response_latencies[0] == 3);
 }
 
 TEST_CASE("test_check_window_for_stability")
@@ -114,12 +114,15 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
   {
     using time_point = std::chrono::time_point<std::chrono::system_clock>;
     using ns = std::chrono::nanoseconds;
-    auto timestamp1 =
-        std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false);
-    auto timestamp2 =
-        std::make_tuple(time_point(ns(3)), time_point(ns(4)), 0, false);
-    auto timestamp3 =
-        std::make_tuple(time_point(ns(5)), time_point(ns(6)), 0, false);
+    auto timestamp1 = std::make_tuple(
+        time_point(ns(1)), time_point(ns(2)), 0, false,
+        std::vector<time_point>{time_point(ns(2))});
+    auto timestamp2 = std::make_tuple(
+        time_point(ns(3)), time_point(ns(4)), 0, false,
+        std::vector<time_point>{time_point(ns(4))});
+    auto timestamp3 = std::make_tuple(
+        time_point(ns(5)), time_point(ns(6)), 0, false,
+        std::vector<time_point>{time_point(ns(6))});
 
     TimestampVector source_timestamps;
 
@@ -208,6 +211,10 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
       stat1->contexts_stat_[0].cumulative_total_request_time_ns = 3;
       stat1->contexts_stat_[0].cumulative_send_time_ns = 4;
       stat1->contexts_stat_[0].cumulative_receive_time_ns = 5;
+      stat1->contexts_stat_[0].cumulative_serialize_time_ns = 6;
+      stat1->contexts_stat_[0].cumulative_enqueue_time_ns = 7;
+      stat1->contexts_stat_[0].cumulative_deserialize_time_ns = 8;
+      stat1->contexts_stat_[0].cumulative_callback_time_ns = 9;
       threads_stat_.push_back(stat1);
 
       auto ret = GetAccumulatedClientStat(&result_stat);
@@ -215,6 +222,10 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
       CHECK(result_stat.cumulative_total_request_time_ns == 3);
       CHECK(result_stat.cumulative_send_time_ns == 4);
       CHECK(result_stat.cumulative_receive_time_ns == 5);
+      CHECK(result_stat.cumulative_serialize_time_ns == 6);
+      CHECK(result_stat.cumulative_enqueue_time_ns == 7);
+      CHECK(result_stat.cumulative_deserialize_time_ns == 8);
+      CHECK(result_stat.cumulative_callback_time_ns == 9);
       CHECK(ret.IsOk() == true);
     }
     SUBCASE("Multiple thread multiple contexts")
@@ -272,12 +283,15 @@ class TestLoadManager : public TestLoadManagerBase, public LoadManager {
   {
     using time_point = std::chrono::time_point<std::chrono::system_clock>;
     using ns = std::chrono::nanoseconds;
-    auto timestamp1 =
-        std::make_tuple(time_point(ns(1)), time_point(ns(2)), 0, false);
-    auto timestamp2 =
-        std::make_tuple(time_point(ns(3)), time_point(ns(4)), 0, false);
-    auto timestamp3 =
-        std::make_tuple(time_point(ns(5)), time_point(ns(6)), 0, false);
+    auto timestamp1 = std::make_tuple(
+        time_point(ns(1)), time_point(ns(2)), 0, false,
+        std::vector<time_point>{time_point(ns(2))});
+    auto timestamp2 = std::make_tuple(
+        time_point(ns(3)), time_point(ns(4)), 0, false,
+        std::vector<time_point>{time_point(ns(4))});
+    auto timestamp3 = std::make_tuple(
+        time_point(ns(5)), time_point(ns(6)), 0, false,
+        std::vector<time_point>{time_point(ns(6))});
 
     SUBCASE("No threads") { CHECK(CountCollectedRequests() == 0); }
     SUBCASE("One thread")
@@ -36,6 +36,17 @@ class TestReportWriter : ReportWriter {
   {
     ReportWriter::WriteGpuMetrics(ofs, metrics);
   }
+
+  void WriteResponseStatsHeader(
+      std::ostream& ofs, const ClientSideStats& stats)
+  {
+    ReportWriter::WriteResponseStatsHeader(ofs, stats);
+  }
+
+  void WriteResponseStats(std::ostream& ofs, const ClientSideStats& stats)
+  {
+    ReportWriter::WriteResponseStats(ofs, stats);
+  }
 };
 
 TEST_CASE("testing WriteGpuMetrics")
@@ -89,4 +100,34 @@ TEST_CASE("testing WriteGpuMetrics")
   }
 }
 
+TEST_CASE("testing WriteResponseStats")
+{
+  TestReportWriter trw{};
+  ClientSideStats stats{};
+  stats.responses_per_sec = 12.5;
+  stats.avg_first_response_latency_ns = 3000;
+  stats.percentile_first_response_latency_ns = {{50, 2000}, {99, 9000}};
+  stats.avg_inter_response_latency_ns = 1500;
+  stats.percentile_inter_response_latency_ns = {{50, 1000}, {99, 4000}};
+  std::ostringstream actual_output{};
+
+  SUBCASE("header")
+  {
+    trw.WriteResponseStatsHeader(actual_output, stats);
+    const std::string expected_output{
+        ",Responses/Second,Avg first response latency,"
+        "p50 first response latency,p99 first response latency,"
+        "Avg inter-response latency,p50 inter-response latency,"
+        "p99 inter-response latency"};
+    CHECK(actual_output.str() == expected_output);
+  }
+
+  SUBCASE("values in usec")
+  {
+    trw.WriteResponseStats(actual_output, stats);
+    const std::string expected_output{",12.5,3,2,9,1,1,4"};
+    CHECK(actual_output.str() == expected_output);
+  }
+}
+
 }}  // namespace triton::perfanalyzer
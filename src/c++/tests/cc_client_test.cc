@@ -26,14 +26,65 @@
 #include "gtest/gtest.h"
 
 #include "grpc_client.h"
+#include "hedged_infer.h"
 #include "http_client.h"
 
+#include <cstdlib>
 #include <fstream>
+#include <new>
+#include <thread>
 
 namespace tc = triton::client;
 
 namespace {
 
+// Whether the allocations made by the current thread are counted, see
+// AllocationCounter.
+thread_local bool count_allocations = false;
+thread_local size_t allocation_count = 0;
+
+// Counts the allocations made with operator new by the current thread
+// between Start() and Stop().
+class AllocationCounter {
+ public:
+  AllocationCounter() { allocation_count = 0; }
+  ~AllocationCounter() { Stop(); }
+
+  void Start() { count_allocations = true; }
+  void Stop() { count_allocations = false; }
+  size_t Count() const { return allocation_count; }
+};
+
+}  // namespace
+
+// Replaced for AllocationCounter, the array forms call these.
+void*
+operator new(size_t size)
+{
+  if (count_allocations) {
+    ++allocation_count;
+  }
+  void* ptr = std::malloc((size != 0) ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t size) noexcept
+{
+  std::free(ptr);
+}
+
+namespace {
+
 // This test must be run with a running Triton server,
 // check L0_grpc in server repo for the setup.
 template <typename ClientType>
@@ -294,6 +345,124 @@ class GRPCTraceTest : public ::testing::Test {
 };
 
 
+class HTTPInferTest : public ::testing::Test {
+ public:
+  HTTPInferTest()
+      : model_name_("onnx_int32_int32_int32"), shape_{1, 16}, dtype_("INT32"),
+        input_data_(16)
+  {
+    for (size_t i = 0; i < input_data_.size(); ++i) {
+      input_data_[i] = i;
+    }
+  }
+
+  tc::Error CreateClient(
+      const tc::HttpClientOptions& client_options = tc::HttpClientOptions())
+  {
+    return tc::InferenceServerHttpClient::Create(
+        &client_, "localhost:8000", false /* verbose */, tc::HttpSslOptions(),
+        client_options);
+  }
+
+  tc::Error PrepareInputs(std::vector<tc::InferInput*>* inputs)
+  {
+    for (const auto& name : {"INPUT0", "INPUT1"}) {
+      tc::InferInput* input;
+      auto err = tc::InferInput::Create(&input, name, shape_, dtype_);
+      if (!err.IsOk()) {
+        return err;
+      }
+      inputs->emplace_back(input);
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(input_data_.data()),
+          input_data_.size() * sizeof(int32_t));
+      if (!err.IsOk()) {
+        return err;
+      }
+    }
+    return tc::Error::Success;
+  }
+
+  // Issue an asynchronous inference and wait for its completion.
+  tc::Error AsyncInferAndWait(
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs)
+  {
+    std::condition_variable cv;
+    std::mutex mu;
+    tc::InferResult* result = nullptr;
+    auto err = client_->AsyncInfer(
+        [&result, &cv, &mu](tc::InferResult* res) {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            result = res;
+          }
+          cv.notify_one();
+        },
+        options, inputs);
+    if (!err.IsOk()) {
+      return err;
+    }
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&result] { return result != nullptr; });
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    return result->RequestStatus();
+  }
+
+  std::string model_name_;
+  std::vector<int64_t> shape_;
+  std::string dtype_;
+  std::vector<int32_t> input_data_;
+  std::unique_ptr<tc::InferenceServerHttpClient> client_;
+};
+
+class GRPCInferTest : public ::testing::Test {
+ public:
+  GRPCInferTest()
+      : model_name_("onnx_int32_int32_int32"), shape_{1, 16}, dtype_("INT32"),
+        input_data_(16)
+  {
+    for (size_t i = 0; i < input_data_.size(); ++i) {
+      input_data_[i] = i;
+    }
+  }
+
+  tc::Error CreateClient(
+      const tc::GrpcClientOptions& client_options = tc::GrpcClientOptions())
+  {
+    return tc::InferenceServerGrpcClient::Create(
+        &client_, "localhost:8001", false /* verbose */, false /* use_ssl */,
+        tc::SslOptions(), tc::KeepAliveOptions(),
+        false /* use_cached_channel */, client_options);
+  }
+
+  tc::Error PrepareInputs(std::vector<tc::InferInput*>* inputs)
+  {
+    for (const auto& name : {"INPUT0", "INPUT1"}) {
+      tc::InferInput* input;
+      auto err = tc::InferInput::Create(&input, name, shape_, dtype_);
+      if (!err.IsOk()) {
+        return err;
+      }
+      inputs->emplace_back(input);
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(input_data_.data()),
+          input_data_.size() * sizeof(int32_t));
+      if (!err.IsOk()) {
+        return err;
+      }
+    }
+    return tc::Error::Success;
+  }
+
+  std::string model_name_;
+  std::vector<int64_t> shape_;
+  std::string dtype_;
+  std::vector<int32_t> input_data_;
+  std::unique_ptr<tc::InferenceServerGrpcClient> client_;
+};
+
+
 TYPED_TEST_SUITE_P(ClientTest);
 
 TYPED_TEST_P(ClientTest, InferMulti)
@@ -701,6 +870,33 @@ TYPED_TEST_P(ClientTest, InferMultiMismatchOutputs)
   ASSERT_FALSE(err.IsOk()) << "Expect InferMulti() to fail";
 }
 
+TYPED_TEST_P(ClientTest, InferMultiPartialFailure)
+{
+  // One of the requests targets a version that doesn't exist, the other
+  // requests must still complete and the failure must be reported.
+  tc::Error err = tc::Error::Success;
+  std::vector<tc::InferOptions> options;
+  std::vector<std::vector<tc::InferInput*>> inputs;
+
+  for (size_t i = 0; i < 3; ++i) {
+    options.emplace_back(this->model_name_);
+    options.back().model_version_ = (i == 1) ? "100" : "1";
+
+    const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+    const auto& input_1 = this->input_data_[(i + 1) % this->input_data_.size()];
+    inputs.emplace_back();
+    err = this->PrepareInputs(input_0, input_1, &inputs.back());
+  }
+
+  std::vector<tc::InferResult*> results;
+  err = this->client_->InferMulti(&results, options, inputs);
+  ASSERT_FALSE(err.IsOk()) << "Expect InferMulti() to fail";
+  ASSERT_EQ(results.size(), inputs.size()) << "unexpected number of results";
+  EXPECT_TRUE(results[0]->RequestStatus().IsOk());
+  EXPECT_FALSE(results[1]->RequestStatus().IsOk());
+  EXPECT_TRUE(results[2]->RequestStatus().IsOk());
+}
+
 TYPED_TEST_P(ClientTest, AsyncInferMulti)
 {
   tc::Error err = tc::Error::Success;
@@ -1198,6 +1394,312 @@ TYPED_TEST_P(ClientTest, AsyncInferMultiMismatchOutputs)
   ASSERT_FALSE(err.IsOk()) << "Expect AsyncInferMulti() to fail";
 }
 
+TYPED_TEST_P(ClientTest, InferInputChunks)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  // Not swap
+  options.model_version_ = "1";
+
+  // Provide the data of each input in two chunks, which must be sent as one
+  // contiguous tensor.
+  const auto& input_0 = this->input_data_[0];
+  const auto& input_1 = this->input_data_[1];
+  std::vector<tc::InferInput*> inputs;
+  for (const auto& name : {"INPUT0", "INPUT1"}) {
+    const auto& input_data = (inputs.empty()) ? input_0 : input_1;
+    inputs.emplace_back();
+    err = tc::InferInput::Create(
+        &inputs.back(), name, this->shape_, this->dtype_);
+    ASSERT_TRUE(err.IsOk()) << "failed to create input: " << err.Message();
+    const size_t half_byte_size = input_data.size() * sizeof(int32_t) / 2;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(input_data.data());
+    err = inputs.back()->AppendRaw(data, half_byte_size);
+    ASSERT_TRUE(err.IsOk()) << "failed to set input data: " << err.Message();
+    err = inputs.back()->AppendRaw(data + half_byte_size, half_byte_size);
+    ASSERT_TRUE(err.IsOk()) << "failed to set input data: " << err.Message();
+  }
+
+  tc::InferResult* result;
+  err = this->client_->Infer(&result, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to perform inference: " << err.Message();
+
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(1);
+  for (size_t i = 0; i < 16; ++i) {
+    expected_outputs[0]["OUTPUT0"].emplace_back(input_0[i] + input_1[i]);
+    expected_outputs[0]["OUTPUT1"].emplace_back(input_0[i] - input_1[i]);
+  }
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput({result}, expected_outputs));
+
+  delete result;
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TYPED_TEST_P(ClientTest, InferOutputBuffers)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  // Not swap
+  options.model_version_ = "1";
+
+  std::vector<tc::InferInput*> inputs;
+  err =
+      this->PrepareInputs(this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Provide a buffer for 'OUTPUT0' only, 'OUTPUT1' is still returned in the
+  // result's own storage.
+  std::vector<int32_t> output_buffer(16);
+  std::vector<tc::InferRequestedOutput*> outputs;
+  for (const auto& name : {"OUTPUT0", "OUTPUT1"}) {
+    outputs.emplace_back();
+    err = tc::InferRequestedOutput::Create(&outputs.back(), name);
+    ASSERT_TRUE(err.IsOk()) << "failed to create output: " << err.Message();
+  }
+  err = outputs[0]->SetBuffer(
+      reinterpret_cast<uint8_t*>(output_buffer.data()),
+      output_buffer.size() * sizeof(int32_t));
+  ASSERT_TRUE(err.IsOk()) << "failed to set output buffer: " << err.Message();
+
+  tc::InferResult* result;
+  err = this->client_->Infer(
+      &result, options, inputs,
+      std::vector<const tc::InferRequestedOutput*>(
+          outputs.begin(), outputs.end()));
+  ASSERT_TRUE(err.IsOk()) << "failed to perform inference: " << err.Message();
+
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(1);
+  for (size_t i = 0; i < 16; ++i) {
+    expected_outputs[0]["OUTPUT0"].emplace_back(
+        this->input_data_[0][i] + this->input_data_[1][i]);
+    expected_outputs[0]["OUTPUT1"].emplace_back(
+        this->input_data_[0][i] - this->input_data_[1][i]);
+  }
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput({result}, expected_outputs));
+
+  const uint8_t* buf = nullptr;
+  size_t byte_size = 0;
+  err = result->RawData("OUTPUT0", &buf, &byte_size);
+  ASSERT_TRUE(err.IsOk()) << "failed to get output: " << err.Message();
+  EXPECT_EQ(buf, reinterpret_cast<uint8_t*>(output_buffer.data()));
+  EXPECT_EQ(output_buffer, expected_outputs[0]["OUTPUT0"]);
+
+  delete result;
+  for (auto input : inputs) {
+    delete input;
+  }
+  for (auto output : outputs) {
+    delete output;
+  }
+}
+
+TYPED_TEST_P(ClientTest, ConcurrentInfer)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  // Not swap
+  options.model_version_ = "1";
+
+  // Each thread sends synchronous and asynchronous requests with its own
+  // inputs through the same client.
+  const size_t thread_count = 8;
+  const size_t request_count = 10;
+  std::vector<std::vector<tc::InferInput*>> inputs(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    err = this->PrepareInputs(
+        this->input_data_[i % 3], this->input_data_[(i + 1) % 3], &inputs[i]);
+    ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+  }
+
+  std::mutex mu;
+  std::condition_variable cv;
+  size_t submitted_count = 0;
+  size_t completed_count = 0;
+  std::vector<std::vector<tc::InferResult*>> results(thread_count);
+  std::vector<tc::Error> errors(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t j = 0; j < request_count; ++j) {
+        tc::InferResult* result;
+        auto err = this->client_->Infer(&result, options, inputs[i]);
+        if (!err.IsOk()) {
+          errors[i] = err;
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          results[i].emplace_back(result);
+        }
+        err = this->client_->AsyncInfer(
+            [&, i](tc::InferResult* result) {
+              {
+                std::lock_guard<std::mutex> lk(mu);
+                results[i].emplace_back(result);
+                completed_count++;
+              }
+              cv.notify_one();
+            },
+            options, inputs[i]);
+        if (!err.IsOk()) {
+          errors[i] = err;
+          return;
+        }
+        std::lock_guard<std::mutex> lk(mu);
+        submitted_count++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return completed_count == submitted_count; });
+  }
+  for (const auto& err : errors) {
+    EXPECT_TRUE(err.IsOk()) << "failed to perform inference: " << err.Message();
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    const auto& input_0 = this->input_data_[i % 3];
+    const auto& input_1 = this->input_data_[(i + 1) % 3];
+    std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs(
+        results[i].size());
+    for (auto& expected : expected_outputs) {
+      for (size_t k = 0; k < 16; ++k) {
+        expected["OUTPUT0"].emplace_back(input_0[k] + input_1[k]);
+        expected["OUTPUT1"].emplace_back(input_0[k] - input_1[k]);
+      }
+    }
+    EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results[i], expected_outputs));
+    for (auto result : results[i]) {
+      delete result;
+    }
+    for (auto input : inputs[i]) {
+      delete input;
+    }
+  }
+}
+
+TYPED_TEST_P(ClientTest, PreparedInfer)
+{
+  tc::Error err = tc::Error::Success;
+  tc::InferOptions options(this->model_name_);
+  // Not swap
+  options.model_version_ = "1";
+
+  std::vector<tc::InferInput*> inputs;
+  err = this->PrepareInputs(
+      this->input_data_[0], this->input_data_[1], &inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::vector<const tc::InferRequestedOutput*> outputs;
+  tc::InferRequestedOutput* output;
+  err = tc::InferRequestedOutput::Create(&output, "OUTPUT0");
+  ASSERT_TRUE(err.IsOk())
+      << "failed to create inference output: " << err.Message();
+  outputs.emplace_back(output);
+  err = tc::InferRequestedOutput::Create(&output, "OUTPUT1");
+  ASSERT_TRUE(err.IsOk())
+      << "failed to create inference output: " << err.Message();
+  outputs.emplace_back(output);
+
+  std::unique_ptr<tc::PreparedInferRequest> prepared;
+  err = this->client_->PrepareInferRequest(&prepared, options, inputs, outputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inference request: "
+                          << err.Message();
+
+  // Issue the same prepared request with different input data, the results
+  // are collected from the synchronous and the asynchronous API.
+  std::vector<tc::InferResult*> results;
+  std::vector<std::map<std::string, std::vector<int32_t>>> expected_outputs;
+  std::condition_variable cv;
+  std::mutex mu;
+  for (size_t i = 0; i < 3; ++i) {
+    const auto& input_0 = this->input_data_[i % this->input_data_.size()];
+    const auto& input_1 = this->input_data_[(i + 1) % this->input_data_.size()];
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      const auto& input_data = (j == 0) ? input_0 : input_1;
+      inputs[j]->Reset();
+      err = inputs[j]->AppendRaw(
+          reinterpret_cast<const uint8_t*>(input_data.data()),
+          input_data.size() * sizeof(int32_t));
+      ASSERT_TRUE(err.IsOk()) << "failed to set input data: " << err.Message();
+    }
+    prepared->SetRequestId(std::to_string(i));
+
+    if (i % 2 == 0) {
+      tc::InferResult* result;
+      err = this->client_->Infer(&result, prepared.get());
+      ASSERT_TRUE(err.IsOk()) << "failed to perform inference: "
+                              << err.Message();
+      results.emplace_back(result);
+    } else {
+      tc::InferResult* result = nullptr;
+      err = this->client_->AsyncInfer(
+          [&result, &cv, &mu](tc::InferResult* res) {
+            {
+              std::lock_guard<std::mutex> lk(mu);
+              result = res;
+            }
+            cv.notify_one();
+          },
+          prepared.get());
+      ASSERT_TRUE(err.IsOk()) << "failed to perform inference: "
+                              << err.Message();
+      std::unique_lock<std::mutex> lk(mu);
+      cv.wait(lk, [&result] { return result != nullptr; });
+      results.emplace_back(result);
+    }
+
+    std::string request_id;
+    err = results.back()->Id(&request_id);
+    ASSERT_TRUE(err.IsOk()) << "failed to get request id: " << err.Message();
+    EXPECT_EQ(request_id, std::to_string(i));
+
+    expected_outputs.emplace_back();
+    {
+      auto& expected = expected_outputs.back()["OUTPUT0"];
+      for (size_t i = 0; i < 16; ++i) {
+        expected.emplace_back(input_0[i] + input_1[i]);
+      }
+    }
+    {
+      auto& expected = expected_outputs.back()["OUTPUT1"];
+      for (size_t i = 0; i < 16; ++i) {
+        expected.emplace_back(input_0[i] - input_1[i]);
+      }
+    }
+  }
+
+  EXPECT_NO_FATAL_FAILURE(this->ValidateOutput(results, expected_outputs));
+
+  // A prepared request can only be used with the client that created it
+  std::unique_ptr<TypeParam> other_client;
+  err = TypeParam::Create(
+      &other_client,
+      std::is_same<TypeParam, tc::InferenceServerGrpcClient>::value
+          ? "localhost:8001"
+          : "localhost:8000");
+  ASSERT_TRUE(err.IsOk()) << "failed to create client: " << err.Message();
+  tc::InferResult* result;
+  err = other_client->Infer(&result, prepared.get());
+  EXPECT_FALSE(err.IsOk());
+
+  for (auto result : results) {
+    delete result;
+  }
+  for (auto input : inputs) {
+    delete input;
+  }
+  for (auto output : outputs) {
+    delete output;
+  }
+}
+
 TYPED_TEST_P(ClientTest, LoadWithFileOverride)
 {
   std::vector<char> content;
@@ -1613,14 +2115,1240 @@ TEST_F(GRPCTraceTest, GRPCClearTraceSettings)
       << std::endl;
 }
 
+TEST_F(HTTPInferTest, EasyHandlePoolReuse)
+{
+  tc::HttpClientOptions client_options;
+  client_options.easy_handle_pool_size = 1;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Requests are issued one after another so only the first request needs
+  // a new handle and the rest reuse the handle returned to the pool.
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < 3; ++i) {
+    err = AsyncInferAndWait(options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.handle_pool_exhausted_count, 1u);
+  EXPECT_EQ(infer_stat.handle_pool_reuse_count, 2u);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, AsyncRequestPoolReuse)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Each result is released before the next request is issued so only the
+  // first request allocates its state and the rest reuse it.
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < 3; ++i) {
+    err = AsyncInferAndWait(options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.request_pool_miss_count, 1u);
+  EXPECT_EQ(infer_stat.request_pool_reuse_count, 2u);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST(SharedObjectPoolTest, MaxSize)
+{
+  tc::SharedObjectPool<int> pool(2 /* max_size */);
+  auto create = []() { return new int(0); };
+  bool reused;
+
+  // The objects created once the pool is full are not kept
+  std::vector<std::shared_ptr<int>> objects;
+  for (size_t i = 0; i < 3; ++i) {
+    objects.push_back(pool.Acquire(create, &reused));
+    EXPECT_FALSE(reused);
+  }
+  const int* unpooled = objects.back().get();
+  objects.clear();
+
+  for (size_t i = 0; i < 2; ++i) {
+    objects.push_back(pool.Acquire(create, &reused));
+    EXPECT_TRUE(reused);
+    EXPECT_NE(objects.back().get(), unpooled);
+  }
+  objects.push_back(pool.Acquire(create, &reused));
+  EXPECT_FALSE(reused);
+
+  // A released object is reused
+  objects.erase(objects.begin());
+  objects.push_back(pool.Acquire(create, &reused));
+  EXPECT_TRUE(reused);
+}
+
+TEST(AllocationCounterTest, ReusedObjects)
+{
+  struct Recycled {
+    static void* operator new(size_t size)
+    {
+      return tc::RecycledMemory<Recycled>::Allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size)
+    {
+      tc::RecycledMemory<Recycled>::Release(ptr, size);
+    }
+    int value;
+  };
+  tc::SharedObjectPool<int> pool;
+  auto create = []() { return new int(0); };
+  bool reused;
+
+  AllocationCounter counter;
+  counter.Start();
+  pool.Acquire(create, &reused);
+  delete new Recycled();
+  counter.Stop();
+  EXPECT_GT(counter.Count(), 0u);
+
+  // Once warmed up, the pooled and the recycled objects don't allocate
+  AllocationCounter warm_counter;
+  warm_counter.Start();
+  for (size_t i = 0; i < 3; ++i) {
+    std::shared_ptr<int> object = pool.Acquire(create, &reused);
+    delete new Recycled();
+  }
+  warm_counter.Stop();
+  EXPECT_EQ(warm_counter.Count(), 0u);
+}
+
+TEST_F(HTTPInferTest, AsyncInferWithoutAllocation)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::unique_ptr<tc::PreparedInferRequest> prepared;
+  err = client_->PrepareInferRequest(
+      &prepared, tc::InferOptions(model_name_), inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inference request: "
+                          << err.Message();
+
+  // The callback only captures a pointer so that constructing it doesn't
+  // allocate either.
+  struct Completion {
+    std::mutex mu;
+    std::condition_variable cv;
+    tc::InferResult* result;
+  } completion;
+  auto infer = [this, &prepared, &completion](AllocationCounter* counter) {
+    completion.result = nullptr;
+    counter->Start();
+    tc::Error err = client_->AsyncInfer(
+        [&completion](tc::InferResult* result) {
+          {
+            std::lock_guard<std::mutex> lk(completion.mu);
+            completion.result = result;
+          }
+          completion.cv.notify_one();
+        },
+        prepared.get());
+    counter->Stop();
+    if (!err.IsOk()) {
+      return err;
+    }
+    std::unique_lock<std::mutex> lk(completion.mu);
+    completion.cv.wait(
+        lk, [&completion] { return completion.result != nullptr; });
+    err = completion.result->RequestStatus();
+    counter->Start();
+    delete completion.result;
+    counter->Stop();
+    return err;
+  };
+
+  // The first requests create the state that the next ones reuse. The
+  // response is parsed on the transfer thread, whose allocations are not
+  // counted.
+  AllocationCounter counter;
+  for (size_t i = 0; i < 3; ++i) {
+    err = infer(&counter);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  AllocationCounter warm_counter;
+  for (size_t i = 0; i < 10; ++i) {
+    err = infer(&warm_counter);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  EXPECT_EQ(warm_counter.Count(), 0u);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, MultipleTransferThreads)
+{
+  tc::HttpClientOptions client_options;
+  client_options.async_transfer_threads = 3;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Submit more requests than loops so that every loop handles several
+  // requests concurrently.
+  const size_t request_count = 10;
+  std::condition_variable cv;
+  std::mutex mu;
+  std::vector<tc::InferResult*> results;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    err = client_->AsyncInfer(
+        [&results, &cv, &mu](tc::InferResult* res) {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            results.emplace_back(res);
+          }
+          cv.notify_one();
+        },
+        options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&] { return results.size() == request_count; });
+  for (auto result : results) {
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+    delete result;
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, ParallelGzipCompression)
+{
+  // Use chunks much smaller than the request body so that it is split across
+  // all the compression threads.
+  tc::HttpClientOptions client_options;
+  client_options.compression_level = 9;
+  client_options.compression_threads = 3;
+  client_options.compression_chunk_byte_size = 16;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  tc::InferResult* result;
+  tc::InferOptions options(model_name_);
+  err = client_->Infer(
+      &result, options, inputs, std::vector<const tc::InferRequestedOutput*>(),
+      tc::Headers(), tc::Parameters(),
+      tc::InferenceServerHttpClient::CompressionType::GZIP);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  std::unique_ptr<tc::InferResult> result_ptr(result);
+  ASSERT_TRUE(result->RequestStatus().IsOk())
+      << "unexpected request failure: " << result->RequestStatus().Message();
+
+  // The server must have decompressed the original input data
+  const uint8_t* buf = nullptr;
+  size_t byte_size = 0;
+  err = result->RawData("OUTPUT0", &buf, &byte_size);
+  ASSERT_TRUE(err.IsOk()) << "failed to get output: " << err.Message();
+  ASSERT_EQ(byte_size, input_data_.size() * sizeof(int32_t));
+  const int32_t* output = reinterpret_cast<const int32_t*>(buf);
+  for (size_t i = 0; i < input_data_.size(); ++i) {
+    EXPECT_EQ(output[i], input_data_[i] * 2);
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, AsyncParallelGzipCompression)
+{
+  // The transfer loop sends the body while its later chunks are compressed,
+  // pausing the transfer whenever the next chunk is not ready.
+  tc::HttpClientOptions client_options;
+  client_options.compression_threads = 2;
+  client_options.compression_chunk_byte_size = 16;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  for (size_t i = 0; i < 10; ++i) {
+    std::condition_variable cv;
+    std::mutex mu;
+    tc::InferResult* result = nullptr;
+    tc::InferOptions options(model_name_);
+    err = client_->AsyncInfer(
+        [&result, &cv, &mu](tc::InferResult* res) {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            result = res;
+          }
+          cv.notify_one();
+        },
+        options, inputs, std::vector<const tc::InferRequestedOutput*>(),
+        tc::Headers(), tc::Parameters(),
+        tc::InferenceServerHttpClient::CompressionType::GZIP);
+    ASSERT_TRUE(err.IsOk()) << "failed to send request: " << err.Message();
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&result] { return result != nullptr; });
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    ASSERT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+
+    const uint8_t* buf = nullptr;
+    size_t byte_size = 0;
+    err = result->RawData("OUTPUT0", &buf, &byte_size);
+    ASSERT_TRUE(err.IsOk()) << "failed to get output: " << err.Message();
+    ASSERT_EQ(byte_size, input_data_.size() * sizeof(int32_t));
+    const int32_t* output = reinterpret_cast<const int32_t*>(buf);
+    for (size_t j = 0; j < input_data_.size(); ++j) {
+      EXPECT_EQ(output[j], input_data_[j] * 2);
+    }
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, AutoCompression)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // The request is too small for compression to pay off
+  tc::InferResult* result;
+  tc::InferOptions options(model_name_);
+  err = client_->Infer(
+      &result, options, inputs, std::vector<const tc::InferRequestedOutput*>(),
+      tc::Headers(), tc::Parameters(),
+      tc::InferenceServerHttpClient::CompressionType::AUTO,
+      tc::InferenceServerHttpClient::CompressionType::AUTO);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  delete result;
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.auto_compressed_request_count, 0u);
+  EXPECT_EQ(infer_stat.auto_uncompressed_request_count, 1u);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST(LatencyHistogramTest, Buckets)
+{
+  // Small latencies have a bucket each
+  for (uint64_t v = 0; v < 64; ++v) {
+    const size_t idx = tc::LatencyHistogram::BucketIndex(v);
+    EXPECT_EQ(tc::LatencyHistogram::BucketLowerBound(idx), v);
+    EXPECT_EQ(tc::LatencyHistogram::BucketUpperBound(idx), v);
+  }
+
+  // Larger latencies fall in a bucket within ~3% of their value
+  const uint64_t values[] = {
+      100, 1000, 123456789, 1ull << 40, (1ull << 40) + 12345, UINT64_MAX};
+  for (const uint64_t v : values) {
+    const size_t idx = tc::LatencyHistogram::BucketIndex(v);
+    ASSERT_LT(idx, tc::LatencyHistogram::kBucketCount);
+    const uint64_t lower = tc::LatencyHistogram::BucketLowerBound(idx);
+    const uint64_t upper = tc::LatencyHistogram::BucketUpperBound(idx);
+    EXPECT_LE(lower, v);
+    EXPECT_GE(upper, v);
+    EXPECT_LE(upper - lower, lower / tc::LatencyHistogram::kSubBucketCount);
+  }
+
+  // The buckets are contiguous
+  for (size_t idx = 1; idx < tc::LatencyHistogram::kBucketCount; ++idx) {
+    EXPECT_EQ(
+        tc::LatencyHistogram::BucketLowerBound(idx),
+        tc::LatencyHistogram::BucketUpperBound(idx - 1) + 1);
+  }
+}
+
+TEST(LatencyHistogramTest, Percentile)
+{
+  tc::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Percentile(50), 0u);
+
+  for (uint64_t v = 1; v <= 20; ++v) {
+    histogram.Record(v);
+  }
+  EXPECT_EQ(histogram.Count(), 20u);
+  EXPECT_EQ(histogram.Percentile(0), 1u);
+  EXPECT_EQ(histogram.Percentile(50), 10u);
+  EXPECT_EQ(histogram.Percentile(95), 19u);
+  EXPECT_EQ(histogram.Percentile(100), 20u);
+
+  tc::LatencyHistogram other;
+  other.Record(1000000);
+  histogram.Merge(other);
+  EXPECT_EQ(histogram.Count(), 21u);
+  const uint64_t p100 = histogram.Percentile(100);
+  EXPECT_GE(p100, 1000000u);
+  EXPECT_LE(p100, 1000000u + 1000000u / tc::LatencyHistogram::kSubBucketCount);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Percentile(100), 0u);
+}
+
+TEST_F(HTTPInferTest, LatencyHistograms)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  const size_t request_count = 5;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    tc::InferResult* result;
+    err = client_->Infer(&result, options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+    delete result;
+  }
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, request_count);
+  EXPECT_EQ(infer_stat.total_request_time_histogram.Count(), request_count);
+  EXPECT_EQ(infer_stat.send_time_histogram.Count(), request_count);
+  EXPECT_EQ(infer_stat.receive_time_histogram.Count(), request_count);
+  EXPECT_GT(infer_stat.total_request_time_histogram.Percentile(50), 0u);
+
+  err = client_->ResetClientInferStat();
+  ASSERT_TRUE(err.IsOk()) << "failed to reset client stat: " << err.Message();
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, 0u);
+  EXPECT_EQ(infer_stat.total_request_time_histogram.Count(), 0u);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, ClientOverheadBreakdown)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  tc::InferResult* result;
+  tc::InferOptions options(model_name_);
+  err = client_->Infer(&result, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  delete result;
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_GT(infer_stat.cumulative_serialize_time_ns, 0u);
+  EXPECT_GT(infer_stat.cumulative_enqueue_time_ns, 0u);
+  EXPECT_GT(infer_stat.cumulative_deserialize_time_ns, 0u);
+  EXPECT_EQ(infer_stat.cumulative_callback_time_ns, 0u);
+
+  // The callback time is recorded once the callback returns, after the
+  // waiter below is notified.
+  const auto callback_duration = std::chrono::milliseconds(5);
+  std::condition_variable cv;
+  std::mutex mu;
+  tc::InferResult* async_result = nullptr;
+  err = client_->AsyncInfer(
+      [&](tc::InferResult* res) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          async_result = res;
+        }
+        cv.notify_one();
+        std::this_thread::sleep_for(callback_duration);
+      },
+      options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return async_result != nullptr; });
+  }
+  delete async_result;
+
+  const uint64_t callback_duration_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(callback_duration)
+          .count();
+  for (size_t i = 0; i < 100; ++i) {
+    err = client_->ClientInferStat(&infer_stat);
+    ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+    if (infer_stat.cumulative_callback_time_ns != 0) {
+      break;
+    }
+    std::this_thread::sleep_for(callback_duration);
+  }
+  EXPECT_GE(infer_stat.cumulative_callback_time_ns, callback_duration_ns);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST(CallbackExecutorTest, ThreadPool)
+{
+  std::shared_ptr<tc::CallbackExecutor> executor;
+  tc::Error err = tc::CallbackExecutor::CreateThreadPool(&executor, 0);
+  EXPECT_FALSE(err.IsOk()) << "expect error for a pool without thread";
+
+  err = tc::CallbackExecutor::CreateThreadPool(&executor, 2);
+  ASSERT_TRUE(err.IsOk()) << "failed to create thread pool: " << err.Message();
+
+  // The queued tasks are run before the pool is destroyed
+  std::atomic<size_t> run_count(0);
+  const auto caller_id = std::this_thread::get_id();
+  std::atomic<bool> on_caller_thread(false);
+  for (size_t i = 0; i < 100; ++i) {
+    executor->Execute([&] {
+      if (std::this_thread::get_id() == caller_id) {
+        on_caller_thread = true;
+      }
+      run_count++;
+    });
+  }
+  executor.reset();
+  EXPECT_EQ(run_count.load(), 100u);
+  EXPECT_FALSE(on_caller_thread.load());
+}
+
+TEST_F(HTTPInferTest, CallbackExecutor)
+{
+  // An executor that defers the tasks until they are run by the test
+  struct ManualExecutor : public tc::CallbackExecutor {
+    void Execute(std::function<void()> task) override
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      tasks.emplace_back(std::move(task));
+    }
+    size_t TaskCount()
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      return tasks.size();
+    }
+    void RunAll()
+    {
+      std::vector<std::function<void()>> pending;
+      {
+        std::lock_guard<std::mutex> lk(mu);
+        pending.swap(tasks);
+      }
+      for (auto& task : pending) {
+        task();
+      }
+    }
+    std::mutex mu;
+    std::vector<std::function<void()>> tasks;
+  };
+  std::shared_ptr<ManualExecutor> executor(new ManualExecutor());
+
+  tc::HttpClientOptions client_options;
+  client_options.callback_executor = executor;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  const size_t request_count = 3;
+  std::atomic<size_t> callback_count(0);
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    err = client_->AsyncInfer(
+        [&callback_count](tc::InferResult* result) {
+          EXPECT_TRUE(result->RequestStatus().IsOk())
+              << "unexpected request failure: "
+              << result->RequestStatus().Message();
+          delete result;
+          callback_count++;
+        },
+        options, inputs);
+    EXPECT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  // The completed requests wait in the executor for their callbacks to run.
+  // Nothing may fail before the tasks are run, as the client waits for the
+  // callbacks when it is destroyed.
+  for (size_t i = 0; (i < 1000) && (executor->TaskCount() < request_count);
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(executor->TaskCount(), request_count);
+  EXPECT_EQ(callback_count.load(), 0u);
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  EXPECT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.callback_queue_depth, request_count);
+  EXPECT_EQ(infer_stat.max_callback_queue_depth, request_count);
+
+  executor->RunAll();
+  EXPECT_EQ(callback_count.load(), request_count);
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.callback_queue_depth, 0u);
+  EXPECT_EQ(infer_stat.max_callback_queue_depth, request_count);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, Polling)
+{
+  tc::Error err = CreateClient(tc::HttpClientOptions());
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+  // The requests of a client with transfer threads can't be polled
+  err = client_->Poll(0);
+  EXPECT_FALSE(err.IsOk()) << "expect Poll() to fail without polling mode";
+
+  tc::HttpClientOptions client_options;
+  client_options.polling = true;
+  err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  const size_t request_count = 3;
+  const std::thread::id polling_thread = std::this_thread::get_id();
+  size_t callback_count = 0;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    err = client_->AsyncInfer(
+        [&callback_count, polling_thread](tc::InferResult* result) {
+          EXPECT_TRUE(result->RequestStatus().IsOk())
+              << "unexpected request failure: "
+              << result->RequestStatus().Message();
+          EXPECT_EQ(std::this_thread::get_id(), polling_thread);
+          delete result;
+          callback_count++;
+        },
+        options, inputs);
+    EXPECT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  // No request is processed until the client is polled
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(callback_count, 0u);
+
+  // Complete one request at most, then poll for the rest
+  size_t completed_count = 0;
+  for (size_t i = 0; (i < 1000) && (completed_count == 0); ++i) {
+    err = client_->ProcessCompletions(1, &completed_count);
+    ASSERT_TRUE(err.IsOk()) << "failed to process requests: " << err.Message();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(completed_count, 1u);
+  EXPECT_EQ(callback_count, 1u);
+  for (size_t i = 0; (i < 1000) && (callback_count < request_count); ++i) {
+    err = client_->Poll(10000 /* timeout_us */, &completed_count);
+    ASSERT_TRUE(err.IsOk()) << "failed to poll requests: " << err.Message();
+  }
+  EXPECT_EQ(callback_count, request_count);
+
+  // InferMulti() sends its requests one after another without being polled
+  std::vector<tc::InferResult*> results;
+  err = client_->InferMulti(
+      &results, {options},
+      std::vector<std::vector<tc::InferInput*>>(2, inputs));
+  EXPECT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  EXPECT_EQ(results.size(), 2u);
+  for (auto result : results) {
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+    delete result;
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, Cancel)
+{
+  // In polling mode the requests make no progress until the client is
+  // polled, so the request is always cancelled before it completes.
+  tc::HttpClientOptions client_options;
+  client_options.polling = true;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::vector<tc::Error> statuses;
+  auto callback = [&statuses](tc::InferResult* result) {
+    statuses.push_back(result->RequestStatus());
+    delete result;
+  };
+  tc::InferOptions options(model_name_);
+  std::shared_ptr<tc::CancelHandle> cancel_handle;
+  err = client_->AsyncInfer(&cancel_handle, callback, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  ASSERT_TRUE(cancel_handle != nullptr);
+  err = cancel_handle->Cancel();
+  EXPECT_TRUE(err.IsOk()) << "failed to cancel request: " << err.Message();
+  err = client_->ProcessCompletions(1);
+  ASSERT_TRUE(err.IsOk()) << "failed to process requests: " << err.Message();
+  ASSERT_EQ(statuses.size(), 1u);
+  EXPECT_EQ(statuses[0].Message(), "Cancelled");
+
+  // The request is reused for the next call, which is not affected by the
+  // cancellation of the previous call
+  err = client_->AsyncInfer(&cancel_handle, callback, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  err = cancel_handle->Cancel();
+  EXPECT_TRUE(err.IsOk()) << "failed to cancel request: " << err.Message();
+  std::shared_ptr<tc::CancelHandle> completed_handle;
+  err = client_->AsyncInfer(&completed_handle, callback, options, inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  for (size_t i = 0; (i < 1000) && (statuses.size() < 3); ++i) {
+    err = client_->Poll(10000 /* timeout_us */);
+    ASSERT_TRUE(err.IsOk()) << "failed to poll requests: " << err.Message();
+  }
+  ASSERT_EQ(statuses.size(), 3u);
+  EXPECT_EQ(statuses[1].Message(), "Cancelled");
+  EXPECT_TRUE(statuses[2].IsOk())
+      << "unexpected request failure: " << statuses[2].Message();
+
+  // Cancelling a completed request has no effect
+  err = completed_handle->Cancel();
+  EXPECT_TRUE(err.IsOk()) << "failed to cancel request: " << err.Message();
+
+  // Only the completed request is recorded
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, 1u);
+
+  // The handle may outlive the client
+  client_.reset();
+  err = completed_handle->Cancel();
+  EXPECT_TRUE(err.IsOk()) << "failed to cancel request: " << err.Message();
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(HTTPInferTest, Hedging)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+  std::unique_ptr<tc::InferenceServerHttpClient> other_client;
+  err = tc::InferenceServerHttpClient::Create(&other_client, "localhost:8000");
+  ASSERT_TRUE(err.IsOk()) << "failed to create HTTP client: " << err.Message();
+
+  std::unique_ptr<tc::HedgedInferClient<tc::InferenceServerHttpClient>>
+      hedged_client;
+  err = tc::HedgedInferClient<tc::InferenceServerHttpClient>::Create(
+      &hedged_client, {});
+  EXPECT_FALSE(err.IsOk()) << "expect Create() to fail without clients";
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::vector<tc::Error> statuses;
+  auto callback = [&mu, &cv, &statuses](tc::InferResult* result) {
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      statuses.push_back(result->RequestStatus());
+    }
+    cv.notify_one();
+    delete result;
+  };
+  tc::InferOptions options(model_name_);
+  const size_t request_count = 10;
+
+  // Without delay every request is hedged, and each callback is invoked
+  // once with the first result
+  tc::HedgingOptions hedging_options;
+  hedging_options.delay_us = 0;
+  err = tc::HedgedInferClient<tc::InferenceServerHttpClient>::Create(
+      &hedged_client, {client_.get(), other_client.get()}, hedging_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create hedged client: "
+                          << err.Message();
+  for (size_t i = 0; i < request_count; ++i) {
+    err = hedged_client->AsyncInfer(callback, options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(10), [&statuses] {
+      return statuses.size() == request_count;
+    }));
+    for (const auto& status : statuses) {
+      EXPECT_TRUE(status.IsOk())
+          << "unexpected request failure: " << status.Message();
+    }
+    statuses.clear();
+  }
+  tc::HedgingStat hedging_stat;
+  err = hedged_client->ClientHedgingStat(&hedging_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get hedging stat: " << err.Message();
+  EXPECT_EQ(hedging_stat.request_count, request_count);
+  EXPECT_EQ(hedging_stat.latency_histogram.Count(), request_count);
+  EXPECT_LE(hedging_stat.hedge_win_count, hedging_stat.hedged_request_count);
+
+  // The callback is invoked once the cancelled request is done with the
+  // inputs as well, so the inputs and their data can be released from the
+  // callback while every request is hedged.
+  for (size_t i = 0; i < request_count; ++i) {
+    std::vector<int32_t>* data = new std::vector<int32_t>(input_data_);
+    std::vector<tc::InferInput*>* request_inputs =
+        new std::vector<tc::InferInput*>();
+    for (const auto& name : {"INPUT0", "INPUT1"}) {
+      tc::InferInput* input;
+      err = tc::InferInput::Create(&input, name, shape_, dtype_);
+      ASSERT_TRUE(err.IsOk()) << "failed to create input: " << err.Message();
+      request_inputs->emplace_back(input);
+      err = input->AppendRaw(
+          reinterpret_cast<const uint8_t*>(data->data()),
+          data->size() * sizeof(int32_t));
+      ASSERT_TRUE(err.IsOk()) << "failed to set input: " << err.Message();
+    }
+    err = hedged_client->AsyncInfer(
+        [&callback, data, request_inputs](tc::InferResult* result) {
+          for (auto input : *request_inputs) {
+            delete input;
+          }
+          delete request_inputs;
+          delete data;
+          callback(result);
+        },
+        options, *request_inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(10), [&statuses] {
+      return statuses.size() == request_count;
+    }));
+    for (const auto& status : statuses) {
+      EXPECT_TRUE(status.IsOk())
+          << "unexpected request failure: " << status.Message();
+    }
+    statuses.clear();
+  }
+
+  // The requests complete before a long delay and are not hedged
+  hedging_options.delay_us = 10000000;
+  err = tc::HedgedInferClient<tc::InferenceServerHttpClient>::Create(
+      &hedged_client, {client_.get(), other_client.get()}, hedging_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create hedged client: "
+                          << err.Message();
+  for (size_t i = 0; i < request_count; ++i) {
+    err = hedged_client->AsyncInfer(callback, options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(5), [&statuses] {
+      return statuses.size() == request_count;
+    }));
+  }
+  err = hedged_client->ClientHedgingStat(&hedging_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get hedging stat: " << err.Message();
+  EXPECT_EQ(hedging_stat.request_count, request_count);
+  EXPECT_EQ(hedging_stat.hedged_request_count, 0u);
+  EXPECT_EQ(hedging_stat.hedge_win_count, 0u);
+
+  // Both requests of a hedged request would write into the buffer of an
+  // output, so such outputs are rejected and no request is sent
+  tc::InferRequestedOutput* output;
+  err = tc::InferRequestedOutput::Create(&output, "OUTPUT0");
+  ASSERT_TRUE(err.IsOk()) << "failed to create output: " << err.Message();
+  std::vector<int32_t> output_buffer(16);
+  err = output->SetBuffer(
+      reinterpret_cast<uint8_t*>(output_buffer.data()),
+      output_buffer.size() * sizeof(int32_t));
+  ASSERT_TRUE(err.IsOk()) << "failed to set output buffer: " << err.Message();
+  err = hedged_client->AsyncInfer(callback, options, inputs, {output});
+  EXPECT_FALSE(err.IsOk()) << "expect AsyncInfer() to fail with output buffer";
+  err = hedged_client->ClientHedgingStat(&hedging_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get hedging stat: " << err.Message();
+  EXPECT_EQ(hedging_stat.request_count, request_count);
+  delete output;
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+// A client completing its requests only when asked to, to control the
+// order in which the requests of a hedged request complete.
+class ManualCompletionClient {
+ public:
+  class ManualCancelHandle : public tc::CancelHandle {
+   public:
+    tc::Error Cancel() override
+    {
+      cancelled_ = true;
+      return tc::Error::Success;
+    }
+    std::atomic<bool> cancelled_{false};
+  };
+
+  tc::Error AsyncInfer(
+      std::shared_ptr<tc::CancelHandle>* cancel_handle,
+      tc::InferenceServerClient::OnCompleteFn callback,
+      const tc::InferOptions& options,
+      const std::vector<tc::InferInput*>& inputs,
+      const std::vector<const tc::InferRequestedOutput*>& outputs)
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    cancel_handles_.emplace_back(new ManualCancelHandle());
+    *cancel_handle = cancel_handles_.back();
+    callbacks_.emplace_back(callback);
+    return tc::Error::Success;
+  }
+
+  size_t RequestCount()
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return callbacks_.size();
+  }
+
+  std::mutex mutex_;
+  std::vector<tc::InferenceServerClient::OnCompleteFn> callbacks_;
+  std::vector<std::shared_ptr<ManualCancelHandle>> cancel_handles_;
+};
+
+TEST(HedgedInferClientTest, CallbackAfterCancelledRequest)
+{
+  ManualCompletionClient client;
+  ManualCompletionClient other_client;
+  tc::HedgingOptions hedging_options;
+  hedging_options.delay_us = 0;
+  std::unique_ptr<tc::HedgedInferClient<ManualCompletionClient>>
+      hedged_client;
+  tc::Error err = tc::HedgedInferClient<ManualCompletionClient>::Create(
+      &hedged_client, {&client, &other_client}, hedging_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create hedged client: "
+                          << err.Message();
+
+  std::atomic<size_t> callback_count(0);
+  err = hedged_client->AsyncInfer(
+      [&callback_count](tc::InferResult* result) { callback_count++; },
+      tc::InferOptions("model"), {});
+  ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  for (size_t i = 0; (i < 1000) && (other_client.RequestCount() == 0); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(client.RequestCount(), 1u);
+  ASSERT_EQ(other_client.RequestCount(), 1u);
+
+  // The hedged request wins and the original request is cancelled, the
+  // callback waits until the original request is completed since it may
+  // still be using the inputs
+  other_client.callbacks_[0](nullptr);
+  EXPECT_TRUE(client.cancel_handles_[0]->cancelled_);
+  EXPECT_EQ(callback_count, 0u);
+  client.callbacks_[0](nullptr);
+  EXPECT_EQ(callback_count, 1u);
+
+  tc::HedgingStat hedging_stat;
+  err = hedged_client->ClientHedgingStat(&hedging_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get hedging stat: " << err.Message();
+  EXPECT_EQ(hedging_stat.hedged_request_count, 1u);
+  EXPECT_EQ(hedging_stat.hedge_win_count, 1u);
+}
+
+TEST_F(GRPCInferTest, Polling)
+{
+  tc::Error err = CreateClient(tc::GrpcClientOptions());
+  ASSERT_TRUE(err.IsOk()) << "failed to create GRPC client: " << err.Message();
+  // The requests of a client with worker threads can't be polled
+  err = client_->Poll(0);
+  EXPECT_FALSE(err.IsOk()) << "expect Poll() to fail without completion queue";
+
+  grpc::CompletionQueue completion_queue;
+  tc::GrpcClientOptions client_options;
+  client_options.completion_queue = &completion_queue;
+  err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create GRPC client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  const size_t request_count = 3;
+  const std::thread::id polling_thread = std::this_thread::get_id();
+  size_t callback_count = 0;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    err = client_->AsyncInfer(
+        [&callback_count, polling_thread](tc::InferResult* result) {
+          EXPECT_TRUE(result->RequestStatus().IsOk())
+              << "unexpected request failure: "
+              << result->RequestStatus().Message();
+          EXPECT_EQ(std::this_thread::get_id(), polling_thread);
+          delete result;
+          callback_count++;
+        },
+        options, inputs);
+    EXPECT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+
+  for (size_t i = 0; (i < 1000) && (callback_count < request_count); ++i) {
+    err = client_->Poll(10000 /* timeout_us */);
+    EXPECT_TRUE(err.IsOk()) << "failed to poll requests: " << err.Message();
+  }
+  EXPECT_EQ(callback_count, request_count);
+
+  // InferMulti() sends its requests one after another without being polled
+  std::vector<tc::InferResult*> results;
+  err = client_->InferMulti(
+      &results, {options},
+      std::vector<std::vector<tc::InferInput*>>(2, inputs));
+  EXPECT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  EXPECT_EQ(results.size(), 2u);
+  for (auto result : results) {
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+    delete result;
+  }
+
+  // The client must be destroyed before its completion queue
+  client_.reset();
+  completion_queue.Shutdown();
+  void* tag;
+  bool ok;
+  while (completion_queue.Next(&tag, &ok)) {
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(GRPCInferTest, ChannelPool)
+{
+  tc::GrpcClientOptions client_options;
+  client_options.channel_count = 3;
+  client_options.channel_selection =
+      tc::GrpcClientOptions::ChannelSelection::LEAST_OUTSTANDING;
+  tc::Error err = CreateClient(client_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create GRPC client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  // Submit more requests than channels so that every channel sends several
+  // requests, then use the channels for synchronous requests as well.
+  const size_t request_count = 10;
+  std::condition_variable cv;
+  std::mutex mu;
+  std::vector<tc::InferResult*> results;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    err = client_->AsyncInfer(
+        [&results, &cv, &mu](tc::InferResult* res) {
+          {
+            std::lock_guard<std::mutex> lk(mu);
+            results.emplace_back(res);
+          }
+          cv.notify_one();
+        },
+        options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    tc::InferResult* result;
+    err = client_->Infer(&result, options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to run inference: " << err.Message();
+    std::unique_ptr<tc::InferResult> result_ptr(result);
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+  }
+
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&] { return results.size() == request_count; });
+  for (auto result : results) {
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+    delete result;
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(GRPCInferTest, CreatedStreams)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create GRPC client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::mutex mu;
+  std::vector<tc::InferResult*> results;
+  auto callback = [&results, &mu](tc::InferResult* res) {
+    std::lock_guard<std::mutex> lk(mu);
+    results.emplace_back(res);
+  };
+
+  // Queue the requests on independent streams, stopping a stream waits for
+  // the responses of its requests.
+  const size_t stream_count = 2;
+  const size_t request_count = 5;
+  std::vector<std::unique_ptr<tc::GrpcInferStream>> streams(stream_count);
+  for (auto& stream : streams) {
+    err = client_->CreateStream(&stream, callback);
+    ASSERT_TRUE(err.IsOk()) << "failed to create stream: " << err.Message();
+  }
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    for (auto& stream : streams) {
+      err = stream->AsyncStreamInfer(options, inputs);
+      ASSERT_TRUE(err.IsOk()) << "failed to queue request: " << err.Message();
+    }
+  }
+  for (auto& stream : streams) {
+    err = stream->Stop();
+    EXPECT_TRUE(err.IsOk()) << "failed to stop stream: " << err.Message();
+    EXPECT_EQ(stream->PendingWriteCount(), 0u);
+    err = stream->AsyncStreamInfer(options, inputs);
+    EXPECT_FALSE(err.IsOk()) << "expect error on a stopped stream";
+  }
+
+  EXPECT_EQ(results.size(), stream_count * request_count);
+  for (auto result : results) {
+    EXPECT_TRUE(result->RequestStatus().IsOk())
+        << "unexpected request failure: " << result->RequestStatus().Message();
+    delete result;
+  }
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
+TEST_F(GRPCInferTest, StreamResponseTimeline)
+{
+  tc::Error err = CreateClient();
+  ASSERT_TRUE(err.IsOk()) << "failed to create GRPC client: " << err.Message();
+
+  std::vector<tc::InferInput*> inputs;
+  err = PrepareInputs(&inputs);
+  ASSERT_TRUE(err.IsOk()) << "failed to prepare inputs: " << err.Message();
+
+  std::mutex mu;
+  std::vector<tc::ResponseTimeline> timelines;
+  tc::GrpcStreamOptions stream_options;
+  stream_options.timeline_callback =
+      [&timelines, &mu](const tc::ResponseTimeline& timeline) {
+        std::lock_guard<std::mutex> lk(mu);
+        timelines.emplace_back(timeline);
+      };
+  std::unique_ptr<tc::GrpcInferStream> stream;
+  err = client_->CreateStream(
+      &stream, [](tc::InferResult* res) { delete res; }, stream_options);
+  ASSERT_TRUE(err.IsOk()) << "failed to create stream: " << err.Message();
+
+  const size_t request_count = 3;
+  tc::InferOptions options(model_name_);
+  for (size_t i = 0; i < request_count; ++i) {
+    options.request_id_ = std::to_string(i);
+    err = stream->AsyncStreamInfer(options, inputs);
+    ASSERT_TRUE(err.IsOk()) << "failed to queue request: " << err.Message();
+  }
+  err = stream->Stop();
+  ASSERT_TRUE(err.IsOk()) << "failed to stop stream: " << err.Message();
+
+  // The model is not decoupled, each request completes with its only
+  // response.
+  ASSERT_EQ(timelines.size(), request_count);
+  for (size_t i = 0; i < request_count; ++i) {
+    EXPECT_EQ(timelines[i].request_id, std::to_string(i));
+    EXPECT_TRUE(timelines[i].complete);
+    EXPECT_EQ(timelines[i].ResponseCount(), 1u);
+    EXPECT_GT(timelines[i].TimeToFirstResponseNs(), 0u);
+    EXPECT_EQ(
+        timelines[i].TimeToFirstResponseNs(),
+        timelines[i].TimeToFinalResponseNs());
+  }
+
+  tc::InferStat infer_stat;
+  err = client_->ClientInferStat(&infer_stat);
+  ASSERT_TRUE(err.IsOk()) << "failed to get client stat: " << err.Message();
+  EXPECT_EQ(infer_stat.completed_request_count, request_count);
+
+  for (auto input : inputs) {
+    delete input;
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     ClientTest, InferMulti, InferMultiDifferentOutputs,
     InferMultiDifferentOptions, InferMultiOneOption, InferMultiOneOutput,
     InferMultiNoOutput, InferMultiMismatchOptions, InferMultiMismatchOutputs,
-    AsyncInferMulti, AsyncInferMultiDifferentOutputs,
+    InferMultiPartialFailure, AsyncInferMulti, AsyncInferMultiDifferentOutputs,
     AsyncInferMultiDifferentOptions, AsyncInferMultiOneOption,
     AsyncInferMultiOneOutput, AsyncInferMultiNoOutput,
     AsyncInferMultiMismatchOptions, AsyncInferMultiMismatchOutputs,
+    InferInputChunks, InferOutputBuffers, ConcurrentInfer, PreparedInfer,
     LoadWithFileOverride, LoadWithConfigOverride);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GRPC, ClientTest, tc::InferenceServerGrpcClient);